@@ -0,0 +1,161 @@
+// Drawing commands of the host stand-in for the AltSerialGraphicLCD library (see AltSerialGraphicLCD.h).
+
+#include <AltSerialGraphicLCD.h>
+
+// Size of the glyphs of the font faces of the display: {width, height}
+static const uint8_t fontFaces[2][2] = {{6, 8}, {4, 6}};
+
+uint8_t GLCD::colorOf(uint8_t mode) {
+  switch (mode) {
+    case GLCD_MODE_REVERSE:
+      return HOST_COLOR_CLEAR;
+    case GLCD_MODE_XOR:
+      return HOST_COLOR_XOR;
+    default:
+      return HOST_COLOR_SET;
+  }
+}
+
+void GLCD::set(uint8_t id, uint8_t value) {
+  record("set", id, value);
+}
+
+void GLCD::clearScreen() {
+  record("clearScreen");
+  clearFramebuffer();
+}
+
+void GLCD::drawMode(uint8_t mode) {
+  record("drawMode", mode);
+  _drawMode = mode;
+}
+
+void GLCD::fontMode(uint8_t mode) {
+  record("fontMode", mode);
+  _fontMode = mode;
+}
+
+void GLCD::fontFace(uint8_t face) {
+  record("fontFace", face);
+  _fontFace = face < 2 ? face : 0;
+}
+
+void GLCD::setX(uint8_t x) {
+  record("setX", x);
+  _x = x;
+}
+
+void GLCD::setY(uint8_t y) {
+  record("setY", y);
+  _y = y;
+}
+
+void GLCD::setXY(uint8_t x, uint8_t y) {
+  record("setXY", x, y);
+  _x = x;
+  _y = y;
+}
+
+void GLCD::put(char c) {
+  record("put", _x, _y, (uint8_t)c);
+  const uint8_t* size = fontFaces[_fontFace];
+  // Background of the glyph is cleared (unless font is drawn in XOR mode), the same way display draws text
+  if (_fontMode != GLCD_MODE_XOR) {
+    fillRect(_x, _y, size[0], size[1], _fontMode == GLCD_MODE_REVERSE ? HOST_COLOR_SET : HOST_COLOR_CLEAR);
+  }
+  fillGlyph(_x, _y, size[0], size[1], c, colorOf(_fontMode));
+  _x += size[0];
+}
+
+void GLCD::putstr(const char* str) {
+  while (*str != '\0') {
+    put(*str++);
+  }
+}
+
+void GLCD::drawPixel(uint8_t x, uint8_t y, uint8_t mode) {
+  record("drawPixel", x, y, mode);
+  putPixel(x, y, colorOf(mode));
+}
+
+void GLCD::drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode) {
+  record("drawLine", x1, y1, x2, y2);
+  strokeLine(x1, y1, x2, y2, colorOf(mode));
+}
+
+void GLCD::drawBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode) {
+  record("drawBox", x1, y1, x2, y2);
+  uint8_t color = colorOf(mode);
+  strokeLine(x1, y1, x2, y1, color);
+  strokeLine(x1, y2, x2, y2, color);
+  if (y2 - y1 > 1) {
+    strokeLine(x1, y1 + 1, x1, y2 - 1, color);
+    strokeLine(x2, y1 + 1, x2, y2 - 1, color);
+  }
+}
+
+void GLCD::fillBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t pattern) {
+  record("fillBox", x1, y1, x2, y2);
+  // Pattern is applied to each column of the box: bit n is used for rows with y % 8 == n
+  for (int y = y1; y <= y2; y++) {
+    bool bit = (pattern >> (y % 8)) & 1;
+    for (int x = x1; x <= x2; x++) {
+      switch (_drawMode) {
+        case GLCD_MODE_XOR:
+          if (bit) {
+            putPixel(x, y, HOST_COLOR_XOR);
+          }
+          break;
+        case GLCD_MODE_REVERSE:
+          putPixel(x, y, bit ? HOST_COLOR_CLEAR : HOST_COLOR_SET);
+          break;
+        default:
+          putPixel(x, y, bit ? HOST_COLOR_SET : HOST_COLOR_CLEAR);
+          break;
+      }
+    }
+  }
+}
+
+void GLCD::eraseBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+  record("eraseBox", x1, y1, x2, y2);
+  fillRect(x1, y1, x2 - x1 + 1, y2 - y1 + 1, HOST_COLOR_CLEAR);
+}
+
+void GLCD::loadSprite_P(uint8_t id, const uint8_t* sprite) {
+  record("loadSprite", id);
+  if (id < GLCD_SPRITES) {
+    _sprites[id] = sprite;
+  }
+}
+
+void GLCD::drawSprite(uint8_t x, uint8_t y, uint8_t id, uint8_t mode) {
+  record("drawSprite", x, y, id, mode);
+  if (id < GLCD_SPRITES && _sprites[id] != nullptr) {
+    drawBitmap(x, y, mode, _sprites[id]);
+  }
+}
+
+void GLCD::bitblt_P(uint8_t x, uint8_t y, uint8_t mode, const uint8_t* bitmap) {
+  record("bitblt", x, y, mode);
+  drawBitmap(x, y, mode, bitmap);
+}
+
+void GLCD::drawBitmap(uint8_t x, uint8_t y, uint8_t mode, const uint8_t* bitmap) {
+  // Bitmap starts with its width and height, followed by columns of each band of 8 rows (the topmost pixel in the least significant bit)
+  uint8_t w = pgm_read_byte(bitmap);
+  uint8_t h = pgm_read_byte(bitmap + 1);
+  const uint8_t* data = bitmap + 2;
+  for (int j = 0; j < h; j++) {
+    for (int i = 0; i < w; i++) {
+      bool bit = (pgm_read_byte(data + (j / 8) * w + i) >> (j % 8)) & 1;
+      if (mode == GLCD_MODE_XOR) {
+        if (bit) {
+          putPixel(x + i, y + j, HOST_COLOR_XOR);
+        }
+      } else {
+        putPixel(x + i, y + j, (bit == (mode != GLCD_MODE_REVERSE)) ? HOST_COLOR_SET : HOST_COLOR_CLEAR);
+      }
+    }
+  }
+}
@@ -0,0 +1,54 @@
+// Minimal stand-in for the AltSerialGraphicLCD library, sufficient to build GEM (GLCD version) on the host (desktop) machine.
+// Commands that would be sent to the display over serial link are recorded and drawn into 1-bpp framebuffer
+// (see HostDisplay.h). Not used when building sketches with Arduino IDE.
+
+#ifndef HOST_ALTSERIALGRAPHICLCD_H
+#define HOST_ALTSERIALGRAPHICLCD_H
+
+#include <Arduino.h>
+#include "HostDisplay.h"
+
+#define GLCD_MODE_NORMAL 0
+#define GLCD_MODE_REVERSE 1
+#define GLCD_MODE_XOR 2
+
+#define GLCD_ID_CRLF 0
+#define GLCD_ID_SCROLL 1
+
+#define GLCD_SPRITES 8
+
+class GLCD : public HostDisplay {
+  public:
+    GLCD(uint8_t width = 128, uint8_t height = 64) : HostDisplay(width, height), xdim(width), ydim(height) { }
+    const uint8_t xdim;
+    const uint8_t ydim;
+    void set(uint8_t id, uint8_t value);
+    void clearScreen();
+    void drawMode(uint8_t mode);
+    void fontMode(uint8_t mode);
+    void fontFace(uint8_t face);
+    void setX(uint8_t x);
+    void setY(uint8_t y);
+    void setXY(uint8_t x, uint8_t y);
+    void put(char c);
+    void putstr(const char* str);
+    void drawPixel(uint8_t x, uint8_t y, uint8_t mode);
+    void drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode);
+    void drawBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode);
+    void fillBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t pattern = 0xFF);
+    void eraseBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
+    void loadSprite_P(uint8_t id, const uint8_t* sprite);
+    void drawSprite(uint8_t x, uint8_t y, uint8_t id, uint8_t mode);
+    void bitblt_P(uint8_t x, uint8_t y, uint8_t mode, const uint8_t* bitmap);
+  private:
+    uint8_t _drawMode = GLCD_MODE_NORMAL;
+    uint8_t _fontMode = GLCD_MODE_NORMAL;
+    uint8_t _fontFace = 0;
+    uint8_t _x = 0;
+    uint8_t _y = 0;
+    const uint8_t* _sprites[GLCD_SPRITES] = {};
+    uint8_t colorOf(uint8_t mode);
+    void drawBitmap(uint8_t x, uint8_t y, uint8_t mode, const uint8_t* bitmap);
+};
+
+#endif
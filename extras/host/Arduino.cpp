@@ -0,0 +1,80 @@
+// Implementation of the host stand-in for the Arduino core (see Arduino.h).
+
+#include <Arduino.h>
+#include <chrono>
+
+static unsigned long long delayedMicros = 0;  // Time skipped by delay() calls
+
+static unsigned long long hostMicros() {
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long millis() {
+  return (unsigned long)((hostMicros() + delayedMicros) / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)(hostMicros() + delayedMicros);
+}
+
+void delay(unsigned long ms) {
+  delayedMicros += (unsigned long long)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+  delayedMicros += us;
+}
+
+char* ultoa(unsigned long value, char* str, int base) {
+  char digits[sizeof(unsigned long) * 8];
+  byte count = 0;
+  do {
+    byte digit = value % base;
+    digits[count++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while (value > 0);
+  char* p = str;
+  while (count > 0) {
+    *p++ = digits[--count];
+  }
+  *p = '\0';
+  return str;
+}
+
+char* ltoa(long value, char* str, int base) {
+  // As in avr-libc, only decimal values are printed with the minus sign
+  if (value < 0 && base == 10) {
+    str[0] = '-';
+    ultoa(0UL - (unsigned long)value, str + 1, base);
+    return str;
+  }
+  return ultoa((unsigned long)value, str, base);
+}
+
+char* utoa(unsigned int value, char* str, int base) {
+  return ultoa(value, str, base);
+}
+
+char* itoa(int value, char* str, int base) {
+  return (value < 0 && base == 10) ? ltoa(value, str, base) : ultoa((unsigned int)value, str, base);
+}
+
+char* dtostrf(double value, signed char width, unsigned char precision, char* str) {
+  sprintf(str, "%*.*f", width, precision, value);
+  return str;
+}
+
+static uint8_t pinLevels[256];  // Levels inverted, so that pins read HIGH until set otherwise
+
+int digitalRead(uint8_t pin) {
+  return pinLevels[pin] ? LOW : HIGH;
+}
+
+void setPinLevel(uint8_t pin, int level) {
+  pinLevels[pin] = (level == LOW);
+}
+
+void digitalWrite(uint8_t /* pin */, uint8_t /* value */) { }
+
+void pinMode(uint8_t /* pin */, uint8_t /* mode */) { }
@@ -0,0 +1,103 @@
+// Minimal stand-in for the Arduino core, sufficient to build GEM sources on the host (desktop) machine
+// for benchmarking and checking purposes. Not used when building sketches with Arduino IDE.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <math.h>
+#include "WString.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_ptr(p) (*(void* const*)(p))
+#define strncpy_P strncpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+// Time runs along with the host clock, delay() advances it without sleeping (see Arduino.cpp)
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Conversions of avr-libc (stdlib.h), also shipped with non-AVR cores
+char* itoa(int value, char* str, int base);
+char* ltoa(long value, char* str, int base);
+char* utoa(unsigned int value, char* str, int base);
+char* ultoa(unsigned long value, char* str, int base);
+char* dtostrf(double value, signed char width, unsigned char precision, char* str);
+
+// Pins read HIGH (i.e. released buttons with pull-up resistors), unless level is set otherwise by setPinLevel() (host only, for checks)
+int digitalRead(uint8_t pin);
+void setPinLevel(uint8_t pin, int level);
+void digitalWrite(uint8_t pin, uint8_t value);
+void pinMode(uint8_t pin, uint8_t mode);
+inline void noInterrupts() { }
+inline void interrupts() { }
+
+class Print {
+  public:
+    virtual ~Print() { }
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+      size_t n = 0;
+      while (size--) {
+        n += write(*buffer++);
+      }
+      return n;
+    }
+    size_t print(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+    size_t print(const __FlashStringHelper* str) { return print(reinterpret_cast<const char*>(str)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(long value) { char buffer[24]; snprintf(buffer, sizeof(buffer), "%ld", value); return print(buffer); }
+    size_t print(int value) { return print((long)value); }
+    size_t print(unsigned long value) { char buffer[24]; snprintf(buffer, sizeof(buffer), "%lu", value); return print(buffer); }
+    size_t print(unsigned int value) { return print((unsigned long)value); }
+    size_t print(double value, int digits = 2) { char buffer[32]; snprintf(buffer, sizeof(buffer), "%.*f", digits, value); return print(buffer); }
+    size_t println() { return write('\n'); }
+    template <typename T>
+    size_t println(T value) { size_t n = print(value); return n + println(); }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    size_t readBytes(uint8_t* buffer, size_t length) {
+      size_t i = 0;
+      while (i < length) {
+        int c = read();
+        if (c < 0) {
+          break;
+        }
+        buffer[i++] = c;
+      }
+      return i;
+    }
+    size_t readBytes(char* buffer, size_t length) { return readBytes((uint8_t*)buffer, length); }
+  protected:
+    unsigned long _timeout = 1000;
+};
+
+#endif
@@ -0,0 +1,149 @@
+// Framebuffer and log of drawing calls of the host stand-ins for the graphics libraries (see HostDisplay.h).
+
+#include "HostDisplay.h"
+#include <algorithm>
+
+HostDisplay::HostDisplay(uint8_t width, uint8_t height)
+  : _width(width)
+  , _height(height)
+  , _framebuffer((width + 7) / 8 * height, 0)
+{
+  resetClip();
+  setPage(0, height);
+}
+
+uint8_t HostDisplay::getPixel(int x, int y) const {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) {
+    return 0;
+  }
+  return (_framebuffer[y * ((_width + 7) / 8) + x / 8] >> (x % 8)) & 1;
+}
+
+unsigned int HostDisplay::countPixels(int x, int y, int w, int h) const {
+  unsigned int count = 0;
+  for (int j = y; j < y + h; j++) {
+    for (int i = x; i < x + w; i++) {
+      count += getPixel(i, j);
+    }
+  }
+  return count;
+}
+
+void HostDisplay::dump(FILE* stream) const {
+  for (int y = 0; y < _height; y++) {
+    for (int x = 0; x < _width; x++) {
+      fputc(getPixel(x, y) ? '#' : '.', stream);
+    }
+    fputc('\n', stream);
+  }
+}
+
+const std::vector<uint8_t>& HostDisplay::getFramebuffer() const {
+  return _framebuffer;
+}
+
+const std::vector<uint8_t>& HostDisplay::getScreen() const {
+  return _framebuffer;
+}
+
+const std::vector<HostDrawCall>& HostDisplay::getCalls() const {
+  return _calls;
+}
+
+size_t HostDisplay::countCalls(const char* name) const {
+  if (name == nullptr) {
+    return _calls.size();
+  }
+  size_t count = 0;
+  for (const HostDrawCall& call : _calls) {
+    count += (strcmp(call.name, name) == 0);
+  }
+  return count;
+}
+
+void HostDisplay::clearCalls() {
+  _calls.clear();
+}
+
+void HostDisplay::record(const char* name, int arg0, int arg1, int arg2, int arg3) {
+  _calls.push_back({name, {arg0, arg1, arg2, arg3}});
+}
+
+void HostDisplay::setClip(int x0, int y0, int x1, int y1) {
+  _clipX0 = x0;
+  _clipY0 = y0;
+  _clipX1 = x1;
+  _clipY1 = y1;
+}
+
+void HostDisplay::resetClip() {
+  setClip(0, 0, _width - 1, _height - 1);
+}
+
+void HostDisplay::setPage(int y0, int y1) {
+  _pageY0 = y0 < 0 ? 0 : y0;
+  _pageY1 = y1 > _height ? _height : y1;
+}
+
+void HostDisplay::putPixel(int x, int y, uint8_t color) {
+  if (x < _clipX0 || y < _clipY0 || x > _clipX1 || y > _clipY1 || y < _pageY0 || y >= _pageY1 || x < 0 || x >= _width) {
+    return;
+  }
+  uint8_t& byte = _framebuffer[y * ((_width + 7) / 8) + x / 8];
+  uint8_t mask = 1 << (x % 8);
+  switch (color) {
+    case HOST_COLOR_CLEAR:
+      byte &= ~mask;
+      break;
+    case HOST_COLOR_SET:
+      byte |= mask;
+      break;
+    default:
+      byte ^= mask;
+      break;
+  }
+}
+
+void HostDisplay::fillRect(int x, int y, int w, int h, uint8_t color) {
+  for (int j = y; j < y + h; j++) {
+    for (int i = x; i < x + w; i++) {
+      putPixel(i, j, color);
+    }
+  }
+}
+
+void HostDisplay::strokeLine(int x0, int y0, int x1, int y1, uint8_t color) {
+  // Bresenham's line algorithm
+  int dx = abs(x1 - x0);
+  int dy = -abs(y1 - y0);
+  int sx = x0 < x1 ? 1 : -1;
+  int sy = y0 < y1 ? 1 : -1;
+  int error = dx + dy;
+  while (true) {
+    putPixel(x0, y0, color);
+    if (x0 == x1 && y0 == y1) {
+      break;
+    }
+    int error2 = 2 * error;
+    if (error2 >= dy) {
+      error += dy;
+      x0 += sx;
+    }
+    if (error2 <= dx) {
+      error += dx;
+      y0 += sy;
+    }
+  }
+}
+
+void HostDisplay::fillGlyph(int x, int y, uint8_t w, uint8_t h, char c, uint8_t color) {
+  // Block leaves one pixel of spacing to the right and at the bottom, space is left blank
+  if (c != ' ') {
+    fillRect(x, y, w - 1, h - 1, color);
+  }
+}
+
+void HostDisplay::clearFramebuffer() {
+  int rowBytes = (_width + 7) / 8;
+  std::fill(_framebuffer.begin() + _pageY0 * rowBytes, _framebuffer.begin() + _pageY1 * rowBytes, 0);
+}
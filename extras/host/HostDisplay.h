@@ -0,0 +1,51 @@
+// Common part of the host stand-ins for the graphics libraries (see U8g2lib.h and AltSerialGraphicLCD.h): 1-bpp framebuffer
+// and log of the drawing calls made by GEM. Characters are drawn as solid blocks of the size of the glyph, so that
+// framebuffer shows where text is printed without the need for actual fonts.
+
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Colors (modes) of the drawn pixels
+#define HOST_COLOR_CLEAR 0
+#define HOST_COLOR_SET 1
+#define HOST_COLOR_XOR 2
+
+// Recorded drawing call, e.g. {"drawBox", {0, 10, 126, 11}}; for printed characters the last argument is the character code
+struct HostDrawCall {
+  const char* name;
+  int args[4];
+};
+
+class HostDisplay {
+  public:
+    HostDisplay(uint8_t width, uint8_t height);
+    uint8_t getPixel(int x, int y) const;                   // Get state (0 or 1) of the pixel of the framebuffer, 0 if out of the screen
+    unsigned int countPixels(int x, int y, int w, int h) const; // Get the number of pixels set within the area
+    void dump(FILE* stream = stdout) const;                 // Print framebuffer as ASCII art ('#' for pixel that is set)
+    const std::vector<uint8_t>& getFramebuffer() const;     // Get framebuffer, e.g. to compare it with the one drawn later
+    virtual const std::vector<uint8_t>& getScreen() const;  // Get what display shows (the framebuffer itself, unless buffer is sent to display separately)
+    const std::vector<HostDrawCall>& getCalls() const;      // Get drawing calls recorded since the last clearCalls()
+    size_t countCalls(const char* name = nullptr) const;    // Get the number of recorded drawing calls (with supplied name, if specified)
+    void clearCalls();                                      // Forget recorded drawing calls
+  protected:
+    uint8_t _width;
+    uint8_t _height;
+    std::vector<uint8_t> _framebuffer;  // Pixels row by row, 8 pixels per byte (the leftmost pixel in the least significant bit)
+    std::vector<HostDrawCall> _calls;
+    int _clipX0, _clipY0, _clipX1, _clipY1;  // Pixels outside of the clip window (inclusive) are not drawn
+    int _pageY0, _pageY1;                    // Rows of the framebuffer held by page buffer (from _pageY0 up to, not including, _pageY1)
+    void record(const char* name, int arg0 = 0, int arg1 = 0, int arg2 = 0, int arg3 = 0);
+    void setClip(int x0, int y0, int x1, int y1);
+    void resetClip();
+    void setPage(int y0, int y1);
+    void putPixel(int x, int y, uint8_t color);
+    void fillRect(int x, int y, int w, int h, uint8_t color);
+    void strokeLine(int x0, int y0, int x1, int y1, uint8_t color);
+    void fillGlyph(int x, int y, uint8_t w, uint8_t h, char c, uint8_t color);
+    void clearFramebuffer();  // Clear rows of the current page
+};
+
+#endif
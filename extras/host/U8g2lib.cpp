@@ -0,0 +1,178 @@
+// Fonts and drawing calls of the host stand-in for the U8g2 library (see U8g2lib.h).
+
+#include <U8g2lib.h>
+#include <algorithm>
+
+const uint8_t u8g2_font_6x12_tf[3] = {6, 8, 4};
+const uint8_t u8g2_font_tom_thumb_4x6_tf[3] = {4, 6, 4};
+const uint8_t u8g2_font_6x12_t_cyrillic[3] = {6, 8, 4};
+const uint8_t u8g2_font_4x6_t_cyrillic[3] = {4, 6, 4};
+
+uint8_t U8G2::hostByteCallback(u8x8_t* /* u8x8 */, uint8_t /* msg */, uint8_t /* arg_int */, void* /* arg_ptr */) {
+  return 1;  // Bytes go nowhere
+}
+
+void U8G2::transfer(uint8_t commands, uint8_t data) {
+  static uint8_t bytes[255] = {};
+  _u8x8.byte_cb(&_u8x8, U8X8_MSG_BYTE_START_TRANSFER, 0, nullptr);
+  _u8x8.byte_cb(&_u8x8, U8X8_MSG_BYTE_SEND, commands, bytes);
+  if (data > 0) {
+    _u8x8.byte_cb(&_u8x8, U8X8_MSG_BYTE_SEND, data, bytes);
+  }
+  _u8x8.byte_cb(&_u8x8, U8X8_MSG_BYTE_END_TRANSFER, 0, nullptr);
+}
+
+void U8G2::transferTiles(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  // As with SSD1306-like controllers: column and page address are set, followed by 8 bytes per tile of the row
+  int rowBytes = (_width + 7) / 8;
+  for (uint8_t row = ty; row < ty + th; row++) {
+    transfer(3, tw * 8);
+    for (int y = row * 8; y < row * 8 + 8 && y < _height; y++) {
+      for (uint8_t col = tx; col < tx + tw && col < rowBytes; col++) {
+        _screen[y * rowBytes + col] = _framebuffer[y * rowBytes + col];
+      }
+    }
+  }
+}
+
+void U8G2::setCurrTileRow(uint8_t row) {
+  _currTileRow = row;
+  setPage(row * 8, (row + _bufferTileHeight) * 8);
+}
+
+void U8G2::initDisplay() {
+  record("initDisplay");
+  transfer(25, 0);  // Typical length of the init sequence
+}
+
+void U8G2::setPowerSave(uint8_t is_enable) {
+  record("setPowerSave", is_enable);
+  transfer(1, 0);
+}
+
+void U8G2::clear() {
+  record("clear");
+  setCurrTileRow(0);
+  clearFramebuffer();
+  std::fill(_screen.begin(), _screen.end(), 0);
+  transferTiles(0, 0, _width / 8, _height / 8);
+}
+
+void U8G2::clearBuffer() {
+  record("clearBuffer");
+  clearFramebuffer();
+}
+
+void U8G2::sendBuffer() {
+  record("sendBuffer");
+  transferTiles(0, _currTileRow, _width / 8, _bufferTileHeight);
+}
+
+void U8G2::firstPage() {
+  record("firstPage");
+  setCurrTileRow(0);
+  clearFramebuffer();
+}
+
+uint8_t U8G2::nextPage() {
+  record("nextPage");
+  transferTiles(0, _currTileRow, _width / 8, _bufferTileHeight);
+  if (_currTileRow + _bufferTileHeight >= _height / 8) {
+    setCurrTileRow(0);
+    return 0;  // The last page is sent
+  }
+  setCurrTileRow(_currTileRow + _bufferTileHeight);
+  clearFramebuffer();
+  return 1;
+}
+
+uint8_t U8G2::getMenuEvent() {
+  return 0;
+}
+
+void U8G2::setBufferCurrTileRow(uint8_t row) {
+  record("setBufferCurrTileRow", row);
+  setCurrTileRow(row);
+}
+
+void U8G2::updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  record("updateDisplayArea", tx, ty, tw, th);
+  transferTiles(tx, ty, tw, th);
+}
+
+void U8G2::setClipWindow(int x0, int y0, int x1, int y1) {
+  record("setClipWindow", x0, y0, x1, y1);
+  setClip(x0, y0, x1 - 1, y1 - 1);  // Right and bottom edges of U8g2 clip window are exclusive
+}
+
+void U8G2::setMaxClipWindow() {
+  record("setMaxClipWindow");
+  resetClip();
+}
+
+void U8G2::setDrawColor(uint8_t color) {
+  record("setDrawColor", color);
+  _color = color;
+}
+
+void U8G2::setFont(const uint8_t* font) {
+  record("setFont", font[0], font[1]);
+  _font = font;
+}
+
+void U8G2::setFontPosTop() {
+  record("setFontPosTop");
+}
+
+void U8G2::enableUTF8Print() {
+  record("enableUTF8Print");
+  _utf8 = true;
+}
+
+void U8G2::disableUTF8Print() {
+  record("disableUTF8Print");
+  _utf8 = false;
+}
+
+void U8G2::setCursor(int x, int y) {
+  record("setCursor", x, y);
+  _cursorX = x;
+  _cursorY = y;
+}
+
+void U8G2::drawPixel(int x, int y) {
+  record("drawPixel", x, y);
+  putPixel(x, y, _color);
+}
+
+void U8G2::drawLine(int x0, int y0, int x1, int y1) {
+  record("drawLine", x0, y0, x1, y1);
+  strokeLine(x0, y0, x1, y1, _color);
+}
+
+void U8G2::drawBox(int x, int y, int w, int h) {
+  record("drawBox", x, y, w, h);
+  fillRect(x, y, w, h, _color);
+}
+
+void U8G2::drawXBMP(int x, int y, int w, int h, const uint8_t* bitmap) {
+  record("drawXBMP", x, y, w, h);
+  int rowBytes = (w + 7) / 8;
+  for (int j = 0; j < h; j++) {
+    for (int i = 0; i < w; i++) {
+      if ((bitmap[j * rowBytes + i / 8] >> (i % 8)) & 1) {
+        putPixel(x + i, y + j, _color);
+      }
+    }
+  }
+}
+
+size_t U8G2::write(uint8_t c) {
+  if (_utf8 && (c & 0xC0) == 0xC0) {
+    return 1;  // Leading byte of multi-byte UTF-8 character, glyph is drawn for the byte that follows
+  }
+  record("print", _cursorX, _cursorY, c);
+  fillGlyph(_cursorX, _cursorY + _font[2], _font[0], _font[1], c, _color);
+  _cursorX += _font[0];
+  return 1;
+}
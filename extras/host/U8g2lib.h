@@ -0,0 +1,94 @@
+// Minimal stand-in for the U8g2 library, sufficient to build GEM_u8g2 on the host (desktop) machine.
+// Drawing calls are recorded and drawn into 1-bpp framebuffer (see HostDisplay.h). They are not inlined
+// (as with the actual library), so that code of GEM_u8g2 is compiled the same way as for the target.
+// Buffer is full frame by default; with bufferTileHeight supplied, only that many tile rows (page) can be drawn
+// at a time (as with _1 and _2 constructors of the actual library). What display shows is kept apart from
+// the buffer and is updated only by the tiles sent to display.
+// Not used when building sketches with Arduino IDE.
+
+#ifndef HOST_U8G2LIB_H
+#define HOST_U8G2LIB_H
+
+#include <Arduino.h>
+#include "HostDisplay.h"
+
+#define U8X8_PROGMEM
+#define U8X8_PIN_NONE 255
+#define U8X8_MSG_GPIO_MENU_SELECT 80
+#define U8X8_MSG_GPIO_MENU_NEXT 81
+#define U8X8_MSG_GPIO_MENU_PREV 82
+#define U8X8_MSG_GPIO_MENU_HOME 83
+#define U8X8_MSG_GPIO_MENU_UP 84
+#define U8X8_MSG_GPIO_MENU_DOWN 85
+#define U8X8_MSG_BYTE_INIT 20
+#define U8X8_MSG_BYTE_SEND 23
+#define U8X8_MSG_BYTE_START_TRANSFER 24
+#define U8X8_MSG_BYTE_END_TRANSFER 25
+
+// Byte level of the display interface: as with the actual library, bytes sent to display pass through byte_cb
+// (in chunks, between U8X8_MSG_BYTE_START_TRANSFER and U8X8_MSG_BYTE_END_TRANSFER), so that they can be counted by wrapping the callback
+typedef struct u8x8_struct u8x8_t;
+typedef uint8_t (*u8x8_msg_cb)(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+struct u8x8_struct {
+  u8x8_msg_cb byte_cb;
+};
+
+// Fonts hold only the size of the glyph and the blank rows above it (GEM offsets text by them in setFontPosTop() mode): {width, height, top}
+extern const uint8_t u8g2_font_6x12_tf[];
+extern const uint8_t u8g2_font_tom_thumb_4x6_tf[];
+extern const uint8_t u8g2_font_6x12_t_cyrillic[];
+extern const uint8_t u8g2_font_4x6_t_cyrillic[];
+
+class U8G2 : public Print, public HostDisplay {
+  public:
+    U8G2(uint8_t width = 128, uint8_t height = 64, uint8_t bufferTileHeight = 0)
+      : HostDisplay(width, height)
+      , _bufferTileHeight(bufferTileHeight > 0 ? bufferTileHeight : height / 8)
+      , _screen(_framebuffer.size(), 0)
+    { }
+    void initDisplay();
+    void setPowerSave(uint8_t is_enable);
+    void clear();
+    void clearBuffer();
+    void sendBuffer();
+    void firstPage();
+    uint8_t nextPage();
+    uint8_t getMenuEvent();
+    uint8_t getDisplayWidth() { return _width; }
+    uint8_t getDisplayHeight() { return _height; }
+    uint8_t getBufferTileHeight() { return _bufferTileHeight; }
+    void setBufferCurrTileRow(uint8_t row);
+    void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+    void setClipWindow(int x0, int y0, int x1, int y1);
+    void setMaxClipWindow();
+    void setDrawColor(uint8_t color);
+    void setFont(const uint8_t* font);
+    void setFontPosTop();
+    void enableUTF8Print();
+    void disableUTF8Print();
+    void setCursor(int x, int y);
+    void drawPixel(int x, int y);
+    void drawLine(int x0, int y0, int x1, int y1);
+    void drawBox(int x, int y, int w, int h);
+    void drawXBMP(int x, int y, int w, int h, const uint8_t* bitmap);
+    size_t write(uint8_t c);
+    using Print::write;
+    u8x8_t* getU8x8() { return &_u8x8; }
+    const std::vector<uint8_t>& getScreen() const override { return _screen; }
+  private:
+    u8x8_t _u8x8 = {hostByteCallback};
+    static uint8_t hostByteCallback(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr);
+    void transfer(uint8_t commands, uint8_t data);         // Send commands and data bytes to display in a single transfer
+    void transferTiles(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);  // Send tiles of the buffer (each tile row in its own transfer)
+    void setCurrTileRow(uint8_t row);
+    uint8_t _bufferTileHeight;
+    uint8_t _currTileRow = 0;
+    std::vector<uint8_t> _screen;  // Contents of display memory, the same layout as the framebuffer
+    uint8_t _color = HOST_COLOR_SET;
+    const uint8_t* _font = u8g2_font_6x12_tf;
+    bool _utf8 = false;
+    int _cursorX = 0;
+    int _cursorY = 0;
+};
+
+#endif
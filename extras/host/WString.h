@@ -0,0 +1,9 @@
+// Minimal stand-in for the Arduino core's WString.h: flash string helper used by GEM titles.
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+#endif
@@ -0,0 +1,121 @@
+// Benchmark of GEMFormat functions against itoa() and dtostrf() previously used by GEM.
+// Reference implementations mirror the ones shipped with non-AVR cores (e.g. SAMD's avr/dtostrf.c,
+// which is a thin wrapper around sprintf()). Output of both is cross-checked before timing.
+
+#include <Arduino.h>
+#include <chrono>
+#include "GEMFormat.h"
+
+static char* referenceItoa(int value, char* str) {
+  char digits[12];
+  byte count = 0;
+  unsigned int valueAbs = value < 0 ? 0U - (unsigned int)value : value;
+  do {
+    digits[count++] = '0' + valueAbs % 10;
+    valueAbs /= 10;
+  } while (valueAbs > 0);
+  char* p = str;
+  if (value < 0) {
+    *p++ = '-';
+  }
+  while (count > 0) {
+    *p++ = digits[--count];
+  }
+  *p = '\0';
+  return str;
+}
+
+static char* referenceDtostrf(double value, signed char width, unsigned char precision, char* str) {
+  char fmt[20];
+  sprintf(fmt, "%%%d.%df", width, precision);
+  sprintf(str, fmt, value);
+  return str;
+}
+
+// Prevent the compiler from optimizing away the result of formatting
+static volatile char sink;
+
+template <typename F>
+static double measure(const char* name, long iterations, F fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; i++) {
+    fn(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  printf("  %-28s %8.1f ns/call\n", name, ns);
+  return ns;
+}
+
+// Values are equal if they differ by no more than one unit in the last printed digit
+// (sprintf() rounds exact binary ties to even, GEMFormatFloat() rounds them up)
+static bool sameValue(const char* a, const char* b, byte precision) {
+  return strcmp(a, b) == 0 || fabs(strtod(a, nullptr) - strtod(b, nullptr)) <= 1.0001 / pow(10, precision);
+}
+
+static int crossCheck() {
+  char expected[32];
+  char actual[32];
+  int mismatches = 0;
+  for (long value = -32768; value <= 32767; value++) {
+    referenceItoa(value, expected);
+    GEMFormatInt(value, actual);
+    if (strcmp(expected, actual) != 0) {
+      printf("  int mismatch: %s != %s\n", expected, actual);
+      mismatches++;
+    }
+  }
+  srand(1);
+  for (long i = 0; i < 100000; i++) {
+    double value = ((double)rand() / RAND_MAX - 0.5) * pow(10, rand() % 8);
+    byte precision = rand() % 7;
+    referenceDtostrf(value, precision + 1, precision, expected);
+    GEMFormatFloat(value, precision, actual, sizeof(actual));
+    // dtostrf() keeps the minus sign of the values rounded to zero, GEMFormatFloat() does not
+    const char* expectedCmp = (expected[0] == '-' && strtod(expected, nullptr) == 0) ? expected + 1 : expected;
+    if (!sameValue(expectedCmp, actual, precision)) {
+      if (mismatches < 20) {
+        printf("  float mismatch (%.10f, %d): %s != %s\n", value, precision, expected, actual);
+      }
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+int main() {
+  printf("Cross-check\n");
+  int mismatches = crossCheck();
+  printf("  %d mismatches\n", mismatches);
+
+  const long iterations = 2000000;
+  char buffer[32];
+  printf("Integer formatting (%ld iterations)\n", iterations);
+  double itoaNs = measure("itoa()", iterations, [&](long i) {
+    referenceItoa((int)(i * 7 - 32768) % 32768, buffer);
+    sink = buffer[0];
+  });
+  double intNs = measure("GEMFormatInt()", iterations, [&](long i) {
+    GEMFormatInt((int)(i * 7 - 32768) % 32768, buffer);
+    sink = buffer[0];
+  });
+  printf("  speedup x%.2f\n", itoaNs / intNs);
+
+  printf("Floating-point formatting (%ld iterations)\n", iterations);
+  for (byte precision = 0; precision <= 6; precision += 3) {
+    char name[40];
+    sprintf(name, "dtostrf(), precision %d", precision);
+    double dtostrfNs = measure(name, iterations, [&](long i) {
+      referenceDtostrf((i % 200000 - 100000) / 37.0, precision + 1, precision, buffer);
+      sink = buffer[0];
+    });
+    sprintf(name, "GEMFormatFloat(), precision %d", precision);
+    double floatNs = measure(name, iterations, [&](long i) {
+      GEMFormatFloat((i % 200000 - 100000) / 37.0, precision, buffer, sizeof(buffer));
+      sink = buffer[0];
+    });
+    printf("  speedup x%.2f\n", dtostrfNs / floatNs);
+  }
+
+  return mismatches == 0 ? 0 : 1;
+}
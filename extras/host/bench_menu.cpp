@@ -0,0 +1,294 @@
+// Benchmark of navigation, editing and option select workloads of GEM on synthetic menus (flat pages of 10 to 250 menu items,
+// tree of 1000 menu items, deep tree of menu pages, big option selects, page of menu items with callback values).
+// Scripted key presses are registered through registerKeyPress(), and for each workload time, drawing calls, bytes and commands
+// sent to display (see GEMBusCounter) and full redraws are reported per operation (single key press).
+// Built once per version of GEM (GEM_u8g2 by default, GEM for AltSerialGraphicLCD with BENCH_GLCD defined), the same way as render_check.
+// Usage: bench_menu_u8g2 [-r repetitions] [-j results.json]
+// Results written with -j argument are meant for comparison with the previous runs: counts are exact and don't depend on the machine,
+// while time includes recording of the drawing calls by the host stand-ins and is only comparable between runs on the same machine.
+
+#include <Arduino.h>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+#include "GEMFormat.h"
+#ifdef BENCH_GLCD
+#include <AltSerialGraphicLCD.h>
+#include <GEM.h>
+typedef GLCD Display;
+typedef GEM Menu;
+static const char* rendererName = "GEM";
+#else
+#include <U8g2lib.h>
+#include <GEM_u8g2.h>
+typedef U8G2 Display;
+typedef GEM_u8g2 Menu;
+static const char* rendererName = "GEM_u8g2";
+#endif
+
+#ifndef GEM_ENABLE_BUS_COUNTER
+#error "Benchmark should be built against library with GEM_ENABLE_BUS_COUNTER defined"
+#endif
+
+// Menu pages and menu items of the synthetic menu, along with their titles and linked variables
+// (deque keeps objects in place, since menu refers to them by pointer)
+class SyntheticMenu {
+  public:
+    GEMPage& page(const std::string& title) {
+      pages.emplace_back(keep(title));
+      return pages.back();
+    }
+    GEMItem& intItem(GEMPage& parent, const std::string& title) {
+      ints.push_back((int)ints.size());
+      return add(parent, items.emplace(items.end(), keep(title), ints.back()));
+    }
+    GEMItem& boolItem(GEMPage& parent, const std::string& title) {
+      bools.push_back(false);
+      return add(parent, items.emplace(items.end(), keep(title), bools.back()));
+    }
+    GEMItem& charItem(GEMPage& parent, const std::string& title) {
+      strings.emplace_back();
+      strcpy(strings.back().value, "abcdefghijklmnop");
+      return add(parent, items.emplace(items.end(), keep(title), strings.back().value));
+    }
+    GEMItem& selectItem(GEMPage& parent, const std::string& title, GEMSelect& select) {
+      ints.push_back(0);
+      return add(parent, items.emplace(items.end(), keep(title), ints.back(), select));
+    }
+    GEMItem& callbackItem(GEMPage& parent, const std::string& title, const char* const (*getValue)(void)) {
+      return add(parent, items.emplace(items.end(), keep(title), getValue));
+    }
+    GEMItem& linkItem(GEMPage& parent, const std::string& title, GEMPage& linked) {
+      linked.setParentMenuPage(parent);
+      return add(parent, items.emplace(items.end(), keep(title), linked));
+    }
+    GEMSelect& select(int length) {
+      options.emplace_back();
+      std::vector<SelectOptionInt>& selectOptions = options.back();
+      for (int i = 0; i < length; i++) {
+        selectOptions.push_back({const_cast<char*>(keep("Option " + std::to_string(i))), i});
+      }
+      selects.emplace_back(length, selectOptions.data());
+      return selects.back();
+    }
+    GEMPage& root() {
+      return pages.front();
+    }
+  private:
+    struct CharValue {
+      char value[GEM_STR_LEN];
+    };
+    std::deque<std::string> titles;
+    std::deque<GEMPage> pages;
+    std::deque<GEMItem> items;
+    std::deque<int> ints;
+    std::deque<bool> bools;
+    std::deque<CharValue> strings;
+    std::deque<std::vector<SelectOptionInt>> options;
+    std::deque<GEMSelect> selects;
+    const char* keep(const std::string& title) {
+      titles.push_back(title);
+      return titles.back().c_str();
+    }
+    GEMItem& add(GEMPage& parent, std::deque<GEMItem>::iterator item) {
+      parent.addMenuItem(*item);
+      return *item;
+    }
+};
+
+// Key presses of the workload: each step is registered the given number of times
+struct Step {
+  byte key;
+  int times;
+};
+
+struct Workload {
+  const char* name;
+  void (*build)(SyntheticMenu& menu);
+  std::vector<Step> script;
+};
+
+struct Result {
+  const char* name;
+  unsigned long operations;
+  double timeNs;
+  unsigned long drawCalls;
+  unsigned long bytes;
+  unsigned long commands;
+  unsigned long frames;
+};
+
+static void buildFlat(SyntheticMenu& menu, int count) {
+  GEMPage& root = menu.page("Flat");
+  for (int i = 0; i < count; i++) {
+    menu.intItem(root, "Item " + std::to_string(i));
+  }
+}
+
+// Tree of 1000 menu items: menu page can hold up to 255 menu items, so they are split between 4 child pages of 250 menu items each
+static void buildTree(SyntheticMenu& menu) {
+  GEMPage& root = menu.page("Tree");
+  for (int i = 0; i < 4; i++) {
+    GEMPage& child = menu.page("Branch " + std::to_string(i));
+    menu.linkItem(root, "Branch " + std::to_string(i), child);
+    for (int j = 0; j < 250; j++) {
+      menu.intItem(child, "Leaf " + std::to_string(j));
+    }
+  }
+}
+
+// Chain of 16 nested menu pages, link to the next level is the first menu item after Back button
+static void buildDeep(SyntheticMenu& menu) {
+  GEMPage* page = &menu.page("Level 0");
+  for (int level = 1; level <= 16; level++) {
+    GEMPage& child = menu.page("Level " + std::to_string(level));
+    menu.linkItem(*page, "Next level", child);
+    for (int i = 0; i < 4; i++) {
+      menu.intItem(*page, "Value " + std::to_string(i));
+    }
+    page = &child;
+  }
+}
+
+static void buildSelect(SyntheticMenu& menu) {
+  GEMPage& root = menu.page("Select");
+  menu.selectItem(root, "Option:", menu.select(250));
+}
+
+static long callbackValue = 0;
+
+static const char* const formatCallbackValue() {
+  static char buffer[GEM_STR_LEN];
+  GEMFormatInt(callbackValue++, buffer);
+  return buffer;
+}
+
+static void buildCallback(SyntheticMenu& menu) {
+  GEMPage& root = menu.page("Callbacks");
+  for (int i = 0; i < 20; i++) {
+    menu.callbackItem(root, "Live " + std::to_string(i), formatCallbackValue);
+  }
+}
+
+static void buildEdit(SyntheticMenu& menu) {
+  GEMPage& root = menu.page("Edit");
+  menu.intItem(root, "Number:");
+  menu.charItem(root, "Text:");
+  for (int i = 0; i < 5; i++) {
+    menu.boolItem(root, "Flag " + std::to_string(i));
+  }
+}
+
+static std::vector<Workload> workloads() {
+  std::vector<Workload> list;
+  list.push_back({"flat-10-scroll", [](SyntheticMenu& menu) { buildFlat(menu, 10); }, {{GEM_KEY_DOWN, 9}, {GEM_KEY_UP, 9}}});
+  list.push_back({"flat-100-scroll", [](SyntheticMenu& menu) { buildFlat(menu, 100); }, {{GEM_KEY_DOWN, 99}, {GEM_KEY_UP, 99}}});
+  list.push_back({"flat-250-scroll", [](SyntheticMenu& menu) { buildFlat(menu, 250); }, {{GEM_KEY_DOWN, 249}, {GEM_KEY_UP, 249}}});
+  std::vector<Step> tree;
+  for (int i = 0; i < 4; i++) {
+    tree.insert(tree.end(), {{GEM_KEY_OK, 1}, {GEM_KEY_DOWN, 249}, {GEM_KEY_CANCEL, 1}, {GEM_KEY_DOWN, 1}});
+  }
+  list.push_back({"tree-1000-scroll", buildTree, tree});
+  list.push_back({"deep-16-descend", buildDeep, {{GEM_KEY_OK, 16}, {GEM_KEY_CANCEL, 16}}});
+  list.push_back({"select-250-cycle", buildSelect, {{GEM_KEY_OK, 1}, {GEM_KEY_DOWN, 249}, {GEM_KEY_UP, 249}, {GEM_KEY_OK, 1}}});
+  list.push_back({"callback-20-scroll", buildCallback, {{GEM_KEY_DOWN, 19}, {GEM_KEY_UP, 19}}});
+  std::vector<Step> editInt = {{GEM_KEY_OK, 1}};
+  for (int i = 0; i < 5; i++) {
+    editInt.insert(editInt.end(), {{GEM_KEY_UP, 3}, {GEM_KEY_RIGHT, 1}});
+  }
+  editInt.push_back({GEM_KEY_OK, 1});
+  list.push_back({"edit-int-digits", buildEdit, editInt});
+  std::vector<Step> editChar = {{GEM_KEY_DOWN, 1}, {GEM_KEY_OK, 1}};
+  for (int i = 0; i < 16; i++) {
+    editChar.insert(editChar.end(), {{GEM_KEY_UP, 2}, {GEM_KEY_RIGHT, 1}});
+  }
+  editChar.push_back({GEM_KEY_OK, 1});
+  list.push_back({"edit-char-text", buildEdit, editChar});
+  std::vector<Step> toggle = {{GEM_KEY_DOWN, 2}};
+  for (int i = 0; i < 5; i++) {
+    toggle.insert(toggle.end(), {{GEM_KEY_OK, 1}, {GEM_KEY_DOWN, 1}});
+  }
+  list.push_back({"toggle-bool", buildEdit, toggle});
+  return list;
+}
+
+// Each repetition starts with freshly built menu, so that every run of the script starts from the same state;
+// only registerKeyPress() calls are timed
+static Result run(const Workload& workload, Menu& menu, Display& display, GEMBusCounter& counter, int repetitions) {
+  Result result = {workload.name, 0, 0, 0, 0, 0, 0};
+  for (int r = 0; r < repetitions; r++) {
+    SyntheticMenu synthetic;
+    workload.build(synthetic);
+    menu.setMenuPageCurrent(synthetic.root());
+    menu.drawMenu();
+    display.clearCalls();
+    GEMBusTraffic start = counter.getTotal();
+    for (const Step& step : workload.script) {
+      for (int i = 0; i < step.times; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        menu.registerKeyPress(step.key);
+        auto end = std::chrono::steady_clock::now();
+        result.timeNs += std::chrono::duration<double, std::nano>(end - begin).count();
+        result.drawCalls += display.countCalls();
+        display.clearCalls();
+        result.operations++;
+      }
+    }
+    result.bytes += counter.getTotal().bytes - start.bytes;
+    result.commands += counter.getTotal().commands - start.commands;
+    result.frames += counter.getTotal().frames - start.frames;
+  }
+  return result;
+}
+
+static void writeJson(FILE* out, const std::vector<Result>& results, int repetitions) {
+  fprintf(out, "{\n  \"renderer\": \"%s\",\n  \"repetitions\": %d,\n  \"workloads\": [\n", rendererName, repetitions);
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    fprintf(out, "    {\"name\": \"%s\", \"operations\": %lu, \"time_ns_per_op\": %.1f, \"draw_calls\": %lu, \"bytes\": %lu, \"commands\": %lu, \"frames\": %lu}%s\n",
+            r.name, r.operations, r.timeNs / r.operations, r.drawCalls, r.bytes, r.commands, r.frames, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+  int repetitions = 5;
+  const char* jsonPath = nullptr;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "-r") == 0) {
+      repetitions = atoi(argv[i + 1]) > 0 ? atoi(argv[i + 1]) : 1;
+    } else if (strcmp(argv[i], "-j") == 0) {
+      jsonPath = argv[i + 1];
+    }
+  }
+
+  Display display;
+  Menu menu(display);
+  GEMBusCounter counter;
+  menu.setBusCounter(counter);
+  menu.hideVersion();
+  menu.init();
+
+  printf("%s, %d repetition(s), per operation (key press):\n", rendererName, repetitions);
+  printf("  %-20s %6s %10s %10s %10s %10s %7s\n", "workload", "ops", "ns", "calls", "bytes", "commands", "frames");
+  std::vector<Result> results;
+  for (const Workload& workload : workloads()) {
+    Result r = run(workload, menu, display, counter, repetitions);
+    double ops = r.operations;
+    printf("  %-20s %6lu %10.0f %10.1f %10.1f %10.1f %7.2f\n", r.name, r.operations / repetitions, r.timeNs / ops, r.drawCalls / ops, r.bytes / ops, r.commands / ops, r.frames / ops);
+    results.push_back(r);
+  }
+
+  if (jsonPath != nullptr) {
+    FILE* out = fopen(jsonPath, "w");
+    if (out == nullptr) {
+      printf("Can't write %s\n", jsonPath);
+      return 1;
+    }
+    writeJson(out, results, repetitions);
+    fclose(out);
+    printf("Results written to %s\n", jsonPath);
+  }
+  return 0;
+}
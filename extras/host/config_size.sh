@@ -0,0 +1,36 @@
+#!/bin/sh
+# Report the code size saved by each feature of config.h that can be disabled: renderer and menu item sources are
+# compiled with the feature disabled (GEM_DONT_SUPPORT_... define) and the size of their code is compared to the full build.
+# Sizes are those of the host compiler, point CXX and SIZE to the toolchain of the target to get the numbers for it.
+# Usage: sh config_size.sh (or make -C extras/host sizes)
+
+CXX=${CXX:-g++}
+SIZE=${SIZE:-size}
+SRC_DIR=../../src
+BUILD_DIR=build/sizes
+SOURCES="GEM_u8g2.cpp GEMItem.cpp"
+OPTIONS="FLOAT_EDIT SELECT FIXED_POINT STRING_BUFFER CALLBACK_VALUE BUTTON LINKED_VALUE TEXT POINTER_DASH POINTER_ROW CYRILLIC"
+
+mkdir -p $BUILD_DIR
+
+# Size of the code (text section) of the sources compiled with supplied defines
+codeSize() {
+  total=0
+  for f in $SOURCES; do
+    $CXX -std=gnu++11 -Os -ffunction-sections -fdata-sections -w -I. -I$SRC_DIR "$@" -c $SRC_DIR/$f -o $BUILD_DIR/${f%.cpp}.o || exit 1
+    total=$((total + $($SIZE $BUILD_DIR/${f%.cpp}.o | awk 'NR == 2 { print $1 }')))
+  done
+  echo $total
+}
+
+full=$(codeSize)
+printf "%-36s %6s bytes\n" "full build" "$full"
+all=""
+for option in $OPTIONS; do
+  size=$(codeSize -DGEM_DONT_SUPPORT_$option)
+  printf "%-36s %6s bytes (-%s)\n" "GEM_DONT_SUPPORT_$option" "$size" "$((full - size))"
+  # Only one of the pointer types can be disabled at a time
+  [ "$option" != "POINTER_DASH" ] && all="$all -DGEM_DONT_SUPPORT_$option"
+done
+size=$(codeSize $all)
+printf "%-36s %6s bytes (-%s)\n" "all of the above (dash pointer only)" "$size" "$((full - size))"
@@ -0,0 +1,149 @@
+// Check of GEMEdit: value of the menu item is edited character by character (or option by option) and assigned to the linked
+// variable only on save. Changes made to the string of StringBuffer are kept in the journal, which leaves variable intact until save (and
+// after cancel) and refuses changes of more than GEM_EDIT_JOURNAL_LEN distinct characters.
+
+#include <Arduino.h>
+#include "GEMItem.h"
+#include "GEMEdit.h"
+#include "GEMSelect.h"
+#include <limits.h>
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+static void checkNumber() {
+  printf("number edit\n");
+  int number = 42;
+  GEMItem menuItemNumber("Number:", number);
+  GEMEdit edit;
+  edit.begin(&menuItemNumber);
+  CHECK(strcmp(edit.getText(), "42") == 0);
+  CHECK(edit.setCode('7'));
+  CHECK(strcmp(edit.getText(), "72") == 0);
+  CHECK(number == 42);
+  edit.save();
+  CHECK(number == 72);
+
+  byte level = 200;
+  GEMItem menuItemLevel("Level:", level);
+  edit.begin(&menuItemLevel);
+  edit.setCode('9');
+  edit.clamp();  // 900 is out of range
+  CHECK(strcmp(edit.getText(), "255") == 0);
+  edit.save();
+  CHECK(level == 255);
+}
+
+static void checkString() {
+  printf("string edit\n");
+  char notes[64] = "abc";
+  GEMItem menuItemNotes("Notes:", StringBuffer{notes, sizeof(notes)});
+  GEMEdit edit;
+
+  // Character appended to the end is shown, but variable is changed only on save
+  edit.begin(&menuItemNotes);
+  edit.nextCursorPosition(3, 8);
+  CHECK(edit.setCode(edit.nextCode(1)));  // Space is the first character after the end of the string
+  edit.setCode('d');
+  edit.prevCursorPosition(3);
+  CHECK(edit.setCode('X'));
+  CHECK(strcmp(edit.getText(), "Xbcd") == 0);
+  CHECK(strcmp(notes, "abc") == 0);
+  edit.save();
+  CHECK(strcmp(notes, "Xbcd") == 0);
+
+  // Canceled edit leaves variable intact
+  edit.begin(&menuItemNotes);
+  edit.setCode(' ');
+  CHECK(strcmp(edit.getText(), " bcd") == 0);
+  edit.cancel();
+  CHECK(strcmp(notes, "Xbcd") == 0);
+  edit.begin(&menuItemNotes);
+  CHECK(strcmp(edit.getText(), "Xbcd") == 0);
+
+  // Leading and trailing spaces are trimmed on save
+  edit.setCode(' ');
+  edit.nextCursorPosition(4, 8);
+  edit.setCode(' ');
+  edit.save();
+  CHECK(strcmp(notes, "bcd") == 0);
+
+  // Visible part of the long value scrolls along with the cursor
+  strcpy(notes, "0123456789abcdefghij");
+  edit.begin(&menuItemNotes);
+  edit.nextCursorPosition(12, 8);
+  CHECK(edit.getWindowOffset() == 5);
+  CHECK(strcmp(edit.getText(), "56789abcdefghij") == 0);
+  edit.setCode('-');
+  CHECK(strcmp(edit.getText(), "56789ab-defghij") == 0);
+  edit.cancel();
+
+  // Changes of more distinct characters than the journal holds are refused (already changed ones can still be changed)
+  edit.begin(&menuItemNotes);
+  bool accepted = true;
+  for (byte i = 0; i < GEM_EDIT_JOURNAL_LEN; i++) {
+    accepted = accepted && edit.setCode('*');
+    edit.nextCursorPosition(1, 8);
+  }
+  CHECK(accepted);
+  CHECK(!edit.setCode('*'));
+  edit.prevCursorPosition(1);
+  CHECK(edit.setCode('+'));
+  CHECK(strcmp(notes, "0123456789abcdefghij") == 0);
+  edit.save();
+  CHECK(strcmp(notes, "***************+ghij") == 0);
+}
+
+static void checkSelect() {
+  printf("select edit\n");
+  // Whole range of int holds INT_MAX options, so value INT_MAX has no matching option
+  SelectOptionRangeInt wholeRange = {INT_MIN, INT_MAX, 1, nullptr};
+  GEMSelect wholeSelect(wholeRange);
+  int value = INT_MAX;
+  GEMItem menuItemValue("Value:", value, wholeSelect);
+  GEMEdit edit;
+
+  // Select with no matching option stays as is on the move to the previous option, and value is left intact on save
+  edit.begin(&menuItemValue);
+  edit.prevSelect(1);
+  edit.save();
+  CHECK(value == INT_MAX);
+  // ...and moves to the first option on the move to the next one (count of the options minus -1 would overflow int)
+  edit.nextSelect(1);
+  edit.save();
+  CHECK(value == INT_MIN);
+
+  // Move past the last option of the capped range (-2) stops at it
+  value = -5;
+  edit.begin(&menuItemValue);
+  edit.nextSelect(200);
+  edit.save();
+  CHECK(value == -2);
+  edit.prevSelect(2);
+  edit.save();
+  CHECK(value == -4);
+  edit.prevSelect(255);
+  edit.prevSelect(255);
+  edit.save();
+  CHECK(value == -4 - 510);
+  edit.end();
+}
+
+int main() {
+  checkNumber();
+  checkString();
+  checkSelect();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
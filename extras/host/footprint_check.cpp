@@ -0,0 +1,59 @@
+// Footprint check of the sample menu configuration: fails (at compile time for the menu objects, at run time for
+// the whole tree) when memory taken by the menu exceeds the budget. Note that sizes on the host differ from the ones
+// on the target MCU (e.g. pointers are 8 bytes wide instead of 2 on AVR), so the budget is set for the host build.
+// Budget can be overridden: make -C extras/host check FOOTPRINT_BUDGET=1536
+
+#include <Arduino.h>
+#include "GEMFootprint.h"
+
+#ifndef FOOTPRINT_BUDGET
+#define FOOTPRINT_BUDGET 1280
+#endif
+
+static_assert(GEMFootprint::estimate(2, 6, 2) <= FOOTPRINT_BUDGET, "Menu objects exceed the footprint budget");
+
+int number = 512;
+bool enablePrint = false;
+char label[GEM_STR_LEN] = "Sample";
+int interval = 100;
+byte tempo = 5;
+
+SelectOptionInt intervalOptions[] = {{(char*)"Fast", 50}, {(char*)"Normal", 100}, {(char*)"Slow", 500}};
+GEMSelect intervalSelect(sizeof(intervalOptions)/sizeof(SelectOptionInt), intervalOptions);
+SelectOptionRangeByte tempoRange = {1, 10, 1, nullptr};
+GEMSelect tempoSelect(tempoRange);
+
+GEMItem menuItemInt("Number:", number);
+GEMItem menuItemBool("Enable print:", enablePrint);
+GEMItem menuItemLabel("Label:", label);
+GEMItem menuItemInterval("Interval:", interval, intervalSelect);
+GEMItem menuItemTempo("Tempo:", tempo, tempoSelect);
+
+GEMPage menuPageMain("Main Menu");
+GEMPage menuPageSettings("Settings");
+GEMItem menuItemSettingsLink("Settings", menuPageSettings);
+
+int main() {
+  menuPageMain.addMenuItem(menuItemInt);
+  menuPageMain.addMenuItem(menuItemBool);
+  menuPageMain.addMenuItem(menuItemSettingsLink);
+  menuPageSettings.addMenuItem(menuItemLabel);
+  menuPageSettings.addMenuItem(menuItemInterval);
+  menuPageSettings.addMenuItem(menuItemTempo);
+  menuPageSettings.setParentMenuPage(menuPageMain);
+
+  GEMFootprint footprint;
+  footprint.measure(menuPageMain);
+  printf("pages:    %3u x %3u = %5u bytes\n", footprint.pages, (unsigned)sizeof(GEMPage), (unsigned)footprint.pagesBytes);
+  printf("items:    %3u x %3u = %5u bytes\n", footprint.items, (unsigned)sizeof(GEMItem), (unsigned)footprint.itemsBytes);
+  printf("selects:  %3u x %3u = %5u bytes (including shared label buffer)\n", footprint.selects, (unsigned)sizeof(GEMSelect), (unsigned)footprint.selectsBytes);
+  printf("options:              %5u bytes\n", (unsigned)footprint.optionsBytes);
+  printf("strings:              %5u bytes\n", (unsigned)footprint.stringsBytes);
+  printf("titles:               %5u bytes\n", (unsigned)footprint.titlesBytes);
+  printf("total:                %5u bytes (budget %u)\n", (unsigned)footprint.total(), (unsigned)FOOTPRINT_BUDGET);
+  if (footprint.total() > FOOTPRINT_BUDGET) {
+    printf("FAIL: footprint exceeds the budget\n");
+    return 1;
+  }
+  return 0;
+}
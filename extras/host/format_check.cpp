@@ -0,0 +1,167 @@
+// Check of conversions of GEMFormat: strings typed in edit mode are parsed with the limits of each type of variable
+// (malformed strings, out of range values and overflow of the intermediate value are told apart, and variable is left intact),
+// and integer, fixed-point and floating-point values are printed back (the latter within the size of the buffer).
+
+#include <Arduino.h>
+#include "GEMFormat.h"
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+// Parse string as int variable, returning status and value (-1 if variable is left intact)
+static byte parseInt(const char* str, long min, long max, long& value) {
+  value = -1;
+  return GEMParseInt(str, min, max, value);
+}
+
+static byte parseFixed(const char* str, byte decimals, long& value) {
+  value = -1;
+  return GEMParseFixed(str, decimals, -32768, 32767, value);
+}
+
+static bool formatsFixed(long value, byte decimals, const char* expected) {
+  char buffer[24];
+  byte length = GEMFormatFixed(value, decimals, buffer);
+  return strcmp(buffer, expected) == 0 && length == strlen(expected);
+}
+
+static bool formatsInt(long value, const char* expected) {
+  char buffer[24];
+  byte length = GEMFormatInt(value, buffer);
+  return strcmp(buffer, expected) == 0 && length == strlen(expected);
+}
+
+// Print floating-point value into the buffer of the supplied size, followed by guard bytes that should be left intact
+static bool formatsFloat(double value, byte precision, byte size, const char* expected) {
+  char buffer[40];
+  memset(buffer, '#', sizeof(buffer));
+  byte length = GEMFormatFloat(value, precision, buffer, size);
+  bool guarded = true;
+  for (byte i = size; i < sizeof(buffer); i++) {
+    guarded = guarded && buffer[i] == '#';
+  }
+  return guarded && strcmp(buffer, expected) == 0 && length == strlen(expected);
+}
+
+static void checkParseInt() {
+  printf("parse integer\n");
+  long value;
+  CHECK(parseInt("  42 ", 0, 255, value) == GEM_PARSE_OK && value == 42);
+  CHECK(parseInt("   ", 0, 255, value) == GEM_PARSE_OK && value == 0);  // Spaces only (e.g. value erased in edit mode)
+  CHECK(parseInt("", 0, 255, value) == GEM_PARSE_OK && value == 0);
+  CHECK(parseInt("-0", 0, 255, value) == GEM_PARSE_OK && value == 0);
+  CHECK(parseInt("255", 0, 255, value) == GEM_PARSE_OK && value == 255);
+  CHECK(parseInt("256", 0, 255, value) == GEM_PARSE_RANGE && value == -1);
+  CHECK(parseInt("-1", 0, 255, value) == GEM_PARSE_RANGE && value == -1);
+  CHECK(parseInt("-2147483648", -2147483647L - 1, 2147483647L, value) == GEM_PARSE_OK && value == -2147483647L - 1);
+  CHECK(parseInt("2147483647", -2147483647L - 1, 2147483647L, value) == GEM_PARSE_OK && value == 2147483647L);
+  CHECK(parseInt("2147483648", -2147483647L - 1, 2147483647L, value) == GEM_PARSE_RANGE);
+  CHECK(parseInt("-2147483649", -2147483647L - 1, 2147483647L, value) == GEM_PARSE_RANGE);
+  CHECK(parseInt("99999999999", -2147483647L - 1, 2147483647L, value) == GEM_PARSE_RANGE);  // Overflow of the intermediate value
+  CHECK(parseInt("5", 10, 20, value) == GEM_PARSE_RANGE);
+  CHECK(parseInt("1 2", 0, 255, value) == GEM_PARSE_INVALID && value == -1);
+  CHECK(parseInt("- 5", 0, 255, value) == GEM_PARSE_INVALID);
+  CHECK(parseInt("5-", 0, 255, value) == GEM_PARSE_INVALID);
+  CHECK(parseInt("+5", 0, 255, value) == GEM_PARSE_INVALID);
+  CHECK(parseInt("-", -10, 10, value) == GEM_PARSE_INVALID);
+  CHECK(parseInt("1.0", 0, 255, value) == GEM_PARSE_INVALID);  // Decimal sign is not accepted for integer values
+}
+
+static void checkParseFixed() {
+  printf("parse fixed-point\n");
+  long value;
+  CHECK(parseFixed("12.5", 2, value) == GEM_PARSE_OK && value == 1250);
+  CHECK(parseFixed(" -3.25 ", 2, value) == GEM_PARSE_OK && value == -325);
+  CHECK(parseFixed("12", 2, value) == GEM_PARSE_OK && value == 1200);
+  CHECK(parseFixed("12.", 2, value) == GEM_PARSE_OK && value == 1200);
+  CHECK(parseFixed(".5", 1, value) == GEM_PARSE_OK && value == 5);
+  CHECK(parseFixed("1.500", 2, value) == GEM_PARSE_OK && value == 150);  // Trailing zeros beyond the precision are harmless
+  CHECK(parseFixed("1.505", 2, value) == GEM_PARSE_INVALID && value == -1);  // Too many decimals
+  CHECK(parseFixed("1.5", 0, value) == GEM_PARSE_INVALID);
+  CHECK(parseFixed("1.2.3", 2, value) == GEM_PARSE_INVALID);
+  CHECK(parseFixed(".", 2, value) == GEM_PARSE_INVALID);
+  CHECK(parseFixed("-.", 2, value) == GEM_PARSE_INVALID);
+  CHECK(parseFixed("327.67", 2, value) == GEM_PARSE_OK && value == 32767);
+  CHECK(parseFixed("327.68", 2, value) == GEM_PARSE_RANGE && value == -1);
+  CHECK(parseFixed("-327.68", 2, value) == GEM_PARSE_OK && value == -32768);
+  CHECK(parseFixed("-327.69", 2, value) == GEM_PARSE_RANGE);
+  CHECK(parseFixed("50000000", 2, value) == GEM_PARSE_RANGE);  // Overflow while scaling
+}
+
+static void checkParseFloat() {
+  printf("parse float\n");
+  double value;
+  CHECK(GEMParseFloat(" -1.5 ", value) == GEM_PARSE_OK && value == -1.5);
+  CHECK(GEMParseFloat("0.125", value) == GEM_PARSE_OK && value == 0.125);
+  CHECK(GEMParseFloat("2.", value) == GEM_PARSE_OK && value == 2);
+  CHECK(GEMParseFloat("  ", value) == GEM_PARSE_OK && value == 0);
+  value = 7;
+  CHECK(GEMParseFloat("-", value) == GEM_PARSE_INVALID && value == 7);
+  CHECK(GEMParseFloat(".", value) == GEM_PARSE_INVALID);
+  CHECK(GEMParseFloat("1.2.3", value) == GEM_PARSE_INVALID);
+  CHECK(GEMParseFloat("1 .5", value) == GEM_PARSE_INVALID);
+  CHECK(GEMParseFloat("1e3", value) == GEM_PARSE_INVALID && value == 7);
+}
+
+static void checkFormat() {
+  printf("format integer and fixed-point\n");
+  CHECK(formatsInt(0, "0"));
+  CHECK(formatsInt(-305, "-305"));
+  CHECK(formatsInt(-2147483647L - 1, "-2147483648"));
+  CHECK(formatsFixed(1250, 2, "12.50"));
+  CHECK(formatsFixed(-325, 2, "-3.25"));
+  CHECK(formatsFixed(5, 2, "0.05"));
+  CHECK(formatsFixed(-5, 2, "-0.05"));
+  CHECK(formatsFixed(0, 3, "0.000"));
+  CHECK(formatsFixed(42, 0, "42"));
+  CHECK(formatsFixed(-32768, 1, "-3276.8"));
+  CHECK(formatsFixed(-2147483647L - 1, 3, "-2147483.648"));
+  // Printed value is parsed back to the same one
+  char buffer[24];
+  long value = 0;
+  GEMFormatFixed(-1205, 3, buffer);
+  CHECK(GEMParseFixed(buffer, 3, -32768, 32767, value) == GEM_PARSE_OK && value == -1205);
+}
+
+static void checkFormatFloat() {
+  printf("format float\n");
+  CHECK(formatsFloat(-1.5, 2, 17, "-1.50"));
+  CHECK(formatsFloat(-0.001, 2, 17, "0.00"));  // Rounded to zero, without minus sign
+  CHECK(formatsFloat(9.9996, 3, 17, "10.000"));
+  CHECK(formatsFloat(0.0 / 0.0, 6, 17, "nan"));
+  CHECK(formatsFloat(-1.0 / 0.0, 6, 17, "inf"));
+  // Precision is reduced for the value to fit the buffer
+  CHECK(formatsFloat(-4e9, 6, 17, "-4000000000.0000"));
+  CHECK(formatsFloat(4294967040.0, 9, 17, "4294967040.00000"));
+  CHECK(formatsFloat(123.456, 6, 6, "123.5"));
+  CHECK(formatsFloat(999.96, 2, 6, "1000"));  // Rounding carries over to the integer part, leaving no room for decimals
+  CHECK(formatsFloat(-123456, 2, 5, "-123"));  // Cut off when integer part doesn't fit either
+  CHECK(formatsFloat(1.5, 2, 1, ""));
+  // Values beyond the range of unsigned long are printed in exponent form
+  CHECK(formatsFloat(1.5e12, 2, 17, "1.50e12"));
+  CHECK(formatsFloat(-4294967296.0, 6, 17, "-4.294967e9"));
+  CHECK(formatsFloat(9.9999e20, 2, 17, "1.00e21"));
+  CHECK(formatsFloat(1e300, 9, 17, "1.000000000e300"));
+  CHECK(formatsFloat(-1e300, 9, 12, "-1.0000e300"));
+}
+
+int main() {
+  checkParseInt();
+  checkParseFixed();
+  checkParseFloat();
+  checkFormat();
+  checkFormatFloat();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
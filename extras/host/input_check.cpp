@@ -0,0 +1,242 @@
+// Check of input helpers: key press queue (order of key presses, overflow and count of dropped ones), rotary encoder
+// (quadrature sequences, contact bounce and acceleration) and buttons (debounce, repeat, long press and scan order). Levels of the
+// pins of the buttons are set with setPinLevel() of the host stand-in, time is advanced with delay().
+
+#include <Arduino.h>
+#include "GEMKeyQueue.h"
+#include "GEMEncoder.h"
+#include "GEMButtons.h"
+#include <GEM_u8g2.h>  // Key codes
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+static void checkKeyQueue() {
+  printf("key queue\n");
+  GEMKeyQueue queue;
+  GEMKeyEvent event;
+  CHECK(queue.isEmpty());
+  CHECK(!queue.pop(event));
+  for (byte i = 0; i < GEM_KEY_QUEUE_LEN; i++) {
+    CHECK(queue.push(GEM_KEY_UP + i % 6));
+  }
+  CHECK(queue.count() == GEM_KEY_QUEUE_LEN);
+  CHECK(!queue.push(GEM_KEY_OK));
+  CHECK(!queue.push(GEM_KEY_OK));
+  CHECK(queue.getDropped() == 2);
+  CHECK(queue.count() == GEM_KEY_QUEUE_LEN);
+
+  // Key presses are taken in the order they were pushed, dropped ones are lost
+  bool ordered = true;
+  for (byte i = 0; i < GEM_KEY_QUEUE_LEN; i++) {
+    ordered = ordered && queue.pop(event) && event.key == GEM_KEY_UP + i % 6;
+  }
+  CHECK(ordered);
+  CHECK(queue.isEmpty());
+
+  // Indices keep wrapping around over many pushes and pops
+  bool wrapped = true;
+  for (unsigned int i = 0; i < 1000; i++) {
+    wrapped = wrapped && queue.push(GEM_KEY_DOWN) && queue.push(GEM_KEY_LEFT) && queue.count() == 2;
+    wrapped = wrapped && queue.pop(event) && event.key == GEM_KEY_DOWN && queue.pop(event) && event.key == GEM_KEY_LEFT;
+  }
+  CHECK(wrapped);
+  CHECK(queue.getDropped() == 2);
+
+  queue.push(GEM_KEY_CANCEL);
+  queue.clear();
+  CHECK(queue.isEmpty());
+}
+
+// Turn encoder by the supplied number of detents (4 quadrature state changes each), clockwise for positive count
+static void turn(GEMEncoder& encoder, int detents) {
+  static const bool sequence[4][2] = {{false, true}, {false, false}, {true, false}, {true, true}};
+  for (int i = 0; i < abs(detents); i++) {
+    for (byte j = 0; j < 4; j++) {
+      byte k = (detents > 0) ? j : (2 - j) & 3;
+      encoder.update(sequence[k][0], sequence[k][1]);
+    }
+  }
+}
+
+static void checkEncoder() {
+  printf("rotary encoder\n");
+  GEMEncoder encoder(2, 3);
+  encoder.begin();  // Both pins read HIGH at rest
+  delay(1000);
+  turn(encoder, 1);
+  CHECK(encoder.read() == 1);
+  CHECK(encoder.read() == 0);
+  delay(1000);
+  turn(encoder, -1);
+  CHECK(encoder.read() == -1);
+
+  // Partial turn is not counted until the detent is reached
+  encoder.update(false, true);
+  encoder.update(false, false);
+  CHECK(encoder.read() == 0);
+  encoder.update(false, true);  // Back off
+  encoder.update(true, true);
+  CHECK(encoder.read() == 0);
+
+  // Contact bounce back and forth between adjacent states cancels out, and invalid transitions are ignored
+  encoder.update(false, true);
+  encoder.update(true, true);
+  encoder.update(false, true);
+  encoder.update(true, false);  // Both pins changed
+  encoder.update(false, true);
+  encoder.update(false, false);
+  encoder.update(true, false);
+  encoder.update(true, true);
+  CHECK(encoder.read() == 1);
+
+  // Slow rotation moves by single steps, fast one is accelerated
+  encoder.setAcceleration(50, 8);
+  int slow = 0;
+  for (byte i = 0; i < 10; i++) {
+    delay(100);
+    turn(encoder, 1);
+    slow += encoder.read();
+  }
+  CHECK(slow == 10);
+  int fast = 0;
+  for (byte i = 0; i < 10; i++) {
+    delay(5);
+    turn(encoder, 1);
+    fast += encoder.read();
+  }
+  CHECK(fast > 20);
+  encoder.setAcceleration(50, 1);
+  delay(1000);
+  int plain = 0;
+  for (byte i = 0; i < 10; i++) {
+    delay(5);
+    turn(encoder, -1);
+    plain += encoder.read();
+  }
+  CHECK(plain == -10);
+}
+
+static void checkButtons() {
+  printf("buttons\n");
+  const byte pinUp = 4;
+  const byte pinOk = 5;
+  GEMButton buttons[] = {{GEM_KEY_UP, pinUp, GEM_KEY_NONE, 0, 0, 0}, {GEM_KEY_OK, pinOk, GEM_KEY_CANCEL, 0, 0, 0}};
+  GEMButtons keypad(buttons, 2, true);  // Pressed buttons pull pins LOW
+  keypad.begin();
+  keypad.setDebounce(20);
+  keypad.setRepeat(500, 100);
+  keypad.setLongPress(800);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  CHECK(keypad.isIdle());
+
+  // Bouncing contact is reported once, after its level is stable for the debounce time
+  for (byte i = 0; i < 5; i++) {
+    setPinLevel(pinUp, (i % 2 == 0) ? LOW : HIGH);
+    delay(3);
+    CHECK(keypad.getKey() == GEM_KEY_NONE);
+  }
+  setPinLevel(pinUp, LOW);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  CHECK(!keypad.isIdle());
+  delay(10);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  delay(15);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  CHECK(keypad.getEvent() == GEM_BUTTON_PRESS);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+
+  // Held button repeats after the delay, then every interval
+  delay(490);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  delay(20);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  CHECK(keypad.getEvent() == GEM_BUTTON_REPEAT);
+  delay(90);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  delay(20);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  CHECK(keypad.getEvent() == GEM_BUTTON_REPEAT);
+
+  // Short glitch of the released level is ignored
+  setPinLevel(pinUp, HIGH);
+  delay(5);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  setPinLevel(pinUp, LOW);
+  delay(5);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  setPinLevel(pinUp, HIGH);
+  keypad.getKey();
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  CHECK(keypad.isIdle());
+
+  // Button with long-press key code reports short press on release, long press while held (and nothing on release after it)
+  setPinLevel(pinOk, LOW);
+  keypad.getKey();
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  delay(100);
+  setPinLevel(pinOk, HIGH);
+  keypad.getKey();
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_OK);
+  CHECK(keypad.getEvent() == GEM_BUTTON_PRESS);
+
+  setPinLevel(pinOk, LOW);
+  keypad.getKey();
+  delay(30);
+  keypad.getKey();
+  delay(850);
+  CHECK(keypad.getKey() == GEM_KEY_CANCEL);
+  CHECK(keypad.getEvent() == GEM_BUTTON_LONG_PRESS);
+  delay(1000);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);  // Long press doesn't repeat
+  setPinLevel(pinOk, HIGH);
+  keypad.getKey();
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  CHECK(keypad.isIdle());
+
+  // Button held down doesn't starve the buttons after it in the array: scan starts after the button that fired
+  keypad.setRepeat(500, 0);  // Held button is due to repeat on each call
+  setPinLevel(pinUp, LOW);
+  setPinLevel(pinOk, LOW);
+  keypad.getKey();
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);  // Press of Ok is accepted, but emitted only on release
+  delay(500);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  setPinLevel(pinOk, HIGH);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_OK);
+  CHECK(keypad.getEvent() == GEM_BUTTON_PRESS);
+  CHECK(keypad.getKey() == GEM_KEY_UP);
+  setPinLevel(pinUp, HIGH);
+  keypad.getKey();
+  delay(30);
+  CHECK(keypad.getKey() == GEM_KEY_NONE);
+  CHECK(keypad.isIdle());
+}
+
+int main() {
+  checkKeyQueue();
+  checkEncoder();
+  checkButtons();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,254 @@
+// Check of GEMPersist against storage in RAM: values are written, loaded back by a fresh GEMPersist (as after reset),
+// records are rotated across the slots, and torn or damaged records fall back to the previous one. Option selects are
+// checked to restore the same option after options are reordered in "later firmware".
+
+#include <Arduino.h>
+#include "GEMPersist.h"
+#include "GEMSelect.h"
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+// Storage that counts writes of each byte, and can be "powered down" after the supplied number of bytes is written
+class CountingStorage : public GEMStorage {
+  public:
+    CountingStorage() {
+      memset(_data, 0xFF, sizeof(_data));
+      memset(_writes, 0, sizeof(_writes));
+    }
+    unsigned int length() { return sizeof(_data); }
+    byte read(unsigned int address) { return _data[address]; }
+    void write(unsigned int address, byte value) {
+      if (_budget == 0) {
+        return;
+      }
+      _budget--;
+      _lastWrite = address;
+      if (_data[address] != value) {
+        _data[address] = value;
+        _writes[address]++;
+      }
+    }
+    void powerDownAfter(unsigned int bytes) { _budget = bytes; }
+    void powerUp() { _budget = UINT16_MAX; }
+    void corrupt(unsigned int address) { _data[address] ^= 0x5A; }
+    unsigned int getLastWrite() { return _lastWrite; }
+    unsigned int getWrites(unsigned int address) { return _writes[address]; }
+    unsigned int getWrites() {
+      unsigned int writes = 0;
+      for (unsigned int i = 0; i < length(); i++) {
+        writes += _writes[i];
+      }
+      return writes;
+    }
+  private:
+    byte _data[256];
+    unsigned int _writes[256];
+    unsigned int _budget = UINT16_MAX;
+    unsigned int _lastWrite = 0;
+};
+
+static int number = 512;
+static bool enabled = false;
+static char label[GEM_STR_LEN] = "Sample";
+static int interval = 100;
+static byte tempo = 5;
+
+static SelectOptionInt intervalOptions[] = {{(char*)"Fast", 50}, {(char*)"Normal", 100}, {(char*)"Slow", 500}};
+static GEMSelect intervalSelect(sizeof(intervalOptions)/sizeof(SelectOptionInt), intervalOptions);
+static SelectOptionRangeByte tempoRange = {1, 10, 1, nullptr};
+static GEMSelect tempoSelect(tempoRange);
+
+static GEMItem menuItemNumber("Number:", number);
+static GEMItem menuItemEnabled("Enabled:", enabled);
+static GEMItem menuItemLabel("Label:", label);
+static GEMItem menuItemInterval("Interval:", interval, intervalSelect);
+static GEMItem menuItemTempo("Tempo:", tempo, tempoSelect);
+static GEMItem* persistItems[] = {&menuItemNumber, &menuItemEnabled, &menuItemLabel, &menuItemInterval, &menuItemTempo};
+static const byte persistCount = sizeof(persistItems)/sizeof(GEMItem*);
+
+static void setValues(int number_, bool enabled_, const char* label_, int interval_, byte tempo_) {
+  number = number_;
+  enabled = enabled_;
+  strcpy(label, label_);
+  interval = interval_;
+  tempo = tempo_;
+}
+
+static bool hasValues(int number_, bool enabled_, const char* label_, int interval_, byte tempo_) {
+  return number == number_ && enabled == enabled_ && strcmp(label, label_) == 0 && interval == interval_ && tempo == tempo_;
+}
+
+// Load values with a fresh GEMPersist (as after reset), starting from the values that differ from any of the stored ones
+static bool reload(CountingStorage& storage) {
+  setValues(0, false, "", 0, 0);
+  GEMPersist persist(storage, persistItems, persistCount);
+  return persist.load();
+}
+
+static void checkLoadAndFlush() {
+  printf("load and flush\n");
+  CountingStorage storage;
+  GEMPersist persist(storage, persistItems, persistCount);
+  CHECK(persist.getSlots() > 1);
+  setValues(512, false, "Sample", 100, 5);
+  CHECK(!persist.load());
+  CHECK(hasValues(512, false, "Sample", 100, 5));  // Initial values are kept
+
+  setValues(1024, true, "Changed", 500, 7);
+  persist.markDirty(menuItemNumber);
+  CHECK(persist.isDirty());
+  persist.flush();
+  CHECK(!persist.isDirty());
+  CHECK(storage.getWrites() > 0);
+  CHECK(reload(storage));
+  CHECK(hasValues(1024, true, "Changed", 500, 7));
+
+  // Unchanged values, or values changed and then changed back, aren't written again
+  unsigned int writes = storage.getWrites();
+  persist.markDirty(menuItemNumber);
+  persist.flush();
+  CHECK(storage.getWrites() == writes);
+  number = 1;
+  persist.markDirty(menuItemNumber);
+  number = 1024;
+  persist.flush();
+  CHECK(storage.getWrites() == writes);
+}
+
+static void checkQuietTime() {
+  printf("quiet time\n");
+  CountingStorage storage;
+  GEMPersist persist(storage, persistItems, persistCount);
+  setValues(512, false, "Sample", 100, 5);
+  persist.load();
+  persist.setQuietTime(1000);
+  number = 600;
+  persist.markDirty(menuItemNumber);
+  unsigned long time;
+  CHECK(persist.getNextFlush(time));
+  persist.update();
+  CHECK(storage.getWrites() == 0);
+  delay(500);
+  number = 700;
+  persist.markDirty(menuItemNumber);  // Restarts quiet period
+  delay(700);
+  persist.update();
+  CHECK(storage.getWrites() == 0);
+  delay(300);
+  persist.update();
+  CHECK(storage.getWrites() > 0);
+  CHECK(!persist.getNextFlush(time));
+  CHECK(reload(storage) && number == 700);
+}
+
+static void checkWearLeveling() {
+  printf("slot rotation and wear leveling\n");
+  CountingStorage storage;
+  GEMPersist persist(storage, persistItems, persistCount);
+  setValues(0, false, "Sample", 100, 5);
+  persist.load();
+  byte slots = persist.getSlots();
+  unsigned int flushes = slots * 4 + 1;
+  for (unsigned int i = 1; i <= flushes; i++) {
+    number = i;
+    persist.markDirty(menuItemNumber);
+    persist.flush();
+  }
+  CHECK(reload(storage) && number == (int)flushes);
+  // Each byte (e.g. sequence number of the record) is written at most once per round over the slots, not once per flush
+  unsigned int writesMax = 0;
+  for (unsigned int address = 0; address < storage.length(); address++) {
+    if (storage.getWrites(address) > writesMax) {
+      writesMax = storage.getWrites(address);
+    }
+  }
+  CHECK(writesMax <= flushes / slots + 1);
+}
+
+static void checkTornAndCorrupt() {
+  printf("torn and corrupt records\n");
+  CountingStorage storage;
+  GEMPersist persist(storage, persistItems, persistCount);
+  setValues(512, false, "Sample", 100, 5);
+  persist.load();
+  persist.markDirty(menuItemNumber);
+  persist.flush();
+  setValues(1024, true, "Changed", 500, 7);
+  persist.markDirty(menuItemNumber);
+  persist.flush();
+
+  // Power is lost in the middle of the write: the previous record is loaded
+  setValues(2048, false, "Torn", 50, 9);
+  persist.markDirty(menuItemNumber);
+  storage.powerDownAfter(10);
+  persist.flush();
+  storage.powerUp();
+  CHECK(reload(storage));
+  CHECK(hasValues(1024, true, "Changed", 500, 7));
+
+  // The latest record is damaged: the one before it is loaded
+  GEMPersist persistAfterReset(storage, persistItems, persistCount);
+  persistAfterReset.load();
+  number = 4096;
+  persistAfterReset.markDirty(menuItemNumber);
+  persistAfterReset.flush();
+  storage.corrupt(storage.getLastWrite() + 4);  // The last byte written is the last one of the record header, followed by the payload
+  CHECK(reload(storage));
+  CHECK(hasValues(1024, true, "Changed", 500, 7));
+}
+
+static void checkSelectsAfterUpdate() {
+  printf("option selects after options change\n");
+  CountingStorage storage;
+  GEMPersist persist(storage, persistItems, persistCount);
+  setValues(512, false, "Sample", 500, 5);
+  persist.markDirty(menuItemInterval);
+  persist.flush();
+
+  // Later firmware reorders options and adds a new one: the same value is restored
+  SelectOptionInt intervalOptionsNew[] = {{(char*)"Slowest", 1000}, {(char*)"Slow", 500}, {(char*)"Normal", 100}, {(char*)"Fast", 50}};
+  GEMSelect intervalSelectNew(sizeof(intervalOptionsNew)/sizeof(SelectOptionInt), intervalOptionsNew);
+  GEMItem menuItemIntervalNew("Interval:", interval, intervalSelectNew);
+  menuItemIntervalNew.setId(menuItemInterval.getId());
+  GEMItem* persistItemsNew[] = {&menuItemNumber, &menuItemEnabled, &menuItemLabel, &menuItemIntervalNew, &menuItemTempo};
+  interval = 1000;
+  GEMPersist persistNew(storage, persistItemsNew, persistCount);
+  CHECK(persistNew.load());
+  CHECK(interval == 500);
+
+  // Stored value is no longer among the options: variable is left intact
+  SelectOptionInt intervalOptionsOther[] = {{(char*)"Fast", 50}, {(char*)"Normal", 100}};
+  GEMSelect intervalSelectOther(sizeof(intervalOptionsOther)/sizeof(SelectOptionInt), intervalOptionsOther);
+  GEMItem menuItemIntervalOther("Interval:", interval, intervalSelectOther);
+  menuItemIntervalOther.setId(menuItemInterval.getId());
+  GEMItem* persistItemsOther[] = {&menuItemNumber, &menuItemEnabled, &menuItemLabel, &menuItemIntervalOther, &menuItemTempo};
+  interval = 100;
+  GEMPersist persistOther(storage, persistItemsOther, persistCount);
+  CHECK(persistOther.load());
+  CHECK(interval == 100);
+}
+
+int main() {
+  for (byte i = 0; i < persistCount; i++) {
+    persistItems[i]->setId(i + 1);
+  }
+  checkLoadAndFlush();
+  checkQuietTime();
+  checkWearLeveling();
+  checkTornAndCorrupt();
+  checkSelectsAfterUpdate();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
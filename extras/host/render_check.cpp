@@ -0,0 +1,230 @@
+// Render check of GEM against host stand-ins of the graphics libraries: sample menu is drawn, navigated and edited,
+// and framebuffer and recorded drawing calls are checked after each step. Built once per version of GEM
+// (GEM_u8g2 by default, GEM for AltSerialGraphicLCD with RENDER_CHECK_GLCD defined), since both can't share
+// translation unit. Run with -v argument to print the framebuffer after each step.
+
+#include <Arduino.h>
+#ifdef RENDER_CHECK_GLCD
+#include <AltSerialGraphicLCD.h>
+#include <GEM.h>
+#else
+#include <U8g2lib.h>
+#include <GEM_u8g2.h>
+#endif
+#include "GEMPersist.h"  // GEMCrc16()
+
+static bool verbose = false;
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+static void step(const char* name, HostDisplay& display) {
+  printf("  %-28s %4u drawing calls\n", name, (unsigned)display.countCalls());
+  if (verbose) {
+    display.dump();
+  }
+}
+
+// Stream of the remote control that feeds supplied frame and discards responses
+class RemoteStream : public Stream {
+  public:
+    std::vector<byte> input;
+    size_t write(uint8_t) { return 1; }
+    int available() { return input.size() - _position; }
+    int read() { return (_position < input.size()) ? input[_position++] : -1; }
+    int peek() { return (_position < input.size()) ? input[_position] : -1; }
+  private:
+    size_t _position = 0;
+};
+
+// Frame of the remote control protocol that writes int value
+static std::vector<byte> writeFrame(byte id, int value) {
+  std::vector<byte> data = {0xA5, GEM_REMOTE_WRITE, 1 + sizeof(int), id};
+  data.insert(data.end(), (byte*)&value, (byte*)&value + sizeof(int));
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 1; i < data.size(); i++) {
+    crc = GEMCrc16(crc, data[i]);
+  }
+  data.push_back(crc & 0xFF);
+  data.push_back(crc >> 8);
+  return data;
+}
+
+// Menu pointer (GEM_POINTER_ROW) is the only thing drawn in two leftmost columns of the menu item row
+static bool pointerAt(HostDisplay& display, byte row) {
+  return display.countPixels(0, 11 + row * 10, 2, 7) > 0;
+}
+
+// Partial redraw (e.g. of the edited value only) should leave display showing the same as after the full redraw of the menu.
+// GEM draws edit mode on top of the menu (drawMenu() knows nothing of it), so the check applies to GEM_u8g2 only
+template <typename T>
+static bool matchesFullRedraw(T& menu, HostDisplay& display) {
+#ifdef RENDER_CHECK_GLCD
+  (void)menu;
+  (void)display;
+  return true;
+#else
+  std::vector<uint8_t> screen = display.getScreen();
+  menu.drawMenu();
+  return display.getScreen() == screen;
+#endif
+}
+
+template <typename T>
+static void checkRenderer(const char* name, T& menu, HostDisplay& display) {
+  int number = 512;
+  bool enabled = false;
+  SelectOptionByte speedOptions[] = {{(char*)"Slow", 1}, {(char*)"Fast", 2}};
+  GEMSelect speedSelect(sizeof(speedOptions)/sizeof(SelectOptionByte), speedOptions);
+  byte speed = 1;
+  byte level = 200;
+
+  GEMItem menuItemNumber("Number:", number);
+  GEMItem menuItemEnabled("Enabled:", enabled);
+  GEMItem menuItemSpeed("Speed:", speed, speedSelect);
+  GEMItem menuItemLevel("Level:", level);
+  GEMPage menuPageSettings("Settings");
+  GEMItem menuItemSettings("Settings", menuPageSettings);
+  GEMPage menuPageMain("Main Menu");
+
+  menuPageMain.addMenuItem(menuItemNumber);
+  menuPageMain.addMenuItem(menuItemEnabled);
+  menuPageMain.addMenuItem(menuItemSpeed);
+  menuPageMain.addMenuItem(menuItemLevel);
+  menuPageMain.addMenuItem(menuItemSettings);
+  menuPageSettings.setParentMenuPage(menuPageMain);
+
+  printf("%s\n", name);
+  menu.hideVersion();
+  menu.init();
+  menu.setMenuPageCurrent(menuPageMain);
+
+  display.clearCalls();
+  menu.drawMenu();
+  step("drawMenu()", display);
+  CHECK(display.countCalls() > 0);
+  CHECK(pointerAt(display, 0));
+  CHECK(!pointerAt(display, 1));
+
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_DOWN);
+  step("next menu item", display);
+  CHECK(!pointerAt(display, 0));
+  CHECK(pointerAt(display, 1));
+
+  unsigned int checkboxPixels = display.countPixels(86, 20, 8, 10);
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_OK);
+  step("checkbox toggle", display);
+  CHECK(enabled);
+  CHECK(display.countPixels(86, 20, 8, 10) != checkboxPixels);
+
+  menu.registerKeyPress(GEM_KEY_UP);
+  menu.registerKeyPress(GEM_KEY_OK);
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_RIGHT, 2);
+  step("move edit cursor 2 cells", display);
+  CHECK(display.countCalls("nextPage") == 0);  // Only the edited value is redrawn, not the whole frame
+  CHECK(matchesFullRedraw(menu, display));
+  menu.registerKeyPress(GEM_KEY_LEFT, 2);
+  CHECK(matchesFullRedraw(menu, display));
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_UP);
+  step("edit digit", display);
+  CHECK(display.countCalls() > 0);
+  CHECK(display.countCalls("nextPage") == 0);
+  CHECK(matchesFullRedraw(menu, display));
+  menu.registerKeyPress(GEM_KEY_OK);
+  CHECK(number == 612);
+
+  menu.registerKeyPress(GEM_KEY_DOWN, 2);
+  menu.registerKeyPress(GEM_KEY_OK);
+  menu.registerKeyPress(GEM_KEY_DOWN);
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_OK);
+  step("option select", display);
+  CHECK(speed == 2);
+
+  // Out of range value is clamped and shown on the first press of OK, saved on the second one
+  menu.registerKeyPress(GEM_KEY_DOWN);
+  menu.registerKeyPress(GEM_KEY_OK);
+  menu.registerKeyPress(GEM_KEY_UP);  // 300
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_OK);
+  step("clamp out of range value", display);
+  CHECK(level == 200);
+  CHECK(display.countCalls() > 0);
+  CHECK(matchesFullRedraw(menu, display));
+  menu.registerKeyPress(GEM_KEY_OK);
+  CHECK(level == 255);
+
+  // Malformed value is shown inverted until the next key press
+  menu.registerKeyPress(GEM_KEY_OK);
+  menu.registerKeyPress(GEM_KEY_RIGHT);
+  menu.registerKeyPress(GEM_KEY_UP, 5);  // "2 5"
+  unsigned int valuePixels = display.countPixels(86, 40, 40, 10);
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_OK);
+  step("invert malformed value", display);
+  CHECK(level == 255);
+  CHECK(display.countPixels(86, 40, 40, 10) > valuePixels + 100);
+  menu.registerKeyPress(GEM_KEY_LEFT);
+  CHECK(display.countPixels(86, 40, 40, 10) < valuePixels + 100);
+  CHECK(matchesFullRedraw(menu, display));
+
+  // Value written remotely during edit of another one leaves the edited value and the cursor in place, and is shown
+  // once edit is over (if not right away)
+  menuItemNumber.setId(1);
+  RemoteStream stream;
+  GEMRemote remote(stream, menuPageMain);
+  stream.input = writeFrame(menuItemNumber.getId(), 5);
+  unsigned int editPixels = display.countPixels(0, 40, 128, 10);
+  unsigned int numberPixels = display.countPixels(86, 10, 40, 10);
+  display.clearCalls();
+  menu.processRemote(remote);
+  step("remote write during edit", display);
+  CHECK(number == 5);
+  CHECK(display.countPixels(0, 40, 128, 10) == editPixels);
+  CHECK(matchesFullRedraw(menu, display));
+  menu.registerKeyPress(GEM_KEY_CANCEL);
+  CHECK(level == 255);
+  CHECK(display.countPixels(86, 10, 40, 10) < numberPixels);
+
+  menu.registerKeyPress(GEM_KEY_DOWN);
+  display.clearCalls();
+  menu.registerKeyPress(GEM_KEY_OK);
+  step("link to menu page", display);
+  CHECK(display.countCalls() > 0);
+  CHECK(pointerAt(display, 0));  // Back button of the child page
+}
+
+int main(int argc, char** argv) {
+  verbose = (argc > 1 && strcmp(argv[1], "-v") == 0);
+
+#ifdef RENDER_CHECK_GLCD
+  GLCD glcd;
+  GEM menu(glcd);
+  checkRenderer("GEM (AltSerialGraphicLCD)", menu, glcd);
+#else
+  U8G2 u8g2;
+  GEM_u8g2 menu(u8g2);
+  checkRenderer("GEM_u8g2", menu, u8g2);
+  // Page buffer of a single tile row, so that edited value is redrawn tile row by tile row
+  U8G2 u8g2Page(128, 64, 1);
+  GEM_u8g2 menuPage(u8g2Page);
+  checkRenderer("GEM_u8g2 (page buffer)", menuPage, u8g2Page);
+#endif
+
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,139 @@
+// Check of GEMScheduler: tasks run when their interval elapses (and only while their menu page is current), deadline of the
+// next run is reported for the main loop to sleep until, and runs over the budget of the task or of the whole tick are
+// accounted. Time is advanced with delay() of the host stand-in, which also stands for the work done by the tasks.
+
+#include <Arduino.h>
+#include "GEMScheduler.h"
+#include "GEMPage.h"
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+static unsigned int blinkRuns = 0;
+static unsigned int sensorRuns = 0;
+static unsigned int slowRuns = 0;
+static unsigned int overrunCalls = 0;
+
+static void blink() { blinkRuns++; }
+static void sensor() { sensorRuns++; }
+static void slow() { slowRuns++; delayMicroseconds(500); }
+static void onOverrun(GEMTask& /* task */) { overrunCalls++; }
+
+// Wait (in ms) until the deadline reported by the scheduler, or -1 if there are no tasks to wait for
+static long waitUntilNextRun(GEMScheduler& scheduler, GEMPage* page) {
+  unsigned long time;
+  if (!scheduler.getNextRun(page, time)) {
+    return -1;
+  }
+  return (long)(time - millis());
+}
+
+static void checkDeadlines() {
+  printf("intervals and deadlines\n");
+  GEMScheduler scheduler;
+  GEMTask blinkTask = {blink, 500, 0, nullptr, 0, 0, 0, nullptr};
+  GEMTask sensorTask = {sensor, 200, 0, nullptr, 0, 0, 0, nullptr};
+  CHECK(waitUntilNextRun(scheduler, nullptr) == -1);
+  scheduler.add(blinkTask);
+  scheduler.add(sensorTask);
+  CHECK(waitUntilNextRun(scheduler, nullptr) == 0);  // Added tasks are due at once
+  scheduler.run();
+  CHECK(blinkRuns == 1 && sensorRuns == 1);
+  long wait = waitUntilNextRun(scheduler, nullptr);
+  CHECK(wait >= 199 && wait <= 200);
+
+  delay(100);
+  scheduler.run();
+  CHECK(blinkRuns == 1 && sensorRuns == 1);
+  wait = waitUntilNextRun(scheduler, nullptr);
+  CHECK(wait >= 99 && wait <= 100);
+  delay(100);
+  scheduler.run();
+  CHECK(blinkRuns == 1 && sensorRuns == 2);
+  wait = waitUntilNextRun(scheduler, nullptr);
+  CHECK(wait >= 199 && wait <= 200);
+  delay(300);
+  scheduler.run();
+  CHECK(blinkRuns == 2 && sensorRuns == 3);
+
+  // Late run isn't followed by runs catching up with the missed ones
+  delay(1000);
+  scheduler.run();
+  scheduler.run();
+  CHECK(blinkRuns == 3 && sensorRuns == 4);
+
+  scheduler.remove(sensorTask);
+  wait = waitUntilNextRun(scheduler, nullptr);
+  CHECK(wait >= 499 && wait <= 500);
+  scheduler.clear();
+  CHECK(waitUntilNextRun(scheduler, nullptr) == -1);
+}
+
+static void checkPages() {
+  printf("tasks of menu pages\n");
+  GEMPage menuPageMain("Main Menu");
+  GEMPage menuPageSensor("Sensor");
+  GEMScheduler scheduler;
+  GEMTask blinkTask = {blink, 500, 0, nullptr, 0, 0, 0, nullptr};
+  GEMTask sensorTask = {sensor, 100, 0, &menuPageSensor, 0, 0, 0, nullptr};
+  blinkRuns = 0;
+  sensorRuns = 0;
+  scheduler.add(blinkTask);
+  scheduler.add(sensorTask);
+  scheduler.run(&menuPageMain);
+  CHECK(blinkRuns == 1 && sensorRuns == 0);
+  // Task of the other page doesn't bring the deadline closer
+  long wait = waitUntilNextRun(scheduler, &menuPageMain);
+  CHECK(wait >= 499 && wait <= 500);
+  CHECK(waitUntilNextRun(scheduler, &menuPageSensor) == 0);
+  scheduler.run(&menuPageSensor);
+  CHECK(blinkRuns == 1 && sensorRuns == 1);
+  wait = waitUntilNextRun(scheduler, &menuPageSensor);
+  CHECK(wait >= 99 && wait <= 100);
+}
+
+static void checkBudgets() {
+  printf("budgets and overruns\n");
+  GEMScheduler scheduler;
+  GEMTask slowTask = {slow, 10, 100, nullptr, 0, 0, 0, nullptr};
+  GEMTask blinkTask = {blink, 10, 1000, nullptr, 0, 0, 0, nullptr};
+  scheduler.setOverrunCallback(onOverrun);
+  scheduler.add(blinkTask);
+  scheduler.add(slowTask);  // Runs first, as the latest task added
+  blinkRuns = 0;
+  scheduler.run();
+  CHECK(slowRuns == 1 && blinkRuns == 1);
+  CHECK(slowTask.duration >= 500);
+  CHECK(slowTask.overruns == 1 && blinkTask.overruns == 0);
+  CHECK(scheduler.getOverruns() == 1);
+  CHECK(overrunCalls == 1);
+
+  // Tasks due after the tick budget is spent wait for the next call, which starts from them
+  scheduler.setTickBudget(200);
+  delay(10);
+  scheduler.run();
+  CHECK(slowRuns == 2 && blinkRuns == 1);
+  CHECK(waitUntilNextRun(scheduler, nullptr) == 0);
+  scheduler.run();
+  CHECK(slowRuns == 2 && blinkRuns == 2);
+  CHECK(scheduler.getOverruns() == 2);
+}
+
+int main() {
+  checkDeadlines();
+  checkPages();
+  checkBudgets();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
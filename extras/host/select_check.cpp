@@ -0,0 +1,161 @@
+// Check of option selects calculated from the range, generated for enum type and produced by the provider: count, labels
+// and index of the options, and stored values of the menu items linked to them (values with no matching option are rejected,
+// leaving variable intact). Options are inspected through the implementation of each kind (GEMSelectOptions), as GEM does.
+
+#include <Arduino.h>
+#include <limits.h>
+#include "GEMItem.h"
+#include "GEMSelect.h"
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+typedef GEMSelectOptions<SelectOptionRangeInt> RangeInt;
+typedef GEMSelectOptions<SelectOptionRangeByte> RangeByte;
+typedef GEMSelectOptions<SelectOptionProvider> Provider;
+
+// Write value to the menu item in its stored form
+template <typename T>
+static bool writeValue(GEMItem& menuItem, T value) {
+  return menuItem.getValueSize() == sizeof(T) && menuItem.writeValue((const byte*)&value);
+}
+
+static void formatPercent(int value, char* buffer) {
+  sprintf(buffer, "%d%%", value);
+}
+
+static void checkRange() {
+  printf("range selects\n");
+  SelectOptionRangeInt stepRange = {-10, 10, 3, nullptr};  // -10, -7, ..., 8 (max is not reachable with the step)
+  GEMSelect stepSelect(stepRange);
+  CHECK(RangeInt::getLength(&stepSelect) == 7);
+  int value = 8;
+  CHECK(RangeInt::getSelectedOptionNum(&stepSelect, &value) == 6);
+  value = 10;
+  CHECK(RangeInt::getSelectedOptionNum(&stepSelect, &value) == -1);
+  value = -9;
+  CHECK(RangeInt::getSelectedOptionNum(&stepSelect, &value) == -1);  // Between the options
+  CHECK(strcmp(RangeInt::getOptionNameByIndex(&stepSelect, 1), "-7") == 0);
+
+  int step = 2;
+  GEMItem menuItemStep("Step:", step, stepSelect);
+  CHECK(!writeValue(menuItemStep, 0));
+  CHECK(step == 2);
+  CHECK(writeValue(menuItemStep, -4));
+  CHECK(step == -4);
+
+  // Count of the options of the whole range of int doesn't overflow int: options past INT_MAX are left out
+  SelectOptionRangeInt wholeRange = {INT_MIN, INT_MAX, 1, nullptr};
+  GEMSelect wholeSelect(wholeRange);
+  CHECK(RangeInt::getLength(&wholeSelect) == INT_MAX);
+  value = INT_MIN + 5;
+  CHECK(RangeInt::getSelectedOptionNum(&wholeSelect, &value) == 5);
+  value = INT_MAX;
+  CHECK(RangeInt::getSelectedOptionNum(&wholeSelect, &value) == -1);
+  CHECK(strcmp(RangeInt::getOptionNameByIndex(&wholeSelect, INT_MAX - 1), "-2") == 0);
+
+  SelectOptionRangeInt emptyRange = {10, 0, 1, nullptr};
+  GEMSelect emptySelect(emptyRange);
+  CHECK(RangeInt::getLength(&emptySelect) == 0);
+  SelectOptionRangeInt zeroStepRange = {0, 10, 0, nullptr};
+  GEMSelect zeroStepSelect(zeroStepRange);
+  CHECK(RangeInt::getLength(&zeroStepSelect) == 0);
+
+  SelectOptionRangeByte percentRange = {0, 255, 5, formatPercent};
+  GEMSelect percentSelect(percentRange);
+  CHECK(RangeByte::getLength(&percentSelect) == 52);
+  CHECK(strcmp(RangeByte::getOptionNameByIndex(&percentSelect, 51), "255%") == 0);
+  byte percent = 50;
+  GEMItem menuItemPercent("Level:", percent, percentSelect);
+  CHECK(!writeValue(menuItemPercent, (byte)52));
+  CHECK(writeValue(menuItemPercent, (byte)255));
+  CHECK(percent == 255);
+}
+
+enum Mode : byte { ModeOff, ModeAuto, ModeManual = 5 };
+const char modeNames[] PROGMEM = "Off\0Auto\0Manual";
+
+static void checkEnum() {
+  printf("enum selects\n");
+  typedef GEMSelectEnum<Mode, ModeOff, ModeAuto, ModeManual> ModeSelect;
+  typedef GEMSelectOptions<ModeSelect> ModeOptions;
+  ModeSelect modeSelect(modeNames);
+  CHECK(ModeOptions::getLength(&modeSelect) == 3);
+  CHECK(strcmp(ModeOptions::getOptionNameByIndex(&modeSelect, 2), "Manual") == 0);
+  Mode mode = ModeManual;
+  CHECK(ModeOptions::getSelectedOptionNum(&modeSelect, &mode) == 2);
+  mode = (Mode)3;  // Within the lookup table, but not among the options
+  CHECK(ModeOptions::getSelectedOptionNum(&modeSelect, &mode) == -1);
+  mode = (Mode)200;  // Past the end of the lookup table
+  CHECK(ModeOptions::getSelectedOptionNum(&modeSelect, &mode) == -1);
+
+  mode = ModeAuto;
+  GEMItem menuItemMode("Mode:", mode, modeSelect);
+  CHECK(menuItemMode.getValueSize() == sizeof(Mode));
+  byte data = 0;
+  menuItemMode.readValue(&data);
+  CHECK(data == ModeAuto);
+  CHECK(writeValue(menuItemMode, ModeManual));
+  CHECK(mode == ModeManual);
+  CHECK(!writeValue(menuItemMode, (Mode)4));
+  CHECK(mode == ModeManual);
+}
+
+// Provider of the list of channels that can change at run time
+static const char* channelNames[] = {"Left", "Right", "Center", "Rear"};
+static int channelCount = 3;
+
+static int countChannels() { return channelCount; }
+static const char* nameChannel(int index) { return channelNames[index]; }
+static void applyChannel(void* variable, int index) { *(int*)variable = index * 10; }
+static int indexOfChannel(void* variable) {
+  int index = *(int*)variable / 10;
+  return (*(int*)variable % 10 == 0 && index >= 0 && index < channelCount) ? index : -1;
+}
+
+static void checkProvider() {
+  printf("provider selects\n");
+  SelectOptionProvider channelProvider = {countChannels, nameChannel, applyChannel, indexOfChannel};
+  GEMSelect channelSelect(channelProvider);
+  int channel = 10;
+  CHECK(Provider::getLength(&channelSelect) == 3);
+  CHECK(Provider::getSelectedOptionNum(&channelSelect, &channel) == 1);
+  channelCount = 4;
+  CHECK(Provider::getLength(&channelSelect) == 4);  // Number of options is queried each time
+
+  // Value is stored as the label of the option, so that it restores the same option regardless of its index
+  GEMItem menuItemChannel("Channel:", channel, channelSelect);
+  CHECK(menuItemChannel.getValueSize() == GEM_STR_LEN);
+  byte data[GEM_STR_LEN];
+  memset(data, 0xFF, sizeof(data));
+  menuItemChannel.readValue(data);
+  CHECK(strcmp((char*)data, "Right") == 0);
+  strcpy((char*)data, "Rear");
+  CHECK(menuItemChannel.writeValue(data));
+  CHECK(channel == 30);
+  strcpy((char*)data, "Front");
+  CHECK(!menuItemChannel.writeValue(data));
+  CHECK(channel == 30);
+  channelCount = 3;
+  strcpy((char*)data, "Rear");
+  CHECK(!menuItemChannel.writeValue(data));  // Option is no longer available
+}
+
+int main() {
+  checkRange();
+  checkEnum();
+  checkProvider();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,367 @@
+// Check of GEMSnapshot and GEMRemote against stream in RAM: values of the menu (including child pages) are saved and restored,
+// damaged or truncated snapshot is never applied, and values that don't fit the buffer (long strings) are skipped and reported. Frames of the remote control protocol are fed byte by byte, split, damaged and left incomplete, and responses
+// are checked along with the values written.
+
+#include <Arduino.h>
+#include <vector>
+#include "GEMSnapshot.h"
+#include "GEMRemote.h"
+#include "GEMPersist.h"
+#include "GEMSelect.h"
+
+static int failures = 0;
+
+#define CHECK(condition) check(condition, #condition, __LINE__)
+
+static void check(bool condition, const char* text, int line) {
+  if (!condition) {
+    printf("  FAIL (line %d): %s\n", line, text);
+    failures++;
+  }
+}
+
+// Stream that reads from the input buffer and writes to the output one
+class MemoryStream : public Stream {
+  public:
+    std::vector<byte> input;
+    std::vector<byte> output;
+    size_t write(uint8_t c) { output.push_back(c); return 1; }
+    int available() { return input.size() - _position; }
+    int read() { return (_position < input.size()) ? input[_position++] : -1; }
+    int peek() { return (_position < input.size()) ? input[_position] : -1; }
+    void feed(const std::vector<byte>& data) { input.insert(input.end(), data.begin(), data.end()); }
+  private:
+    size_t _position = 0;
+};
+
+static int number = 512;
+static char label[GEM_STR_LEN] = "Sample";
+static char notes[48] = "Long notes";
+static bool enabled = false;
+static byte tempo = 5;
+static int level = 3;
+static int serial = 1234;
+
+static SelectOptionRangeByte tempoRange = {1, 10, 1, nullptr};
+static GEMSelect tempoSelect(tempoRange);
+
+static GEMItem menuItemNumber("Number:", number);
+static GEMItem menuItemLabel("Label:", label);
+static GEMItem menuItemNotes("Notes:", StringBuffer{notes, sizeof(notes)});
+static GEMItem menuItemEnabled("Enabled:", enabled);
+static GEMItem menuItemTempo("Tempo:", tempo, tempoSelect);
+static GEMItem menuItemSerial("Serial:", serial, GEM_READONLY);
+static GEMPage menuPageMain("Main Menu");
+static GEMPage menuPageSettings("Settings");
+static GEMItem menuItemSettings("Settings", menuPageSettings);
+static GEMItem menuItemLevel("Level:", level);
+
+static void setValues(int number_, const char* label_, const char* notes_, bool enabled_, byte tempo_, int level_) {
+  number = number_;
+  strcpy(label, label_);
+  strcpy(notes, notes_);
+  enabled = enabled_;
+  tempo = tempo_;
+  level = level_;
+}
+
+static bool hasValues(int number_, const char* label_, const char* notes_, bool enabled_, byte tempo_, int level_) {
+  return number == number_ && strcmp(label, label_) == 0 && strcmp(notes, notes_) == 0 && enabled == enabled_ && tempo == tempo_ && level == level_;
+}
+
+// Offset of the entry of the menu item in the snapshot (entries follow the order of the menu)
+static size_t entryOffset(GEMItem& menuItem) {
+  GEMItem* menuItems[] = {&menuItemNumber, &menuItemLabel, &menuItemNotes, &menuItemEnabled, &menuItemTempo, &menuItemSerial, &menuItemLevel};
+  size_t offset = 3;
+  for (GEMItem* entry : menuItems) {
+    if (entry == &menuItem) {
+      break;
+    }
+    offset += 5 + entry->getValueSize();
+  }
+  return offset;
+}
+
+static byte restore(const std::vector<byte>& snapshot, unsigned int& applied) {
+  MemoryStream in;
+  in.feed(snapshot);
+  return GEMSnapshot::restore(menuPageMain, in, applied);
+}
+
+// Replace CRC of the whole snapshot with the one matching its (altered) content
+static void updateCrc(std::vector<byte>& snapshot) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < snapshot.size() - 2; i++) {
+    crc = GEMCrc16(crc, snapshot[i]);
+  }
+  snapshot[snapshot.size() - 2] = crc & 0xFF;
+  snapshot[snapshot.size() - 1] = crc >> 8;
+}
+
+static void checkSnapshot() {
+  printf("snapshot round trip\n");
+  setValues(1024, "Changed", "Notes that are longer than the buffer", true, 7, 9);
+  MemoryStream out;
+  CHECK(GEMSnapshot::save(menuPageMain, out) == 7);
+  std::vector<byte> snapshot = out.output;
+  CHECK(snapshot.size() == entryOffset(menuItemLevel) + 5 + sizeof(int) + 3);
+
+  unsigned int applied;
+  setValues(0, "", "Kept", false, 1, 0);
+  CHECK(restore(snapshot, applied) == GEM_SNAPSHOT_PARTIAL);
+  CHECK(applied == 6);  // Long string doesn't fit the buffer and is skipped, values after it are still applied
+  CHECK(hasValues(1024, "Changed", "Kept", true, 7, 9));
+
+  // Buffer supplied by the sketch holds long string as well
+  byte buffer[128];
+  MemoryStream in;
+  in.feed(snapshot);
+  setValues(0, "", "Kept", false, 1, 0);
+  CHECK(GEMSnapshot::restore(menuPageMain, in, buffer, sizeof(buffer), applied) == GEM_SNAPSHOT_OK);
+  CHECK(applied == 7);
+  CHECK(hasValues(1024, "Changed", "Notes that are longer than the buffer", true, 7, 9));
+
+  printf("damaged snapshot\n");
+  // Nothing is applied unless the whole snapshot is verified, including entries preceding the damaged one
+  std::vector<byte> damaged = snapshot;
+  damaged[entryOffset(menuItemTempo) + 3] ^= 0x02;  // Still valid option
+  setValues(0, "", "Kept", false, 1, 0);
+  CHECK(restore(damaged, applied) == GEM_SNAPSHOT_CORRUPT);
+  CHECK(applied == 0);
+  CHECK(hasValues(0, "", "Kept", false, 1, 0));
+
+  // Damaged size of the entry throws reading off, which is caught by CRC of the entry
+  damaged = snapshot;
+  damaged[entryOffset(menuItemTempo) + 2] = 0;
+  CHECK(restore(damaged, applied) == GEM_SNAPSHOT_CORRUPT);
+  CHECK(hasValues(0, "", "Kept", false, 1, 0));
+
+  // Truncated snapshot
+  std::vector<byte> truncated(snapshot.begin(), snapshot.begin() + entryOffset(menuItemLevel) + 4);
+  CHECK(restore(truncated, applied) == GEM_SNAPSHOT_CORRUPT);
+  truncated.assign(snapshot.begin(), snapshot.end() - 1);
+  CHECK(restore(truncated, applied) == GEM_SNAPSHOT_CORRUPT);
+  CHECK(hasValues(0, "", "Kept", false, 1, 0));
+
+  // Damaged CRC of the whole snapshot (with valid CRC of each entry)
+  damaged = snapshot;
+  damaged.back() ^= 0xFF;
+  CHECK(restore(damaged, applied) == GEM_SNAPSHOT_CORRUPT);
+  CHECK(applied == 0);
+  CHECK(hasValues(0, "", "Kept", false, 1, 0));
+
+  // Data that isn't a snapshot is not applied at all
+  damaged = snapshot;
+  damaged[2] = GEM_SNAPSHOT_VERSION + 1;
+  setValues(0, "", "Kept", false, 1, 0);
+  CHECK(restore(damaged, applied) == GEM_SNAPSHOT_INVALID);
+  CHECK(applied == 0);
+  CHECK(restore(std::vector<byte>(), applied) == GEM_SNAPSHOT_INVALID);
+  CHECK(hasValues(0, "", "Kept", false, 1, 0));
+
+  // Value with no matching option is skipped (variable is left intact)
+  damaged = snapshot;
+  size_t tempoValue = entryOffset(menuItemTempo) + 3;
+  damaged[tempoValue] = 20;
+  uint16_t crcEntry = 0xFFFF;
+  for (size_t i = entryOffset(menuItemTempo); i <= tempoValue; i++) {
+    crcEntry = GEMCrc16(crcEntry, damaged[i]);
+  }
+  damaged[tempoValue + 1] = crcEntry & 0xFF;
+  damaged[tempoValue + 2] = crcEntry >> 8;
+  setValues(0, "", "Kept", false, 1, 0);
+  CHECK(restore(damaged, applied) == GEM_SNAPSHOT_CORRUPT);  // Only CRC of the whole snapshot doesn't match
+  CHECK(applied == 0);
+  updateCrc(damaged);
+  CHECK(restore(damaged, applied) == GEM_SNAPSHOT_PARTIAL);
+  CHECK(applied == 5);
+  CHECK(hasValues(1024, "Changed", "Kept", true, 1, 9));
+}
+
+// Frame of the remote control protocol
+static std::vector<byte> frame(byte command, std::vector<byte> payload) {
+  std::vector<byte> data = {0xA5, command, (byte)payload.size()};
+  data.insert(data.end(), payload.begin(), payload.end());
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 1; i < data.size(); i++) {
+    crc = GEMCrc16(crc, data[i]);
+  }
+  data.push_back(crc & 0xFF);
+  data.push_back(crc >> 8);
+  return data;
+}
+
+static std::vector<byte> writeFrame(byte id, int value) {
+  std::vector<byte> payload = {id};
+  payload.insert(payload.end(), (byte*)&value, (byte*)&value + sizeof(int));
+  return frame(GEM_REMOTE_WRITE, payload);
+}
+
+// Take the next response from the output of the stream, returns its payload (starting with the status), or empty one if there is
+// no valid response with the supplied command
+static std::vector<byte> response(MemoryStream& stream, byte command) {
+  std::vector<byte>& out = stream.output;
+  if (out.size() < 6 || out[0] != 0xA5 || out[1] != (command | 0x80) || out.size() < (size_t)out[2] + 5) {
+    out.clear();
+    return std::vector<byte>();
+  }
+  size_t length = out[2];
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 1; i < length + 3; i++) {
+    crc = GEMCrc16(crc, out[i]);
+  }
+  bool valid = (out[length + 3] | (out[length + 4] << 8)) == crc;
+  std::vector<byte> payload(out.begin() + 3, out.begin() + 3 + length);
+  out.erase(out.begin(), out.begin() + length + 5);
+  return valid ? payload : std::vector<byte>();
+}
+
+// Status of the next response (or -1 if there is no valid response with the supplied command)
+static int status(MemoryStream& stream, byte command) {
+  std::vector<byte> payload = response(stream, command);
+  return payload.empty() ? -1 : payload[0];
+}
+
+static void checkRemote() {
+  printf("remote frames\n");
+  setValues(512, "Sample", "Notes", false, 5, 3);
+  MemoryStream stream;
+  GEMRemote remote(stream, menuPageMain);
+  CHECK(remote.update() == nullptr);
+
+  // Noise before the start of the frame is ignored
+  stream.feed({0x00, 0x13});
+  stream.feed(frame(GEM_REMOTE_READ, {menuItemNumber.getId()}));
+  CHECK(remote.update() == nullptr);
+  std::vector<byte> payload = response(stream, GEM_REMOTE_READ);
+  CHECK(payload.size() == 4 + sizeof(int) && payload[0] == GEM_REMOTE_OK && payload[1] == menuItemNumber.getId());
+  CHECK(payload.size() == 4 + sizeof(int) && payload[3] == sizeof(int) && memcmp(&payload[4], &number, sizeof(int)) == 0);
+
+  // Written menu item is returned, so that its save action can be run; menu items of child pages are reachable
+  stream.feed(writeFrame(menuItemLevel.getId(), 7));
+  CHECK(remote.update() == &menuItemLevel);
+  CHECK(level == 7);
+  payload = response(stream, GEM_REMOTE_WRITE);
+  CHECK(payload.size() == 2 && payload[0] == GEM_REMOTE_OK && payload[1] == menuItemLevel.getId());
+
+  // Frame split across calls
+  std::vector<byte> split = writeFrame(menuItemNumber.getId(), 100);
+  stream.feed(std::vector<byte>(split.begin(), split.begin() + 4));
+  CHECK(remote.update() == nullptr);
+  CHECK(stream.output.empty());
+  stream.feed(std::vector<byte>(split.begin() + 4, split.end()));
+  CHECK(remote.update() == &menuItemNumber);
+  CHECK(number == 100);
+  CHECK(response(stream, GEM_REMOTE_WRITE).size() == 2);
+
+  printf("rejected requests\n");
+  stream.feed(writeFrame(menuItemSerial.getId(), 1));
+  CHECK(remote.update() == nullptr);
+  CHECK(status(stream, GEM_REMOTE_WRITE) == GEM_REMOTE_READONLY);
+  CHECK(serial == 1234);
+  stream.feed(writeFrame(menuItemNumber.getId(), 200));
+  CHECK(remote.update(&menuItemNumber) == nullptr);
+  CHECK(status(stream, GEM_REMOTE_WRITE) == GEM_REMOTE_BUSY);
+  CHECK(number == 100);
+  stream.feed(writeFrame(99, 1));
+  remote.update();
+  CHECK(status(stream, GEM_REMOTE_WRITE) == GEM_REMOTE_UNKNOWN_ID);
+  stream.feed(frame(GEM_REMOTE_WRITE, {menuItemNumber.getId(), 1}));
+  remote.update();
+  CHECK(status(stream, GEM_REMOTE_WRITE) == GEM_REMOTE_INVALID_VALUE);
+  stream.feed(frame(GEM_REMOTE_WRITE, {menuItemTempo.getId(), 20}));
+  remote.update();
+  CHECK(status(stream, GEM_REMOTE_WRITE) == GEM_REMOTE_INVALID_VALUE);
+  CHECK(tempo == 5);
+  stream.feed(frame(0x10, {}));
+  remote.update();
+  CHECK(status(stream, 0x10) == GEM_REMOTE_UNKNOWN_COMMAND);
+  CHECK(number == 100);
+  CHECK(remote.getErrors() == 0);
+
+  printf("damaged and incomplete frames\n");
+  std::vector<byte> damaged = writeFrame(menuItemNumber.getId(), 300);
+  damaged[4] ^= 0x01;
+  stream.feed(damaged);
+  CHECK(remote.update() == nullptr);
+  CHECK(status(stream, GEM_REMOTE_ERROR) == GEM_REMOTE_BAD_FRAME);
+  CHECK(remote.getErrors() == 1);
+  CHECK(number == 100);
+
+  // Payload that doesn't fit is received up to its end, so that its bytes (even the start byte) aren't taken for the next frame
+  std::vector<byte> inner = writeFrame(menuItemNumber.getId(), 400);
+  std::vector<byte> tooLong(GEM_REMOTE_FRAME_LEN + 10, 0);
+  std::copy(inner.begin(), inner.end(), tooLong.begin() + 10);
+  stream.feed(frame(GEM_REMOTE_WRITE, tooLong));
+  CHECK(remote.update() == nullptr);
+  CHECK(status(stream, GEM_REMOTE_WRITE) == GEM_REMOTE_TOO_LONG);
+  CHECK(stream.output.empty());
+  CHECK(remote.getErrors() == 2);
+  CHECK(number == 100);
+
+  // Value of long string variable can be read, but is longer than the frame can carry when written
+  CHECK(menuItemNotes.getValueSize() > GEM_REMOTE_FRAME_LEN - 1);
+  stream.feed(frame(GEM_REMOTE_READ, {menuItemNotes.getId()}));
+  remote.update();
+  payload = response(stream, GEM_REMOTE_READ);
+  CHECK(payload.size() == 4 + sizeof(notes) && payload[0] == GEM_REMOTE_OK && strcmp((char*)&payload[4], notes) == 0);
+  std::vector<byte> notesPayload = {menuItemNotes.getId()};
+  notesPayload.resize(1 + sizeof(notes), 'x');
+  notesPayload.back() = 0;
+  stream.feed(frame(GEM_REMOTE_WRITE, notesPayload));
+  CHECK(remote.update() == nullptr);
+  payload = response(stream, GEM_REMOTE_WRITE);
+  CHECK(payload.size() == 2 && payload[0] == GEM_REMOTE_TOO_LONG && payload[1] == menuItemNotes.getId());
+  CHECK(strcmp(notes, "Notes") == 0);
+  CHECK(remote.getErrors() == 3);
+
+  // Frame left incomplete for longer than the timeout is dropped, next one is processed
+  std::vector<byte> incomplete = writeFrame(menuItemNumber.getId(), 500);
+  stream.feed(std::vector<byte>(incomplete.begin(), incomplete.begin() + 5));
+  remote.update();
+  delay(GEM_REMOTE_TIMEOUT + 10);
+  stream.feed(writeFrame(menuItemNumber.getId(), 600));
+  CHECK(remote.update() == &menuItemNumber);
+  CHECK(remote.getErrors() == 4);
+  CHECK(number == 600);
+  CHECK(response(stream, GEM_REMOTE_WRITE).size() == 2);
+
+  printf("list of menu items\n");
+  stream.feed(frame(GEM_REMOTE_LIST, {}));
+  remote.update();
+  unsigned int listed = 0;
+  bool readonlyFlagged = false;
+  for (payload = response(stream, GEM_REMOTE_LIST); payload.size() > 1; payload = response(stream, GEM_REMOTE_LIST)) {
+    listed++;
+    if (payload[1] == menuItemSerial.getId()) {
+      readonlyFlagged = payload[4] == 0x01 && memcmp(&payload[5], "Serial:", 7) == 0;
+    }
+  }
+  CHECK(listed == 7);
+  CHECK(readonlyFlagged);
+  CHECK(payload.size() == 1 && payload[0] == GEM_REMOTE_OK);
+}
+
+int main() {
+  menuPageMain.addMenuItem(menuItemNumber);
+  menuPageMain.addMenuItem(menuItemLabel);
+  menuPageMain.addMenuItem(menuItemNotes);
+  menuPageMain.addMenuItem(menuItemEnabled);
+  menuPageMain.addMenuItem(menuItemTempo);
+  menuPageMain.addMenuItem(menuItemSerial);
+  menuPageMain.addMenuItem(menuItemSettings);
+  menuPageSettings.addMenuItem(menuItemLevel);
+  menuPageSettings.setParentMenuPage(menuPageMain);
+  GEMItem* menuItems[] = {&menuItemNumber, &menuItemLabel, &menuItemNotes, &menuItemEnabled, &menuItemTempo, &menuItemSerial, &menuItemLevel};
+  byte id = 1;
+  for (GEMItem* menuItem : menuItems) {
+    menuItem->setId(id++);
+  }
+  checkSnapshot();
+  checkRemote();
+  if (failures > 0) {
+    printf("FAIL: %d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
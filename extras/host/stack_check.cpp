@@ -0,0 +1,116 @@
+// Stack high-water check of drawing and editing: stack area below the caller is painted with a pattern before each
+// operation and scanned after it, failing when the deepest use exceeds the budget. Note that frames on the host are
+// larger than on the target MCU (e.g. pointers are 8 bytes wide instead of 2 on AVR, and float formatting goes through
+// host libc), so the budget is set for the host build.
+// Budget can be overridden: make -C extras/host check STACK_BUDGET=4096
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <GEM_u8g2.h>
+
+#ifndef STACK_BUDGET
+#define STACK_BUDGET 4096
+#endif
+
+#define STACK_PAINT_LEN 16384
+#define STACK_PAINT_BYTE 0xA5
+
+// Reading of the painted area left by the previous call is intended
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wunused-but-set-variable"
+
+// Both functions are called from the same frame as the operation, so their areas cover the stack used by it
+__attribute__((noinline)) static void paintStack() {
+  volatile uint8_t area[STACK_PAINT_LEN];
+  for (size_t i = 0; i < STACK_PAINT_LEN; i++) {
+    area[i] = STACK_PAINT_BYTE;
+  }
+}
+
+__attribute__((noinline)) static size_t scanStack() {
+  volatile uint8_t area[STACK_PAINT_LEN];
+  size_t i = 0;
+  while (i < STACK_PAINT_LEN && area[i] == STACK_PAINT_BYTE) {
+    i++;
+  }
+  return STACK_PAINT_LEN - i;
+}
+
+int number = 512;
+byte tempo = 5;
+char label[GEM_STR_LEN] = "Sample";
+int16_t voltage = 1250;
+float ratio = 0.5;
+bool enablePrint = false;
+
+SelectOptionInt intervalOptions[] = {{(char*)"Fast", 50}, {(char*)"Normal", 100}, {(char*)"Slow", 500}};
+GEMSelect intervalSelect(sizeof(intervalOptions)/sizeof(SelectOptionInt), intervalOptions);
+int interval = 100;
+FixedPointFormat voltageFormat = {2, " V"};
+
+GEMItem menuItemInt("Number:", number);
+GEMItem menuItemTempo("Tempo:", tempo);
+GEMItem menuItemLabel("Label:", label);
+GEMItem menuItemVoltage("Voltage:", voltage, voltageFormat);
+GEMItem menuItemRatio("Ratio:", ratio);
+GEMItem menuItemBool("Enable print:", enablePrint);
+GEMItem menuItemInterval("Interval:", interval, intervalSelect);
+
+GEMPage menuPageMain("Main Menu");
+U8G2 u8g2;
+GEM_u8g2 menu(u8g2);
+
+static size_t worst = 0;
+
+static void check(const char* name, size_t used) {
+  printf("%-24s %5u bytes\n", name, (unsigned)used);
+  if (used > worst) {
+    worst = used;
+  }
+}
+
+int main() {
+  menuPageMain.addMenuItem(menuItemInt);
+  menuPageMain.addMenuItem(menuItemTempo);
+  menuPageMain.addMenuItem(menuItemLabel);
+  menuPageMain.addMenuItem(menuItemVoltage);
+  menuPageMain.addMenuItem(menuItemRatio);
+  menuPageMain.addMenuItem(menuItemBool);
+  menuPageMain.addMenuItem(menuItemInterval);
+  menu.setMenuPageCurrent(menuPageMain);
+  menu.init();
+
+  paintStack();
+  menu.drawMenu();
+  check("drawMenu()", scanStack());
+
+  paintStack();
+  for (byte i = 0; i < 7; i++) {
+    menu.registerKeyPress(GEM_KEY_DOWN);
+  }
+  check("navigation", scanStack());
+
+  paintStack();
+  menu.registerKeyPress(GEM_KEY_UP);
+  menu.registerKeyPress(GEM_KEY_UP);
+  menu.registerKeyPress(GEM_KEY_UP);
+  menu.registerKeyPress(GEM_KEY_OK);
+  menu.registerKeyPress(GEM_KEY_RIGHT);
+  menu.registerKeyPress(GEM_KEY_UP);
+  menu.registerKeyPress(GEM_KEY_OK);
+  check("fixed-point value edit", scanStack());
+
+  paintStack();
+  menu.registerKeyPress(GEM_KEY_DOWN);
+  menu.registerKeyPress(GEM_KEY_OK);
+  menu.registerKeyPress(GEM_KEY_DOWN);
+  menu.registerKeyPress(GEM_KEY_OK);
+  check("float value edit", scanStack());
+
+  printf("worst:                   %5u bytes (budget %u)\n", (unsigned)worst, (unsigned)STACK_BUDGET);
+  if (worst > STACK_BUDGET) {
+    printf("FAIL: stack use exceeds the budget\n");
+    return 1;
+  }
+  return 0;
+}
@@ -35,13 +35,10 @@
 
 #ifdef GEM_ENABLE_GLCD_VERSION
 
-// AVR-based Arduinos have suppoort for dtostrf, others require manual inclusion,
-// see https://github.com/plotly/arduino-api/issues/38#issuecomment-108987647;
-// the same goes for itoa support on some non-AVR boards
-#ifndef __AVR__
-#include <avr/dtostrf.h>
-#include <itoa.h>
-#endif
+#include "GEMFormat.h"
+#include "GEMProfiler.h"    // Timing hooks of drawMenu(), no-op unless GEM_ENABLE_PROFILER is defined
+#include "GEMBusCounter.h"  // Frame hooks of drawMenu(), no-op unless GEM_ENABLE_BUS_COUNTER is defined
+#include <limits.h>
 
 // Macro constants (aliases) for IDs of sprites of UI elements used to draw menu
 #define GEM_SPR_SELECT_ARROWS 0
@@ -51,15 +48,17 @@
 #define GEM_SPR_CHECKBOX_UNCHECKED 4
 #define GEM_SPR_CHECKBOX_CHECKED 5
 
-// Macro constants (aliases) for some of the ASCII character codes
-#define GEM_CHAR_CODE_9 57
-#define GEM_CHAR_CODE_0 48
-#define GEM_CHAR_CODE_MINUS 45
-#define GEM_CHAR_CODE_DOT 46
-#define GEM_CHAR_CODE_SPACE 32
-#define GEM_CHAR_CODE_UNDERSCORE 95
-#define GEM_CHAR_CODE_LINE 124
-#define GEM_CHAR_CODE_TILDA 126
+// Read character of the string stored either in RAM or in flash memory (PROGMEM), e.g. title set with F() macro
+#define GEM_READ_CHAR(str, index, progmem) ((progmem) ? (char)pgm_read_byte((str) + (index)) : (str)[index])
+
+// Type of the menu pointer drawn, constant if only one type of the pointer is supported (see config.h)
+#if defined(GEM_SUPPORT_POINTER_DASH) && defined(GEM_SUPPORT_POINTER_ROW)
+  #define GEM_MENU_POINTER_TYPE _menuPointerType
+#elif defined(GEM_SUPPORT_POINTER_DASH)
+  #define GEM_MENU_POINTER_TYPE GEM_POINTER_DASH
+#else
+  #define GEM_MENU_POINTER_TYPE GEM_POINTER_ROW
+#endif
 
 // Sprite of the default GEM _splash screen (GEM logo v1)
 /*
@@ -115,9 +114,6 @@ GEM::GEM(GLCD& glcd_, byte menuPointerType_, byte menuItemsPerScreen_, byte menu
   _splash = logo;
   clearContext();
   _editValueMode = false;
-  _editValueCursorPosition = 0;
-  memset(_valueString, '\0', GEM_STR_LEN - 1);
-  _valueSelectNum = -1;
 }
 
 //====================== INIT OPERATIONS
@@ -186,36 +182,62 @@ void GEM::clearContext() {
   context.allowExit = true;
 }
 
+//====================== PROFILING
+
+#ifdef GEM_ENABLE_PROFILER
+void GEM::setProfiler(GEMProfiler& profiler) {
+  _profiler = &profiler;
+}
+#endif
+
+//====================== BUS TRAFFIC
+
+#ifdef GEM_ENABLE_BUS_COUNTER
+void GEM::setBusCounter(GEMBusCounter& counter) {
+  _busCounter = &counter;
+  _glcd.setCounter(&counter);
+}
+#endif
+
 //====================== DRAW OPERATIONS
 
 void GEM::drawMenu() {
-  _glcd.clearScreen();
-  drawTitleBar();
-  printMenuItems();
-  drawMenuPointer();
-  drawScrollbar();
+  GEM_PROFILE_FRAME_BEGIN(_profiler);
+  GEM_BUS_FRAME_BEGIN(_busCounter);
+  GEM_PROFILE_PHASE(_profiler, GEM_PHASE_CLEAR, _glcd.clearScreen());
+  GEM_PROFILE_PHASE(_profiler, GEM_PHASE_TITLE, drawTitleBar());
+  GEM_PROFILE_PHASE(_profiler, GEM_PHASE_ITEMS, printMenuItems());
+  GEM_PROFILE_PHASE(_profiler, GEM_PHASE_POINTER, drawMenuPointer());
+  GEM_PROFILE_PHASE(_profiler, GEM_PHASE_SCROLLBAR, drawScrollbar());
+  GEM_BUS_FRAME_END(_busCounter);
+  GEM_PROFILE_FRAME_END(_profiler);
 }
 
 void GEM::drawTitleBar() {
   _glcd.fontFace(1);
   _glcd.setXY(5,1);
-  _glcd.putstr(_menuPageCurrent->title);
+  if (_menuPageCurrent->titleProgmem) {
+    printMenuItemString(_menuPageCurrent->title, UCHAR_MAX, 0, true);
+  } else {
+    _glcd.putstr(_menuPageCurrent->title);
+  }
   _glcd.fontFace(_menuItemFontSize);
 }
 
-void GEM::printMenuItemString(char* str, byte num, byte startPos) {
+void GEM::printMenuItemString(const char* str, byte num, byte startPos, bool progmem) {
   byte i = startPos;
-  while (i < num + startPos && str[i] != '\0') {
-    _glcd.put(str[i]);
+  char c;
+  while (i < num + startPos && (c = GEM_READ_CHAR(str, i, progmem)) != '\0') {
+    _glcd.put(c);
     i++;
   }
 }
 
-void GEM::printMenuItemTitle(char* str, int offset) {
-  printMenuItemString(str, _menuItemTitleLength + offset);
+void GEM::printMenuItemTitle(const char* str, int offset, bool progmem) {
+  printMenuItemString(str, _menuItemTitleLength + offset, 0, progmem);
 }
 
-void GEM::printMenuItemValue(char* str, int offset, byte startPos) {
+void GEM::printMenuItemValue(const char* str, int offset, byte startPos) {
   printMenuItemString(str, _menuItemValueLength + offset, startPos);
 }
 
@@ -229,16 +251,26 @@ void GEM::printMenuItemValue(GEMItem* menuItemTmp, byte yDraw){
   // print item value on screen - print conversion dependent on tpye
   switch (menuItemTmp->linkedType) {
     case GEM_VAL_INTEGER:
-      itoa(*(int*)menuItemTmp->linkedVariable, _valueString, 10);
-      printMenuItemValue(_valueString);
+      GEMFormatInt(*(int*)menuItemTmp->linkedVariable, _formatBuffer);
+      printMenuItemValue(_formatBuffer);
       break;
     case GEM_VAL_BYTE:
-      itoa(*(byte*)menuItemTmp->linkedVariable, _valueString, 10);
-      printMenuItemValue(_valueString);
+      GEMFormatInt(*(byte*)menuItemTmp->linkedVariable, _formatBuffer);
+      printMenuItemValue(_formatBuffer);
       break;
     case GEM_VAL_CHAR:
-      printMenuItemValue((char*)menuItemTmp->linkedVariable);
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    case GEM_VAL_STRING:
+    #endif
+      printMenuItemValue((const char*)menuItemTmp->linkedVariable);
+      break;
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+    case GEM_VAL_FIXED32:
+      GEMEdit::formatFixed(menuItemTmp, _formatBuffer, true);
+      printMenuItemValue(_formatBuffer);
       break;
+    #endif
     case GEM_VAL_BOOL:
       if (*(bool*)menuItemTmp->linkedVariable) {
         _glcd.drawSprite(_menuValuesLeftOffset, yDraw, GEM_SPR_CHECKBOX_CHECKED, GLCD_MODE_NORMAL);
@@ -246,6 +278,7 @@ void GEM::printMenuItemValue(GEMItem* menuItemTmp, byte yDraw){
         _glcd.drawSprite(_menuValuesLeftOffset, yDraw, GEM_SPR_CHECKBOX_UNCHECKED, GLCD_MODE_NORMAL);
       }
       break;
+    #ifdef GEM_SUPPORT_SELECT
     case GEM_VAL_SELECT:
       {
         GEMSelect* select = menuItemTmp->select;
@@ -253,25 +286,22 @@ void GEM::printMenuItemValue(GEMItem* menuItemTmp, byte yDraw){
         _glcd.drawSprite(_glcd.xdim-7, yDraw, GEM_SPR_SELECT_ARROWS, GLCD_MODE_NORMAL);
       }
       break;
+    #endif
     #ifdef GEM_SUPPORT_FLOAT_EDIT
     case GEM_VAL_FLOAT:
-      // sprintf(_valueString,"%.6f", *(float*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-      dtostrf(*(float*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, _valueString);
-      printMenuItemValue(_valueString);
+      GEMFormatFloat(*(float*)menuItemTmp->linkedVariable, menuItemTmp->precision, _formatBuffer, sizeof(_formatBuffer));
+      printMenuItemValue(_formatBuffer);
       break;
     case GEM_VAL_DOUBLE:
-      // sprintf(_valueString,"%.6f", *(double*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-      dtostrf(*(double*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, _valueString);
-      printMenuItemValue(_valueString);
+      GEMFormatFloat(*(double*)menuItemTmp->linkedVariable, menuItemTmp->precision, _formatBuffer, sizeof(_formatBuffer));
+      printMenuItemValue(_formatBuffer);
       break;
     #endif
   }
-  // ensure srting termination
-  memset(_valueString, '\0', GEM_STR_LEN - 1);
 }
 
-void GEM::printMenuItemFull(char* str, int offset) {
-  printMenuItemString(str, _menuItemTitleLength + _menuItemValueLength + offset);
+void GEM::printMenuItemFull(const char* str, int offset, bool progmem) {
+  printMenuItemString(str, _menuItemTitleLength + _menuItemValueLength + offset, 0, progmem);
 }
 
 byte GEM::getMenuItemInsetOffset(bool forSprite) {
@@ -288,6 +318,7 @@ void GEM::printMenuItems() {
   byte y = _menuPageScreenTopOffset;
   byte i = 0;
   while (menuItemTmp != 0 && i < _menuItemsPerScreen) {
+    GEM_PROFILE_ITEM_BEGIN();
     _glcd.setY(y + getMenuItemInsetOffset());
     byte yDraw = y + getMenuItemInsetOffset(true);
     switch (menuItemTmp->type) {
@@ -295,23 +326,22 @@ void GEM::printMenuItems() {
         // print item title with edit symbol, if edit is enabled
         _glcd.setX(5);
         if (menuItemTmp->readonly) {
-          printMenuItemTitle(menuItemTmp->title, -1);
+          printMenuItemTitle(menuItemTmp->title, -1, menuItemTmp->titleProgmem);
           _glcd.putstr("^");
         } else {
-          printMenuItemTitle(menuItemTmp->title);
+          printMenuItemTitle(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
         }
         // print item value
         _glcd.setX(_menuValuesLeftOffset);
         printMenuItemValue(menuItemTmp, yDraw);
-        }
         break;
       case GEM_ITEM_LINK:
         _glcd.setX(5);
         if (menuItemTmp->readonly) {
-          printMenuItemFull(menuItemTmp->title, -1);
+          printMenuItemFull(menuItemTmp->title, -1, menuItemTmp->titleProgmem);
           _glcd.putstr("^");
         } else {
-          printMenuItemFull(menuItemTmp->title);
+          printMenuItemFull(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
         }
         _glcd.drawSprite(_glcd.xdim-8, yDraw, GEM_SPR_ARROW_RIGHT, GLCD_MODE_NORMAL);
         break;
@@ -319,20 +349,23 @@ void GEM::printMenuItems() {
         _glcd.setX(11);
         _glcd.drawSprite(5, yDraw, GEM_SPR_ARROW_LEFT, GLCD_MODE_NORMAL);
         break;
+      #ifdef GEM_SUPPORT_BUTTON
       case GEM_ITEM_BUTTON:
         _glcd.setX(11);
         if (menuItemTmp->readonly) {
-          printMenuItemFull(menuItemTmp->title, -1);
+          printMenuItemFull(menuItemTmp->title, -1, menuItemTmp->titleProgmem);
           _glcd.putstr("^");
         } else {
-          printMenuItemFull(menuItemTmp->title);
+          printMenuItemFull(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
         }
         _glcd.drawSprite(5, yDraw, GEM_SPR_ARROW_BTN, GLCD_MODE_NORMAL);
         break;
+      #endif
+      #ifdef GEM_SUPPORT_LINKED_VALUE
       case GEM_ITEM_LINKED_VAL:
         _glcd.setX(5);
         // print title
-        printMenuItemTitle(menuItemTmp->title);
+        printMenuItemTitle(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
 
         // print value
         _glcd.setX(_menuValuesLeftOffset);
@@ -341,8 +374,10 @@ void GEM::printMenuItems() {
         // draw link arrow
         _glcd.drawSprite(_glcd.xdim-8, yDraw, GEM_SPR_ARROW_RIGHT, GLCD_MODE_NORMAL);
         break;
+      #endif
 
     }
+    GEM_PROFILE_ITEM_END(_profiler, menuItemTmp);
     menuItemTmp = menuItemTmp->getMenuItemNext();
     y += _menuItemHeight;
     i++;
@@ -353,7 +388,7 @@ void GEM::drawMenuPointer() {
   if (_menuPageCurrent->itemsCount > 0) {
     GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
     int pointerPosition = getCurrentItemTopOffset(false);
-    if (_menuPointerType == GEM_POINTER_DASH) {
+    if (GEM_MENU_POINTER_TYPE == GEM_POINTER_DASH) {
       _glcd.eraseBox(0, _menuPageScreenTopOffset, 1, _glcd.ydim-1);
       if (menuItemTmp->readonly) {
         for (byte i = 0; i < (_menuItemHeight - 1) / 2; i++) {
@@ -389,16 +424,19 @@ void GEM::drawScrollbar() {
 
 //====================== MENU ITEMS NAVIGATION
 
-void GEM::nextMenuItem() {
-  if (_menuPointerType != GEM_POINTER_DASH) {
+void GEM::nextMenuItem(byte steps) {
+  if (GEM_MENU_POINTER_TYPE != GEM_POINTER_DASH) {
     drawMenuPointer();
   }
-  if (_menuPageCurrent->currentItemNum == _menuPageCurrent->itemsCount-1) {
-    _menuPageCurrent->currentItemNum = 0;
-  } else {
-    _menuPageCurrent->currentItemNum++;
+  byte screenPrev = _menuPageCurrent->currentItemNum / _menuItemsPerScreen;
+  for (; steps > 0; steps--) {
+    if (_menuPageCurrent->currentItemNum == _menuPageCurrent->itemsCount-1) {
+      _menuPageCurrent->currentItemNum = 0;
+    } else {
+      _menuPageCurrent->currentItemNum++;
+    }
   }
-  bool redrawMenu = (_menuPageCurrent->itemsCount > 1 && _menuPageCurrent->currentItemNum % _menuItemsPerScreen == 0);
+  bool redrawMenu = (_menuPageCurrent->itemsCount > 1 && _menuPageCurrent->currentItemNum / _menuItemsPerScreen != screenPrev);
   if (redrawMenu) {
     drawMenu();
   } else {
@@ -406,16 +444,19 @@ void GEM::nextMenuItem() {
   }
 }
 
-void GEM::prevMenuItem() {
-  if (_menuPointerType != GEM_POINTER_DASH) {
+void GEM::prevMenuItem(byte steps) {
+  if (GEM_MENU_POINTER_TYPE != GEM_POINTER_DASH) {
     drawMenuPointer();
   }
-  bool redrawMenu = (_menuPageCurrent->itemsCount > 1 && _menuPageCurrent->currentItemNum % _menuItemsPerScreen == 0);
-  if (_menuPageCurrent->currentItemNum == 0) {
-    _menuPageCurrent->currentItemNum = _menuPageCurrent->itemsCount-1;
-  } else {
-    _menuPageCurrent->currentItemNum--;
+  byte screenPrev = _menuPageCurrent->currentItemNum / _menuItemsPerScreen;
+  for (; steps > 0; steps--) {
+    if (_menuPageCurrent->currentItemNum == 0) {
+      _menuPageCurrent->currentItemNum = _menuPageCurrent->itemsCount-1;
+    } else {
+      _menuPageCurrent->currentItemNum--;
+    }
   }
+  bool redrawMenu = (_menuPageCurrent->itemsCount > 1 && _menuPageCurrent->currentItemNum / _menuItemsPerScreen != screenPrev);
   if (redrawMenu) {
     drawMenu();
   } else {
@@ -442,17 +483,21 @@ void GEM::menuItemSelect() {
       _menuPageCurrent = menuItemTmp->linkedPage;
       drawMenu();
       break;
+    #ifdef GEM_SUPPORT_BUTTON
     case GEM_ITEM_BUTTON:
       if (!menuItemTmp->readonly) {
         menuItemTmp->buttonAction();
       }
       break;
-    case GEM_ITEM_LINK:
+    #endif
+    #ifdef GEM_SUPPORT_LINKED_VALUE
+    case GEM_ITEM_LINKED_VAL:
       if (menuItemTmp->linkedPage != NULL) {
         _menuPageCurrent = menuItemTmp->linkedPage;
         drawMenu();
       }
       break;
+    #endif
   }
 }
 
@@ -462,50 +507,14 @@ void GEM::enterEditValueMode() {
   _editValueMode = true;
   
   GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  if (_menuPointerType != GEM_POINTER_DASH) {
+  if (GEM_MENU_POINTER_TYPE != GEM_POINTER_DASH) {
     drawMenuPointer();
   }
-  _editValueType = menuItemTmp->linkedType;
-  switch (_editValueType) {
-    case GEM_VAL_INTEGER:
-      itoa(*(int*)menuItemTmp->linkedVariable, _valueString, 10);
-      _editValueLength = 6;
-      initEditValueCursor();
-      break;
-    case GEM_VAL_BYTE:
-      itoa(*(byte*)menuItemTmp->linkedVariable, _valueString, 10);
-      _editValueLength = 3;
-      initEditValueCursor();
-      break;
-    case GEM_VAL_CHAR:
-      strcpy(_valueString, (char*)menuItemTmp->linkedVariable);
-      _editValueLength = GEM_STR_LEN - 1;
-      initEditValueCursor();
-      break;
-    case GEM_VAL_BOOL:
-      checkboxToggle();
-      break;
-    case GEM_VAL_SELECT:
-      {
-        GEMSelect* select = menuItemTmp->select;
-        _valueSelectNum = select->getSelectedOptionNum(menuItemTmp->linkedVariable);
-        initEditValueCursor();
-      }
-      break;
-    #ifdef GEM_SUPPORT_FLOAT_EDIT
-    case GEM_VAL_FLOAT:
-      // sprintf(_valueString,"%.6f", *(float*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-      dtostrf(*(float*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, _valueString);
-      _editValueLength = GEM_STR_LEN - 1;
-      initEditValueCursor();
-      break;
-    case GEM_VAL_DOUBLE:
-      // sprintf(_valueString,"%.6f", *(double*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-      dtostrf(*(double*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, _valueString);
-      _editValueLength = GEM_STR_LEN - 1;
-      initEditValueCursor();
-      break;
-    #endif
+  _edit.begin(menuItemTmp);
+  if (_edit.type == GEM_VAL_BOOL) {
+    checkboxToggle();
+  } else {
+    drawEditValueCursor();
   }
 }
 
@@ -514,6 +523,7 @@ void GEM::checkboxToggle() {
   int topOffset = getCurrentItemTopOffset(true, true);
   bool checkboxValue = *(bool*)menuItemTmp->linkedVariable;
   *(bool*)menuItemTmp->linkedVariable = !checkboxValue;
+  _runtime.markSaved(menuItemTmp);
   if (menuItemTmp->saveAction != nullptr) {
     menuItemTmp->saveAction();
     exitEditValue();
@@ -523,7 +533,7 @@ void GEM::checkboxToggle() {
     } else {
       _glcd.drawSprite(_menuValuesLeftOffset, topOffset, GEM_SPR_CHECKBOX_UNCHECKED, GLCD_MODE_NORMAL);
     }
-    if (_menuPointerType != GEM_POINTER_DASH) {
+    if (GEM_MENU_POINTER_TYPE != GEM_POINTER_DASH) {
       drawMenuPointer();
     }
     _editValueMode = false;
@@ -538,166 +548,83 @@ void GEM::clearValueVisibleRange() {
   _glcd.setY(getCurrentItemTopOffset());
 }
 
-void GEM::initEditValueCursor() {
-  _editValueCursorPosition = 0;
-  _editValueVirtualCursorPosition = 0;
+void GEM::nextEditValueCursorPosition(byte steps) {
   drawEditValueCursor();
-}
-
-void GEM::nextEditValueCursorPosition() {
-  drawEditValueCursor();
-  if ((_editValueCursorPosition != _menuItemValueLength - 1) && (_editValueCursorPosition != _editValueLength - 1) && (_valueString[_editValueCursorPosition] != '\0')) {
-    _editValueCursorPosition++;
-  }
-  if ((_editValueVirtualCursorPosition != _editValueLength - 1) && (_valueString[_editValueVirtualCursorPosition] != '\0')) {
-    _editValueVirtualCursorPosition++;
-    if (_editValueCursorPosition == _menuItemValueLength - 1) {
-      clearValueVisibleRange();
-      printMenuItemValue(_valueString, 0, _editValueVirtualCursorPosition - _editValueCursorPosition);
-    }
+  byte windowOffsetPrev = _edit.getWindowOffset();
+  _edit.nextCursorPosition(steps, _menuItemValueLength);
+  if (windowOffsetPrev != _edit.getWindowOffset()) {
+    clearValueVisibleRange();
+    printMenuItemValue(_edit.getText());
   }
   drawEditValueCursor();
 }
 
-void GEM::prevEditValueCursorPosition() {
+void GEM::prevEditValueCursorPosition(byte steps) {
   drawEditValueCursor();
-  if (_editValueCursorPosition != 0) {
-    _editValueCursorPosition--;
-  }
-  if (_editValueVirtualCursorPosition != 0) {
-    _editValueVirtualCursorPosition--;
-    if (_editValueCursorPosition == 0) {
-      clearValueVisibleRange();
-      printMenuItemValue(_valueString, 0, _editValueVirtualCursorPosition);
-    }
+  byte windowOffsetPrev = _edit.getWindowOffset();
+  _edit.prevCursorPosition(steps);
+  if (windowOffsetPrev != _edit.getWindowOffset()) {
+    clearValueVisibleRange();
+    printMenuItemValue(_edit.getText());
   }
   drawEditValueCursor();
 }
 
 void GEM::drawEditValueCursor() {
   int pointerPosition = getCurrentItemTopOffset(false);
-  byte cursorLeftOffset = _menuValuesLeftOffset + _editValueCursorPosition * _menuItemFont[_menuItemFontSize].width;
+  byte cursorLeftOffset = _menuValuesLeftOffset + _edit.cursorPosition * _menuItemFont[_menuItemFontSize].width;
   _glcd.drawMode(GLCD_MODE_XOR);
-  if (_editValueType == GEM_VAL_SELECT) {
+  #ifdef GEM_SUPPORT_SELECT
+  if (_edit.type == GEM_VAL_SELECT) {
     _glcd.fillBox(cursorLeftOffset - 1, pointerPosition - 1, _glcd.xdim - 3, pointerPosition + _menuItemHeight - 1);
-  } else {
+  } else
+  #endif
+  {
     _glcd.fillBox(cursorLeftOffset - 1, pointerPosition - 1, cursorLeftOffset + _menuItemFont[_menuItemFontSize].width - 1, pointerPosition + _menuItemHeight - 1);
   }
   _glcd.drawMode(GLCD_MODE_NORMAL);
 }
 
-void GEM::nextEditValueDigit() {
-  char chr = _valueString[_editValueVirtualCursorPosition];
-  byte code = (byte)chr;
-  if (_editValueType == GEM_VAL_CHAR) {
-    switch (code) {
-      case 0:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_TILDA:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_LINE - 1:
-        code = GEM_CHAR_CODE_LINE + 1;
-        break;
-      default:
-        code++;
-        break;
-    }
-  } else {
-    switch (code) {
-      case 0:
-        code = GEM_CHAR_CODE_0;
-        break;
-      case GEM_CHAR_CODE_9:
-        code = (_editValueCursorPosition == 0 && (_editValueType == GEM_VAL_INTEGER || _editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_MINUS:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = (_editValueCursorPosition != 0 && (_editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_DOT : GEM_CHAR_CODE_0;
-        break;
-      case GEM_CHAR_CODE_DOT:
-        code = GEM_CHAR_CODE_0;
-        break;
-      default:
-        code++;
-        break;
-    }
-  }
-  drawEditValueDigit(code);
+void GEM::toggleEditValueError() {
+  // Malformed value is inverted as a whole, in place of the cursor (both drawn in XOR mode, so the second call restores the value)
+  int pointerPosition = getCurrentItemTopOffset(false);
+  _edit.error = !_edit.error;
+  drawEditValueCursor();
+  _glcd.drawMode(GLCD_MODE_XOR);
+  _glcd.fillBox(_menuValuesLeftOffset - 1, pointerPosition - 1, _glcd.xdim - 3, pointerPosition + _menuItemHeight - 1);
+  _glcd.drawMode(GLCD_MODE_NORMAL);
 }
 
-void GEM::prevEditValueDigit() {
-  char chr = _valueString[_editValueVirtualCursorPosition];
-  byte code = (byte)chr;
-  if (_editValueType == GEM_VAL_CHAR) {
-    switch (code) {
-      case 0:
-        code = GEM_CHAR_CODE_TILDA;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = GEM_CHAR_CODE_TILDA;
-        break;
-      case GEM_CHAR_CODE_LINE + 1:
-        code = GEM_CHAR_CODE_LINE - 1;
-        break;
-      default:
-        code--;
-        break;
-    }
-  } else {
-    switch (code) {
-      case 0:
-        code = (_editValueCursorPosition == 0 && (_editValueType == GEM_VAL_INTEGER || _editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_9;
-        break;
-      case GEM_CHAR_CODE_MINUS:
-        code = GEM_CHAR_CODE_9;
-        break;
-      case GEM_CHAR_CODE_0:
-        code = (_editValueCursorPosition != 0 && (_editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_DOT : GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = (_editValueCursorPosition == 0 && (_editValueType == GEM_VAL_INTEGER || _editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_9;
-        break;
-      case GEM_CHAR_CODE_DOT:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      default:
-        code--;
-        break;
-    }
-  }
-  drawEditValueDigit(code);
+void GEM::nextEditValueDigit(byte steps) {
+  drawEditValueDigit(_edit.nextCode(steps));
+}
+
+void GEM::prevEditValueDigit(byte steps) {
+  drawEditValueDigit(_edit.prevCode(steps));
 }
 
 void GEM::drawEditValueDigit(byte code) {
-  char chrNew = (char)code;
-  _valueString[_editValueVirtualCursorPosition] = chrNew;
+  if (!_edit.setCode(code)) {
+    // Change is refused (see GEM_EDIT_JOURNAL_LEN), so value is shown inverted until the next key press
+    toggleEditValueError();
+    return;
+  }
   drawEditValueCursor();
-  _glcd.setX(_menuValuesLeftOffset + _editValueCursorPosition * _menuItemFont[_menuItemFontSize].width);
+  _glcd.setX(_menuValuesLeftOffset + _edit.cursorPosition * _menuItemFont[_menuItemFontSize].width);
   int pointerPosition = getCurrentItemTopOffset();
   _glcd.setY(pointerPosition);
   _glcd.put(code);
   drawEditValueCursor();
 }
 
-void GEM::nextEditValueSelect() {
-  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  GEMSelect* select = menuItemTmp->select;
-  if (_valueSelectNum+1 < select->getLength()) {
-    _valueSelectNum++;
-  }
+#ifdef GEM_SUPPORT_SELECT
+void GEM::nextEditValueSelect(byte steps) {
+  _edit.nextSelect(steps);
   drawEditValueSelect();
 }
 
-void GEM::prevEditValueSelect() {
-  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  GEMSelect* select = menuItemTmp->select;
-  if (_valueSelectNum > 0) {
-    _valueSelectNum--;
-  }
+void GEM::prevEditValueSelect(byte steps) {
+  _edit.prevSelect(steps);
   drawEditValueSelect();
 }
 
@@ -705,39 +632,29 @@ void GEM::drawEditValueSelect() {
   GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
   GEMSelect* select = menuItemTmp->select;
   clearValueVisibleRange();
-  printMenuItemValue(select->getOptionNameByIndex(_valueSelectNum));
+  printMenuItemValue(select->getOptionNameByIndex(_edit.selectNum));
   _glcd.drawSprite(_glcd.xdim - 7, getCurrentItemTopOffset(true, true), GEM_SPR_SELECT_ARROWS, GLCD_MODE_NORMAL);
   drawEditValueCursor();
 }
+#endif
 
 void GEM::saveEditValue() {
-  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  void* temp;
-  switch (menuItemTmp->linkedType) {
-    case GEM_VAL_INTEGER:
-      *(int*)menuItemTmp->linkedVariable = atoi(_valueString);
-      break;
-    case GEM_VAL_BYTE:
-      *(byte*)menuItemTmp->linkedVariable = atoi(_valueString);
-      break;
-    case GEM_VAL_CHAR:
-      strcpy((char*)menuItemTmp->linkedVariable, trimString(_valueString)); // Potential overflow if string length is not defined
-      break;
-    case GEM_VAL_SELECT:
-      {
-        GEMSelect* select = menuItemTmp->select;
-        select->setValue(menuItemTmp->linkedVariable, _valueSelectNum);
-      }
-      break;
-    #ifdef GEM_SUPPORT_FLOAT_EDIT
-    case GEM_VAL_FLOAT:
-      *(float*)menuItemTmp->linkedVariable = atof(_valueString);
-      break;
-    case GEM_VAL_DOUBLE:
-      *(double*)menuItemTmp->linkedVariable = atof(_valueString);
-      break;
-    #endif
+  // Malformed or out of range value can't be saved, edit mode stays on until it is corrected or canceled
+  if (_edit.status == GEM_PARSE_RANGE) {
+    // Value is clamped to the range and shown, so that the next press of OK saves it
+    _edit.clamp();
+    clearValueVisibleRange();
+    printMenuItemValue(_edit.getText());
+    drawEditValueCursor();
+    return;
+  } else if (_edit.status != GEM_PARSE_OK) {
+    // Value is shown inverted until the next key press
+    toggleEditValueError();
+    return;
   }
+  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
+  _edit.save();
+  _runtime.markSaved(menuItemTmp);
   if (menuItemTmp->saveAction != nullptr) {
     menuItemTmp->saveAction();
   }
@@ -745,41 +662,21 @@ void GEM::saveEditValue() {
 }
 
 void GEM::cancelEditValue() {
+  _edit.cancel();
   exitEditValue();
 }
 
 void GEM::exitEditValue() {
-  memset(_valueString, '\0', GEM_STR_LEN - 1);
-  _valueSelectNum = -1;
+  _edit.end();
   _editValueMode = false;
   drawEditValueCursor();
   drawMenu();
 }
 
-// Trim leading/trailing whitespaces
-// Author: Adam Rosenfield, https://stackoverflow.com/a/122721
-char* GEM::trimString(char* str) {
-  char *end;
-
-  // Trim leading space
-  while(isspace((unsigned char)*str)) str++;
-
-  if(*str == 0)  // All spaces?
-    return str;
-
-  // Trim trailing space
-  end = str + strlen(str) - 1;
-  while(end > str && isspace((unsigned char)*end)) end--;
-
-  // Write new null terminator
-  *(end+1) = 0;
-  
-  return str;
-}
-
 //====================== KEY DETECTION
 
 bool GEM::readyForKey() {
+  runTasks();
   if ( (context.loop == nullptr) ||
       ((context.loop != nullptr) && (context.allowExit)) ) {
     return true;
@@ -791,10 +688,91 @@ bool GEM::readyForKey() {
 }
 
 void GEM::registerKeyPress(byte keyCode) {
+  registerKeyPress(keyCode, 1);
+}
+
+void GEM::registerKeyPress(byte keyCode, byte count) {
   _currentKey = keyCode;
+  _currentKeyCount = count;
+  #ifdef GEM_ENABLE_BUS_COUNTER
+  // GEM_KEY_NONE (registered by readyForKey() while context is running) isn't counted as interaction
+  bool interaction = _busCounter != nullptr && keyCode != GEM_KEY_NONE;
+  if (interaction) {
+    _busCounter->beginInteraction();
+  }
+  #endif
   dispatchKeyPress();
+  #ifdef GEM_ENABLE_BUS_COUNTER
+  if (interaction) {
+    _busCounter->endInteraction();
+  }
+  #endif
+}
+
+#ifdef GEM_ENABLE_KEY_QUEUE
+bool GEM::queueKeyPress(byte keyCode) {
+  return _runtime.getKeyQueue().push(keyCode);
 }
 
+void GEM::processKeyQueue() {
+  _runtime.processKeyQueue(*this);
+}
+
+GEMKeyQueue& GEM::getKeyQueue() {
+  return _runtime.getKeyQueue();
+}
+#endif
+
+#ifdef GEM_ENABLE_SCHEDULER
+void GEM::addTask(GEMTask& task) {
+  _runtime.getScheduler().add(task);
+}
+
+void GEM::removeTask(GEMTask& task) {
+  _runtime.getScheduler().remove(task);
+}
+
+GEMScheduler& GEM::getScheduler() {
+  return _runtime.getScheduler();
+}
+#endif
+
+void GEM::runTasks() {
+  // Tasks of the menu page run only while the page is on screen, i.e. not while context is running
+  _runtime.runTasks((context.loop == nullptr) ? _menuPageCurrent : nullptr);
+}
+
+#ifdef GEM_ENABLE_PERSIST
+void GEM::setPersist(GEMPersist& persist) {
+  _runtime.setPersist(persist);
+}
+#endif
+
+unsigned long GEM::nextDeadlineMillis() {
+  return _runtime.nextDeadlineMillis((context.loop == nullptr) ? _menuPageCurrent : nullptr);
+}
+
+#ifdef GEM_ENABLE_REMOTE
+void GEM::processRemote(GEMRemote& remote) {
+  // Value being edited is locked, so that remote write isn't overwritten when edit is saved
+  GEMItem* menuItemLocked = _editValueMode ? _menuPageCurrent->getCurrentMenuItem() : nullptr;
+  // Edit mode is drawn on top of the menu, which drawMenu() would wipe, so redraw is left to exitEditValue()
+  if (_runtime.processRemote(remote, menuItemLocked) && context.loop == nullptr && !_editValueMode) {
+    drawMenu();
+  }
+}
+#endif
+
+bool GEM::isIdle() {
+  return (long)(nextDeadlineMillis() - millis()) > 0;
+}
+
+#ifdef GEM_ENABLE_ENCODER
+void GEM::processEncoder(GEMEncoder& encoder) {
+  _runtime.processEncoder(*this, encoder, GEM_KEY_DOWN, GEM_KEY_UP);
+}
+#endif
+
 void GEM::dispatchKeyPress() {
 
   if (context.loop != nullptr) {
@@ -812,29 +790,36 @@ void GEM::dispatchKeyPress() {
   } else {
   
     if (_editValueMode) {
+      if (_edit.error) {
+        toggleEditValueError();
+      }
       switch (_currentKey) {
         case GEM_KEY_UP:
-          if (_editValueType == GEM_VAL_SELECT) {
-            prevEditValueSelect();
-          } else {
-            nextEditValueDigit();
+          #ifdef GEM_SUPPORT_SELECT
+          if (_edit.type == GEM_VAL_SELECT) {
+            prevEditValueSelect(_currentKeyCount);
+            break;
           }
+          #endif
+          nextEditValueDigit(_currentKeyCount);
           break;
         case GEM_KEY_RIGHT:
-          if (_editValueType != GEM_VAL_SELECT) {
-            nextEditValueCursorPosition();
+          if (_edit.type != GEM_VAL_SELECT) {
+            nextEditValueCursorPosition(_currentKeyCount);
           }
           break;
         case GEM_KEY_DOWN:
-          if (_editValueType == GEM_VAL_SELECT) {
-            nextEditValueSelect();
-          } else {
-            prevEditValueDigit();
+          #ifdef GEM_SUPPORT_SELECT
+          if (_edit.type == GEM_VAL_SELECT) {
+            nextEditValueSelect(_currentKeyCount);
+            break;
           }
+          #endif
+          prevEditValueDigit(_currentKeyCount);
           break;
         case GEM_KEY_LEFT:
-          if (_editValueType != GEM_VAL_SELECT) {
-            prevEditValueCursorPosition();
+          if (_edit.type != GEM_VAL_SELECT) {
+            prevEditValueCursorPosition(_currentKeyCount);
           }
           break;
         case GEM_KEY_CANCEL:
@@ -847,7 +832,7 @@ void GEM::dispatchKeyPress() {
     } else {
       switch (_currentKey) {
         case GEM_KEY_UP:
-          prevMenuItem();
+          prevMenuItem(_currentKeyCount);
           break;
         case GEM_KEY_RIGHT:
           if (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_LINK ||
@@ -856,7 +841,7 @@ void GEM::dispatchKeyPress() {
           }
           break;
         case GEM_KEY_DOWN:
-          nextMenuItem();
+          nextMenuItem(_currentKeyCount);
           break;
         case GEM_KEY_LEFT:
           if (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_BACK) {
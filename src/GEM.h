@@ -40,6 +40,39 @@
 #include <AltSerialGraphicLCD.h>
 #include "GEMPage.h"
 #include "GEMSelect.h"
+#include "GEMEdit.h"
+#include "GEMRuntime.h"
+#ifdef GEM_ENABLE_KEY_QUEUE
+#include "GEMKeyQueue.h"
+#endif
+#ifdef GEM_ENABLE_ENCODER
+#include "GEMEncoder.h"
+#endif
+#ifdef GEM_ENABLE_BUTTONS
+#include "GEMButtons.h"
+#endif
+#ifdef GEM_ENABLE_SCHEDULER
+#include "GEMScheduler.h"
+#endif
+#ifdef GEM_ENABLE_PERSIST
+#include "GEMPersist.h"
+#endif
+#ifdef GEM_ENABLE_SNAPSHOT
+#include "GEMSnapshot.h"
+#endif
+#ifdef GEM_ENABLE_REMOTE
+#include "GEMRemote.h"
+#endif
+#ifdef GEM_ENABLE_FOOTPRINT
+#include "GEMFootprint.h"
+#endif
+#ifdef GEM_ENABLE_PROFILER
+#include "GEMProfiler.h"
+#endif
+#ifdef GEM_ENABLE_BUS_COUNTER
+#include "GEMBusCounter.h"
+#include "GEMBusGLCD.h"
+#endif
 #include "constants.h"
 
 // Macro constants (aliases) for the keys (buttons) used to navigate and interact with menu
@@ -113,6 +146,47 @@ class GEM {
     AppContext context;                                  // Currently set context
     void clearContext();                                 // Clear context
 
+    /* TASK OPERATIONS */
+
+    void runTasks();                                     // Run tasks that are due (called by readyForKey(), call explicitly if readyForKey() isn't used)
+    #ifdef GEM_ENABLE_SCHEDULER
+    void addTask(GEMTask& task);                         // Add periodic task (e.g. background work of the context or live value of the menu page), tasks are run by readyForKey()
+    void removeTask(GEMTask& task);                      // Remove task (e.g. in exit() function of the context)
+    GEMScheduler& getScheduler();                        // Get the scheduler of tasks (e.g. to set tick budget or check overruns)
+    #endif
+
+    /* PERSISTENCE */
+
+    #ifdef GEM_ENABLE_PERSIST
+    void setPersist(GEMPersist& persist);                // Set persistence of menu items' linked variables: saved items are marked as changed and written to storage
+                                                         // (along with tasks) after quiet period
+    #endif
+
+    /* REMOTE CONTROL */
+
+    #ifdef GEM_ENABLE_REMOTE
+    void processRemote(GEMRemote& remote);               // Process requests received by remote control (call from loop()): written values are saved
+                                                         // as if edited on the device (save action, persistence), followed by a single redraw
+    #endif
+
+    /* POWER MANAGEMENT */
+
+    unsigned long nextDeadlineMillis();                  // Get value of millis() by which loop() should be called again (unless key is pressed earlier),
+                                                         // e.g. to put MCU to sleep until then (up to GEM_DEADLINE_MAX_WAIT ms from now if menu waits for key press only)
+    bool isIdle();                                       // Check that menu has nothing to do right now (no running context, queued key presses or due tasks)
+
+    /* PROFILING */
+
+    #ifdef GEM_ENABLE_PROFILER
+    void setProfiler(GEMProfiler& profiler);             // Set profiler that times the phases of drawMenu() and the menu items being drawn
+    #endif
+
+    /* BUS TRAFFIC */
+
+    #ifdef GEM_ENABLE_BUS_COUNTER
+    void setBusCounter(GEMBusCounter& counter);          // Set counter of the bytes and commands sent to display, per frame and per interaction
+    #endif
+
     /* DRAW OPERATIONS */
 
     void drawMenu();                                     // Draw menu on screen, with menu page set earlier in GEM::setMenuPageCurrent()
@@ -122,8 +196,24 @@ class GEM {
     bool readyForKey();                               // Check that menu is waiting for the key press
     void registerKeyPress(byte keyCode);                 // Register the key press and trigger corresponding action
                                                          // Accepts GEM_KEY_NONE, GEM_KEY_UP, GEM_KEY_RIGHT, GEM_KEY_DOWN, GEM_KEY_LEFT, GEM_KEY_CANCEL, GEM_KEY_OK values
+    void registerKeyPress(byte keyCode, byte count);     // Register the key press repeated count times (e.g. by accelerated encoder) as a single move with one redraw
+                                                         // (GEM_KEY_UP, GEM_KEY_RIGHT, GEM_KEY_DOWN, GEM_KEY_LEFT only, other keys are registered once)
+    #ifdef GEM_ENABLE_KEY_QUEUE
+    bool queueKeyPress(byte keyCode);                    // Add the key press to the queue without triggering any action, safe to call from interrupt service routine
+                                                         // (returns false if the queue of GEM_KEY_QUEUE_LEN key presses is full)
+    void processKeyQueue();                              // Register all queued key presses in order they were made (call from loop(), e.g. when readyForKey() returns true)
+    GEMKeyQueue& getKeyQueue();                          // Get the queue of key presses (e.g. to check timestamps or number of dropped key presses)
+    #endif
+    #ifdef GEM_ENABLE_ENCODER
+    void processEncoder(GEMEncoder& encoder);            // Register steps accumulated by rotary encoder as GEM_KEY_DOWN (clockwise) or GEM_KEY_UP (counterclockwise) key presses
+    #endif
   private:
+    #ifdef GEM_ENABLE_BUS_COUNTER
+    GEMBusGLCD _glcd;             // Commands are passed to GLCD and counted
+    GEMBusCounter* _busCounter = nullptr;
+    #else
     GLCD& _glcd;
+    #endif
     byte _menuPointerType;
     byte _menuItemsPerScreen;
     byte _menuItemHeight;
@@ -141,54 +231,59 @@ class GEM {
 
     GEMPage* _menuPageCurrent;
     GEMItem* _menuItemCurrent;
+    char _formatBuffer[GEM_STR_LEN];  // Text representation of the value of the menu item being drawn (formatted anew for each menu item, never cleared)
     void drawTitleBar();
-    void printMenuItemString(char* str, byte num, byte startPos = 0);
-    void printMenuItemTitle(char* str, int offset = 0);
-    void printMenuItemValue(char* str, int offset = 0, byte startPos = 0);
+    void printMenuItemString(const char* str, byte num, byte startPos = 0, bool progmem = false);
+    void printMenuItemTitle(const char* str, int offset = 0, bool progmem = false);
+    void printMenuItemValue(const char* str, int offset = 0, byte startPos = 0);
     void printMenuItemValue(GEMItem* menuItemTmp, byte yDraw);
-    void printMenuItemFull(char* str, int offset = 0);
+    void printMenuItemFull(const char* str, int offset = 0, bool progmem = false);
     byte getMenuItemInsetOffset(bool forSprite = false);
     byte getCurrentItemTopOffset(bool withInsetOffset = true, bool forSprite = false);
     void printMenuItems();
     void drawMenuPointer();
     void drawScrollbar();
+    #ifdef GEM_ENABLE_PROFILER
+    GEMProfiler* _profiler = nullptr;
+    #endif
 
     /* MENU ITEMS NAVIGATION */
 
-    void nextMenuItem();
-    void prevMenuItem();
+    void nextMenuItem(byte steps = 1);
+    void prevMenuItem(byte steps = 1);
     void menuItemSelect();
 
     /* VALUE EDIT */
 
     bool _editValueMode;
-    byte _editValueType;
-    byte _editValueLength;
-    byte _editValueCursorPosition;
-    byte _editValueVirtualCursorPosition;
-    char _valueString[GEM_STR_LEN];
-    int _valueSelectNum;
+    GEMEdit _edit;                // Value being edited, along with the cursor within it
     void enterEditValueMode();
     void checkboxToggle();
     void clearValueVisibleRange();
-    void initEditValueCursor();
-    void nextEditValueCursorPosition();
-    void prevEditValueCursorPosition();
+    void nextEditValueCursorPosition(byte steps = 1);
+    void prevEditValueCursorPosition(byte steps = 1);
     void drawEditValueCursor();
-    void nextEditValueDigit();
-    void prevEditValueDigit();
+    void toggleEditValueError();
+    void nextEditValueDigit(byte steps = 1);
+    void prevEditValueDigit(byte steps = 1);
     void drawEditValueDigit(byte code);
-    void nextEditValueSelect();
-    void prevEditValueSelect();
+    #ifdef GEM_SUPPORT_SELECT
+    void nextEditValueSelect(byte steps = 1);
+    void prevEditValueSelect(byte steps = 1);
     void drawEditValueSelect();
+    #endif
     void saveEditValue();
     void cancelEditValue();
     void exitEditValue();
-    char* trimString(char* str);
+
+    /* TASK OPERATIONS */
+
+    GEMRuntime _runtime;          // Tasks, persistence, key queue and remote control
 
     /* KEY DETECTION */
 
     byte _currentKey;
+    byte _currentKeyCount;        // Number of times current key is repeated (see registerKeyPress())
     void dispatchKeyPress();
 };
 
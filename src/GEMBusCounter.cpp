@@ -0,0 +1,101 @@
+/*
+  GEMBusCounter - accounting of the traffic sent to display for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "GEMBusCounter.h"
+
+GEMBusCounter::GEMBusCounter() {
+  reset();
+}
+
+void GEMBusCounter::reset() {
+  memset(&_total, 0, sizeof(GEMBusTraffic));
+  _frameStart = _total;
+  _interactionStart = _total;
+  _lastFrame = _total;
+  _lastInteraction = _total;
+  _maxFrame = _total;
+  _maxInteraction = _total;
+}
+
+const GEMBusTraffic& GEMBusCounter::getTotal() {
+  return _total;
+}
+
+const GEMBusTraffic& GEMBusCounter::getLastFrame() {
+  return _lastFrame;
+}
+
+const GEMBusTraffic& GEMBusCounter::getLastInteraction() {
+  return _lastInteraction;
+}
+
+const GEMBusTraffic& GEMBusCounter::getMaxFrame() {
+  return _maxFrame;
+}
+
+const GEMBusTraffic& GEMBusCounter::getMaxInteraction() {
+  return _maxInteraction;
+}
+
+void GEMBusCounter::add(unsigned long bytes, unsigned long commands) {
+  _total.bytes += bytes;
+  _total.commands += commands;
+}
+
+void GEMBusCounter::beginFrame() {
+  _frameStart = _total;
+}
+
+void GEMBusCounter::endFrame() {
+  _total.frames++;
+  since(_frameStart, _lastFrame, _maxFrame);
+}
+
+void GEMBusCounter::beginInteraction() {
+  _interactionStart = _total;
+}
+
+void GEMBusCounter::endInteraction() {
+  since(_interactionStart, _lastInteraction, _maxInteraction);
+}
+
+void GEMBusCounter::since(const GEMBusTraffic& start, GEMBusTraffic& traffic, GEMBusTraffic& max) {
+  traffic.bytes = _total.bytes - start.bytes;
+  traffic.commands = _total.commands - start.commands;
+  traffic.frames = _total.frames - start.frames;
+  if (traffic.bytes > max.bytes) {
+    max = traffic;
+  }
+}
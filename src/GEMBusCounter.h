@@ -0,0 +1,91 @@
+/*
+  GEMBusCounter - accounting of the traffic sent to display for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_GEMBUSCOUNTER
+#define HEADER_GEMBUSCOUNTER
+
+#include <Arduino.h>
+#include "config.h"
+
+// Declaration of GEMBusTraffic type
+struct GEMBusTraffic {
+  unsigned long bytes;         // Bytes sent to display
+  unsigned long commands;      // Commands sent to display (GEM), or bus transfers (GEM_u8g2)
+  unsigned long frames;        // Number of calls of drawMenu(), i.e. redraws of the whole menu
+};
+
+// Declaration of GEMBusCounter class
+// Counts bytes and commands sent to display in total, in the last frame (call of drawMenu()) and in the last interaction
+// (key press registered by registerKeyPress(), along with all of the redraws it resulted in). Counting is done by GEM and GEM_u8g2
+// only when GEM_ENABLE_BUS_COUNTER is defined (see config.h): GEM_u8g2 wraps byte callback of U8g2 (so that actual bytes on the bus
+// are counted), GEM sizes each command of the serial protocol of AltSerialGraphicLCD it sends (the library writes to Serial directly).
+class GEMBusCounter {
+  public:
+    GEMBusCounter();
+    void reset();                                     // Reset all of the counts
+    const GEMBusTraffic& getTotal();                  // Get traffic since the counter was attached (or reset)
+    const GEMBusTraffic& getLastFrame();              // Get traffic of the last frame (last call of drawMenu())
+    const GEMBusTraffic& getLastInteraction();        // Get traffic of the last interaction (last key press, including redraws it resulted in)
+    const GEMBusTraffic& getMaxFrame();               // Get traffic of the frame with the most bytes sent so far
+    const GEMBusTraffic& getMaxInteraction();         // Get traffic of the interaction with the most bytes sent so far
+
+    /* Called by GEM and GEM_u8g2 */
+
+    void add(unsigned long bytes, unsigned long commands = 1);
+    void beginFrame();
+    void endFrame();
+    void beginInteraction();
+    void endInteraction();
+  private:
+    GEMBusTraffic _total;
+    GEMBusTraffic _frameStart;                        // Value of _total at the start of the current frame
+    GEMBusTraffic _interactionStart;                  // Value of _total at the start of the current interaction
+    GEMBusTraffic _lastFrame;
+    GEMBusTraffic _lastInteraction;
+    GEMBusTraffic _maxFrame;
+    GEMBusTraffic _maxInteraction;
+    void since(const GEMBusTraffic& start, GEMBusTraffic& traffic, GEMBusTraffic& max);
+};
+
+// Hooks placed by GEM and GEM_u8g2 in drawMenu(), expand to nothing when counter is disabled
+#ifdef GEM_ENABLE_BUS_COUNTER
+  #define GEM_BUS_FRAME_BEGIN(counter) if (counter != nullptr) { counter->beginFrame(); }
+  #define GEM_BUS_FRAME_END(counter) if (counter != nullptr) { counter->endFrame(); }
+#else
+  #define GEM_BUS_FRAME_BEGIN(counter)
+  #define GEM_BUS_FRAME_END(counter)
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*
+  GEMBusGLCD - AltSerialGraphicLCD commands sent by GEM, counted by GEMBusCounter.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_GEMBUSGLCD
+#define HEADER_GEMBUSGLCD
+
+#include <Arduino.h>
+#include <AltSerialGraphicLCD.h>
+#include "GEMBusCounter.h"
+
+// Declaration of GEMBusGLCD class
+// Takes place of the reference to GLCD object within GEM when GEM_ENABLE_BUS_COUNTER is defined: each command is passed to GLCD as is,
+// and its size in the serial protocol of the display (command prefix and code followed by arguments, or raw characters of the text)
+// is added to the counter. Only commands used by GEM are provided.
+class GEMBusGLCD {
+  public:
+    GEMBusGLCD(GLCD& glcd_)
+      : xdim(glcd_.xdim)
+      , ydim(glcd_.ydim)
+      , _glcd(glcd_)
+    { }
+    const uint8_t xdim;
+    const uint8_t ydim;
+    void setCounter(GEMBusCounter* counter) { _counter = counter; }
+    void set(uint8_t id, uint8_t value) { _glcd.set(id, value); count(2); }
+    void clearScreen() { _glcd.clearScreen(); count(0); }
+    void drawMode(uint8_t mode) { _glcd.drawMode(mode); count(1); }
+    void fontMode(uint8_t mode) { _glcd.fontMode(mode); count(1); }
+    void fontFace(uint8_t face) { _glcd.fontFace(face); count(1); }
+    void setX(uint8_t x) { _glcd.setX(x); count(1); }
+    void setY(uint8_t y) { _glcd.setY(y); count(1); }
+    void setXY(uint8_t x, uint8_t y) { _glcd.setXY(x, y); count(2); }
+    void put(char c) { _glcd.put(c); countText(1); }
+    void putstr(const char* str) { _glcd.putstr(str); countText(strlen(str)); }
+    void drawPixel(uint8_t x, uint8_t y, uint8_t mode) { _glcd.drawPixel(x, y, mode); count(3); }
+    void drawLine(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode) { _glcd.drawLine(x1, y1, x2, y2, mode); count(5); }
+    void drawBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t mode) { _glcd.drawBox(x1, y1, x2, y2, mode); count(5); }
+    void fillBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t pattern = 0xFF) { _glcd.fillBox(x1, y1, x2, y2, pattern); count(5); }
+    void eraseBox(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) { _glcd.eraseBox(x1, y1, x2, y2); count(4); }
+    void loadSprite_P(uint8_t id, const uint8_t* sprite) { _glcd.loadSprite_P(id, sprite); count(1 + spriteSize(sprite)); }
+    void drawSprite(uint8_t x, uint8_t y, uint8_t id, uint8_t mode) { _glcd.drawSprite(x, y, id, mode); count(4); }
+    void bitblt_P(uint8_t x, uint8_t y, uint8_t mode, const uint8_t* bitmap) { _glcd.bitblt_P(x, y, mode, bitmap); count(3 + spriteSize(bitmap)); }
+  private:
+    GLCD& _glcd;
+    GEMBusCounter* _counter = nullptr;
+    void count(unsigned int arguments) {
+      if (_counter != nullptr) {
+        _counter->add(2 + arguments);  // Command prefix and code, followed by arguments
+      }
+    }
+    void countText(unsigned int length) {
+      if (_counter != nullptr) {
+        _counter->add(length);
+      }
+    }
+    static unsigned int spriteSize(const uint8_t* sprite) {
+      // Width and height, followed by columns of each band of 8 rows
+      return 2 + pgm_read_byte(sprite) * ((pgm_read_byte(sprite + 1) + 7) / 8);
+    }
+};
+
+#endif
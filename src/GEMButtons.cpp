@@ -0,0 +1,142 @@
+/*
+  GEMButtons - non-blocking debounce and auto-repeat of push-buttons for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMButtons.h"
+
+// Bits of GEMButton::flags
+#define GEM_BUTTON_FLAG_RAW 0x01         // Current (not debounced) level of the pin means pressed button
+#define GEM_BUTTON_FLAG_STABLE 0x02      // Debounced state: button is pressed
+#define GEM_BUTTON_FLAG_REPEATING 0x04   // First repeat was emitted
+#define GEM_BUTTON_FLAG_LONG 0x08        // Long-press key code was emitted
+
+GEMButtons::GEMButtons(GEMButton* buttons_, byte count_, bool pullUp_)
+  : _buttons(buttons_)
+  , _count(count_)
+  , _pullUp(pullUp_)
+  , _event(GEM_BUTTON_NONE)
+  , _resume(0)
+{ }
+
+void GEMButtons::begin() {
+  for (byte i = 0; i < _count; i++) {
+    pinMode(_buttons[i].pin, _pullUp ? INPUT_PULLUP : INPUT);
+    _buttons[i].flags = 0;
+  }
+  _resume = 0;
+}
+
+void GEMButtons::setDebounce(byte debounceTime) {
+  _debounceTime = debounceTime;
+}
+
+void GEMButtons::setRepeat(unsigned int repeatDelay, unsigned int repeatInterval) {
+  _repeatDelay = repeatDelay;
+  _repeatInterval = repeatInterval;
+}
+
+void GEMButtons::setLongPress(unsigned int longPressTime) {
+  _longPressTime = longPressTime;
+}
+
+byte GEMButtons::getKey() {
+  unsigned long time = millis();
+  _event = GEM_BUTTON_NONE;
+  byte i = (_resume < _count) ? _resume : 0;
+  for (byte n = 0; n < _count; n++) {
+    // At most one event is emitted per call, the next call starts from the button after the one that fired
+    byte keyCode = updateButton(_buttons[i], time);
+    i = (i + 1 < _count) ? i + 1 : 0;
+    if (_event != GEM_BUTTON_NONE) {
+      _resume = i;
+      return keyCode;
+    }
+  }
+  return 0; // GEM_KEY_NONE
+}
+
+bool GEMButtons::isIdle() {
+  for (byte i = 0; i < _count; i++) {
+    if (_buttons[i].flags & (GEM_BUTTON_FLAG_RAW | GEM_BUTTON_FLAG_STABLE)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+byte GEMButtons::getEvent() {
+  return _event;
+}
+
+byte GEMButtons::updateButton(GEMButton& button, unsigned long time) {
+  bool raw = (digitalRead(button.pin) == HIGH) != _pullUp;
+  if (raw != (bool)(button.flags & GEM_BUTTON_FLAG_RAW)) {
+    button.flags ^= GEM_BUTTON_FLAG_RAW;
+    button.changed = time;
+  }
+  bool pressed = button.flags & GEM_BUTTON_FLAG_STABLE;
+  if (raw != pressed) {
+    if ((byte)((byte)time - button.changed) < _debounceTime) {
+      return 0; // Level is still bouncing
+    }
+    if (raw) {
+      button.flags = (button.flags | GEM_BUTTON_FLAG_STABLE) & ~(GEM_BUTTON_FLAG_REPEATING | GEM_BUTTON_FLAG_LONG);
+      button.time = time;
+      if (button.longPressKeyCode == 0) {
+        _event = GEM_BUTTON_PRESS;
+        return button.keyCode;
+      }
+    } else {
+      button.flags &= ~GEM_BUTTON_FLAG_STABLE;
+      if (button.longPressKeyCode != 0 && !(button.flags & GEM_BUTTON_FLAG_LONG)) {
+        _event = GEM_BUTTON_PRESS; // Short press of the button with long-press key code is emitted on release
+        return button.keyCode;
+      }
+    }
+  } else if (pressed) {
+    if (button.longPressKeyCode != 0) {
+      if (!(button.flags & GEM_BUTTON_FLAG_LONG) && time - button.time >= _longPressTime) {
+        button.flags |= GEM_BUTTON_FLAG_LONG;
+        _event = GEM_BUTTON_LONG_PRESS;
+        return button.longPressKeyCode;
+      }
+    } else if (_repeatDelay > 0 && time - button.time >= ((button.flags & GEM_BUTTON_FLAG_REPEATING) ? _repeatInterval : _repeatDelay)) {
+      button.flags |= GEM_BUTTON_FLAG_REPEATING;
+      button.time = time;
+      _event = GEM_BUTTON_REPEAT;
+      return button.keyCode;
+    }
+  }
+  return 0;
+}
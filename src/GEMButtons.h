@@ -0,0 +1,90 @@
+/*
+  GEMButtons - non-blocking debounce and auto-repeat of push-buttons for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMBUTTONS
+#define HEADER_GEMBUTTONS
+
+#include <Arduino.h>
+
+// Macro constants (aliases) for the types of events emitted by GEMButtons
+#define GEM_BUTTON_NONE 0        // No event
+#define GEM_BUTTON_PRESS 1       // Button is pressed (or released before long-press time, if long-press key code is set)
+#define GEM_BUTTON_REPEAT 2      // Button is held down long enough to repeat the key press
+#define GEM_BUTTON_LONG_PRESS 3  // Button is held down for long-press time
+
+// Declaration of GEMButton type
+struct GEMButton {
+  byte keyCode;            // Key code emitted on press and repeat (GEM_KEY_UP, GEM_KEY_DOWN, etc.)
+  byte pin;                // Pin the button is connected to
+  byte longPressKeyCode;   // Key code emitted when button is held down for long-press time (optional, GEM_KEY_NONE disables long press and enables repeat instead),
+                           // short press is then emitted on release
+  byte flags;              // Debounce and repeat state (managed by GEMButtons)
+  byte changed;            // Lower byte of millis() at the last change of the pin level (managed by GEMButtons)
+  unsigned long time;      // Value of millis() at the press or the last repeat (managed by GEMButtons)
+};
+
+// Declaration of GEMButtons class
+// Scans the buttons on each call of getKey() (from the main loop) and emits key codes, timing is based on millis() and nothing blocks
+class GEMButtons {
+  public:
+    /* 
+      @param 'buttons_' - array of the buttons
+      @param 'count_' - number of the buttons in the array
+      @param 'pullUp_' (optional) - use internal pull-up resistors (LOW means that the button is pressed),
+      otherwise buttons are expected to be wired with pulldown resistors (HIGH means that the button is pressed)
+      default false
+    */
+    GEMButtons(GEMButton* buttons_, byte count_, bool pullUp_ = false);
+    void begin();                                             // Set up pins of the buttons
+    void setDebounce(byte debounceTime);                      // Set time (in ms) the pin level should stay unchanged to be accepted (default 20 ms)
+    void setRepeat(unsigned int repeatDelay, unsigned int repeatInterval);  // Set time (in ms) the button should be held down before the first repeat and interval between repeats
+                                                              // (default 500 ms and 100 ms, repeatDelay of 0 disables repeat)
+    void setLongPress(unsigned int longPressTime);            // Set time (in ms) the button should be held down to emit long-press key code (default 800 ms)
+    byte getKey();                                            // Scan the buttons and get key code of the next event (or GEM_KEY_NONE), should be called on each loop() iteration
+    bool isIdle();                                            // Check that none of the buttons is pressed or bouncing, i.e. there is no need to call getKey() until level of one of the pins changes
+    byte getEvent();                                          // Get type of the event of the key code returned by the last getKey() call (GEM_BUTTON_NONE, GEM_BUTTON_PRESS, GEM_BUTTON_REPEAT, GEM_BUTTON_LONG_PRESS)
+  private:
+    GEMButton* _buttons;
+    byte _count;
+    bool _pullUp;
+    byte _debounceTime = 20;
+    unsigned int _repeatDelay = 500;
+    unsigned int _repeatInterval = 100;
+    unsigned int _longPressTime = 800;
+    byte _event;
+    byte _resume;                                             // Index of the button to start the next scan from, so that buttons at the end of the array aren't starved by held ones before them
+    byte updateButton(GEMButton& button, unsigned long time);
+};
+
+#endif
@@ -0,0 +1,499 @@
+/*
+  GEMEdit - value of the menu item being edited, shared by GEM and GEM_u8g2.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMEdit.h"
+#include "GEMItem.h"
+#include "GEMSelect.h"
+#include "GEMFormat.h"
+#include <limits.h>
+
+// Macro constants (aliases) for some of the ASCII character codes
+#define GEM_CHAR_CODE_9 57
+#define GEM_CHAR_CODE_0 48
+#define GEM_CHAR_CODE_MINUS 45
+#define GEM_CHAR_CODE_DOT 46
+#define GEM_CHAR_CODE_SPACE 32
+#define GEM_CHAR_CODE_LINE 124
+#define GEM_CHAR_CODE_TILDA 126
+
+GEMEdit::GEMEdit()
+  : menuItem(nullptr)
+  , type(0)
+  , length(0)
+  , cursorPosition(0)
+  , virtualCursorPosition(0)
+  , selectNum(-1)
+  , number(0)
+  , status(GEM_PARSE_OK)
+  , error(false)
+{ }
+
+void GEMEdit::begin(GEMItem* menuItem_) {
+  menuItem = menuItem_;
+  type = menuItem->linkedType;
+  status = GEM_PARSE_OK;
+  error = false;
+  cursorPosition = 0;
+  virtualCursorPosition = 0;
+  switch (type) {
+    case GEM_VAL_INTEGER:
+      GEMFormatInt(*(int*)menuItem->linkedVariable, valueString);
+      length = 6;
+      break;
+    case GEM_VAL_BYTE:
+      GEMFormatInt(*(byte*)menuItem->linkedVariable, valueString);
+      length = 3;
+      break;
+    case GEM_VAL_CHAR:
+      strcpy(valueString, (const char*)menuItem->linkedVariable);
+      length = GEM_STR_LEN - 1;
+      break;
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    case GEM_VAL_STRING:
+      length = menuItem->precision - 1;
+      journalLength = 0;
+      stringLength = strlen((const char*)menuItem->linkedVariable);
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+    case GEM_VAL_FIXED32:
+      formatFixed(menuItem, valueString);
+      length = (type == GEM_VAL_FIXED16 ? 6 : 11) + (menuItem->fixedPoint->decimals > 0 ? 1 : 0); // Digits, minus sign and decimal sign
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_SELECT
+    case GEM_VAL_SELECT:
+      selectNum = menuItem->select->getSelectedOptionNum(menuItem->linkedVariable);
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_FLOAT_EDIT
+    case GEM_VAL_FLOAT:
+      GEMFormatFloat(*(float*)menuItem->linkedVariable, menuItem->precision, valueString, GEM_STR_LEN);
+      length = GEM_STR_LEN - 1;
+      break;
+    case GEM_VAL_DOUBLE:
+      GEMFormatFloat(*(double*)menuItem->linkedVariable, menuItem->precision, valueString, GEM_STR_LEN);
+      length = GEM_STR_LEN - 1;
+      break;
+    #endif
+  }
+  parse();
+}
+
+void GEMEdit::end() {
+  selectNum = -1;
+}
+
+byte GEMEdit::getWindowOffset() {
+  return virtualCursorPosition - cursorPosition;
+}
+
+const char* GEMEdit::getText() {
+  byte windowOffset = getWindowOffset();
+  #ifdef GEM_SUPPORT_STRING_BUFFER
+  if (type == GEM_VAL_STRING) {
+    // Visible part of the string is put together from the linked variable and the changes made to it
+    byte i = 0;
+    char c;
+    while (i < GEM_STR_LEN - 1 && (c = charAt(windowOffset + i)) != '\0') {
+      valueString[i++] = c;
+    }
+    valueString[i] = '\0';
+    return valueString;
+  }
+  #endif
+  return valueString + windowOffset;
+}
+
+void GEMEdit::nextCursorPosition(byte steps, byte visibleLength) {
+  if (visibleLength > GEM_STR_LEN - 1) {
+    visibleLength = GEM_STR_LEN - 1; // Visible part of the value is limited by the length of valueString (see getText())
+  }
+  for (; steps > 0; steps--) {
+    if ((cursorPosition != visibleLength - 1) && (cursorPosition != length - 1) && (charAt(cursorPosition) != '\0')) {
+      cursorPosition++;
+    }
+    if ((virtualCursorPosition != length - 1) && (charAt(virtualCursorPosition) != '\0')) {
+      virtualCursorPosition++;
+    }
+  }
+}
+
+void GEMEdit::prevCursorPosition(byte steps) {
+  for (; steps > 0; steps--) {
+    if (cursorPosition != 0) {
+      cursorPosition--;
+    }
+    if (virtualCursorPosition != 0) {
+      virtualCursorPosition--;
+    }
+  }
+}
+
+byte GEMEdit::nextCode(byte steps) {
+  byte code = (byte)charAt(virtualCursorPosition);
+  for (; steps > 0; steps--) {
+    if (type == GEM_VAL_CHAR || type == GEM_VAL_STRING) {
+      switch (code) {
+        case 0:
+          code = GEM_CHAR_CODE_SPACE;
+          break;
+        case GEM_CHAR_CODE_TILDA:
+          code = GEM_CHAR_CODE_SPACE;
+          break;
+        case GEM_CHAR_CODE_LINE - 1:
+          code = GEM_CHAR_CODE_LINE + 1;
+          break;
+        default:
+          code++;
+          break;
+      }
+    } else {
+      switch (code) {
+        case 0:
+          code = GEM_CHAR_CODE_0;
+          break;
+        case GEM_CHAR_CODE_9:
+          code = (cursorPosition == 0 && isSigned()) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_SPACE;
+          break;
+        case GEM_CHAR_CODE_MINUS:
+          code = GEM_CHAR_CODE_SPACE;
+          break;
+        case GEM_CHAR_CODE_SPACE:
+          code = (cursorPosition != 0 && isDecimal()) ? GEM_CHAR_CODE_DOT : GEM_CHAR_CODE_0;
+          break;
+        case GEM_CHAR_CODE_DOT:
+          code = GEM_CHAR_CODE_0;
+          break;
+        default:
+          code++;
+          break;
+      }
+    }
+  }
+  return code;
+}
+
+byte GEMEdit::prevCode(byte steps) {
+  byte code = (byte)charAt(virtualCursorPosition);
+  for (; steps > 0; steps--) {
+    if (type == GEM_VAL_CHAR || type == GEM_VAL_STRING) {
+      switch (code) {
+        case 0:
+          code = GEM_CHAR_CODE_TILDA;
+          break;
+        case GEM_CHAR_CODE_SPACE:
+          code = GEM_CHAR_CODE_TILDA;
+          break;
+        case GEM_CHAR_CODE_LINE + 1:
+          code = GEM_CHAR_CODE_LINE - 1;
+          break;
+        default:
+          code--;
+          break;
+      }
+    } else {
+      switch (code) {
+        case 0:
+          code = (cursorPosition == 0 && isSigned()) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_9;
+          break;
+        case GEM_CHAR_CODE_MINUS:
+          code = GEM_CHAR_CODE_9;
+          break;
+        case GEM_CHAR_CODE_0:
+          code = (cursorPosition != 0 && isDecimal()) ? GEM_CHAR_CODE_DOT : GEM_CHAR_CODE_SPACE;
+          break;
+        case GEM_CHAR_CODE_SPACE:
+          code = (cursorPosition == 0 && isSigned()) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_9;
+          break;
+        case GEM_CHAR_CODE_DOT:
+          code = GEM_CHAR_CODE_SPACE;
+          break;
+        default:
+          code--;
+          break;
+      }
+    }
+  }
+  return code;
+}
+
+bool GEMEdit::setCode(byte code) {
+  #ifdef GEM_SUPPORT_STRING_BUFFER
+  if (type == GEM_VAL_STRING) {
+    return journalChange((char)code);
+  }
+  #endif
+  if (valueString[virtualCursorPosition] == '\0') {
+    valueString[virtualCursorPosition + 1] = '\0'; // Character appended to the end of the value requires new terminating '\0' (buffer is never cleared)
+  }
+  valueString[virtualCursorPosition] = (char)code;
+  parse();
+  return true;
+}
+
+bool GEMEdit::isSigned() {
+  return type == GEM_VAL_INTEGER || type == GEM_VAL_FLOAT || type == GEM_VAL_DOUBLE ||
+         type == GEM_VAL_FIXED16 || type == GEM_VAL_FIXED32;
+}
+
+bool GEMEdit::isDecimal() {
+  switch (type) {
+    case GEM_VAL_FLOAT:
+    case GEM_VAL_DOUBLE:
+      return true;
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+    case GEM_VAL_FIXED32:
+      return menuItem->fixedPoint->decimals > 0;
+    #endif
+    default:
+      return false;
+  }
+}
+
+char GEMEdit::charAt(byte position) {
+  #ifdef GEM_SUPPORT_STRING_BUFFER
+  if (type == GEM_VAL_STRING) {
+    for (byte i = 0; i < journalLength; i++) {
+      if (journal[i].position == position) {
+        return journal[i].character;
+      }
+    }
+    // Characters are only changed or appended one after another, so there are no gaps between the string and the changes
+    return (position < stringLength) ? ((const char*)menuItem->linkedVariable)[position] : '\0';
+  }
+  #endif
+  return valueString[position];
+}
+
+#ifdef GEM_SUPPORT_STRING_BUFFER
+bool GEMEdit::journalChange(char character) {
+  byte position = virtualCursorPosition;
+  for (byte i = 0; i < journalLength; i++) {
+    if (journal[i].position == position) {
+      journal[i].character = character;
+      return true;
+    }
+  }
+  if (journalLength == GEM_EDIT_JOURNAL_LEN) {
+    return false; // Change of yet another character is refused, until edit is saved or canceled
+  }
+  journal[journalLength++] = {position, character};
+  return true;
+}
+#endif
+
+#ifdef GEM_SUPPORT_FIXED_POINT
+void GEMEdit::formatFixed(GEMItem* menuItem, char* buffer, bool withUnit) {
+  long value = (menuItem->linkedType == GEM_VAL_FIXED16) ? *(int16_t*)menuItem->linkedVariable : *(int32_t*)menuItem->linkedVariable;
+  const FixedPointFormat* format = menuItem->fixedPoint;
+  byte length = GEMFormatFixed(value, format->decimals, buffer);
+  if (withUnit && format->unit != nullptr) {
+    // Unit is appended up to the end of the buffer, without padding the rest of it with '\0' (as strncpy() would)
+    const char* unit = format->unit;
+    while (*unit != '\0' && length < GEM_STR_LEN - 1) {
+      buffer[length++] = *unit++;
+    }
+    buffer[length] = '\0';
+  }
+}
+#endif
+
+void GEMEdit::parse() {
+  switch (type) {
+    case GEM_VAL_INTEGER:
+      status = GEMParseInt(valueString, INT_MIN, INT_MAX, number);
+      break;
+    case GEM_VAL_BYTE:
+      status = GEMParseInt(valueString, 0, 255, number);
+      break;
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+      status = GEMParseFixed(valueString, menuItem->fixedPoint->decimals, -32768L, 32767L, number);
+      break;
+    case GEM_VAL_FIXED32:
+      status = GEMParseFixed(valueString, menuItem->fixedPoint->decimals, -2147483647L - 1, 2147483647L, number);
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_FLOAT_EDIT
+    case GEM_VAL_FLOAT:
+    case GEM_VAL_DOUBLE:
+      status = GEMParseFloat(valueString, numberFloat);
+      break;
+    #endif
+  }
+}
+
+void GEMEdit::clamp() {
+  // Value out of range is either too great, or too small (and negative), so it is replaced with the nearest limit of the range
+  const char* str = valueString;
+  while (*str == ' ') {
+    str++;
+  }
+  bool negative = (*str == '-');
+  switch (type) {
+    case GEM_VAL_INTEGER:
+      number = negative ? INT_MIN : INT_MAX;
+      GEMFormatInt(number, valueString);
+      break;
+    case GEM_VAL_BYTE:
+      number = negative ? 0 : 255;
+      GEMFormatInt(number, valueString);
+      break;
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+      number = negative ? -32768L : 32767L;
+      GEMFormatFixed(number, menuItem->fixedPoint->decimals, valueString);
+      break;
+    case GEM_VAL_FIXED32:
+      number = negative ? -2147483647L - 1 : 2147483647L;
+      GEMFormatFixed(number, menuItem->fixedPoint->decimals, valueString);
+      break;
+    #endif
+  }
+  status = GEM_PARSE_OK;
+  cursorPosition = 0;
+  virtualCursorPosition = 0;
+}
+
+#ifdef GEM_SUPPORT_SELECT
+void GEMEdit::nextSelect(byte steps) {
+  int optionsCount = menuItem->select->getLength();
+  if (selectNum < 0) {
+    // Select with no option matching the value counts as the one before the first option (handled first, as count of the
+    // options minus -1 overflows int for the capped range)
+    if (steps == 0) {
+      return;
+    }
+    selectNum = 0;
+    steps--;
+  }
+  selectNum = (steps < optionsCount - selectNum) ? selectNum + steps : optionsCount - 1; // Compared without the sum, which may overflow int near the end of capped range
+}
+
+void GEMEdit::prevSelect(byte steps) {
+  // Select with no option matching the value (-1) stays as is, so that the value isn't changed unless an option is chosen
+  if (selectNum > 0) {
+    selectNum = (selectNum > steps) ? selectNum - steps : 0;
+  }
+}
+#endif
+
+void GEMEdit::save() {
+  switch (type) {
+    case GEM_VAL_INTEGER:
+      *(int*)menuItem->linkedVariable = number;
+      break;
+    case GEM_VAL_BYTE:
+      *(byte*)menuItem->linkedVariable = number;
+      break;
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+      *(int16_t*)menuItem->linkedVariable = number;
+      break;
+    case GEM_VAL_FIXED32:
+      *(int32_t*)menuItem->linkedVariable = number;
+      break;
+    #endif
+    case GEM_VAL_CHAR:
+      strcpy((char*)menuItem->linkedVariable, trimString(valueString)); // Potential overflow if string length is not defined
+      break;
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    case GEM_VAL_STRING:
+      {
+        // Changes are applied to the string only now, so that the rest of the sketch never sees half-edited value
+        char* str = (char*)menuItem->linkedVariable;
+        byte end = stringLength;
+        for (byte i = 0; i < journalLength; i++) {
+          str[journal[i].position] = journal[i].character;
+          if (journal[i].position >= end) {
+            end = journal[i].position + 1;
+          }
+        }
+        str[end] = '\0';
+        journalLength = 0;
+        char* trimmed = trimString(str);
+        if (trimmed != str) {
+          memmove(str, trimmed, strlen(trimmed) + 1);
+        }
+      }
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_SELECT
+    case GEM_VAL_SELECT:
+      menuItem->select->setValue(menuItem->linkedVariable, selectNum);
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_FLOAT_EDIT
+    case GEM_VAL_FLOAT:
+      *(float*)menuItem->linkedVariable = numberFloat;
+      break;
+    case GEM_VAL_DOUBLE:
+      *(double*)menuItem->linkedVariable = numberFloat;
+      break;
+    #endif
+  }
+}
+
+void GEMEdit::cancel() {
+  #ifdef GEM_SUPPORT_STRING_BUFFER
+  if (type == GEM_VAL_STRING) {
+    journalLength = 0; // Linked variable is changed only on save, so there is nothing to revert
+  }
+  #endif
+}
+
+// Trim leading/trailing whitespaces
+// Author: Adam Rosenfield, https://stackoverflow.com/a/122721
+char* GEMEdit::trimString(char* str) {
+  char *end;
+
+  // Trim leading space
+  while(isspace((unsigned char)*str)) str++;
+
+  if(*str == 0)  // All spaces?
+    return str;
+
+  // Trim trailing space
+  end = str + strlen(str) - 1;
+  while(end > str && isspace((unsigned char)*end)) end--;
+
+  // Write new null terminator
+  *(end+1) = 0;
+  
+  return str;
+}
@@ -0,0 +1,105 @@
+/*
+  GEMEdit - value of the menu item being edited, shared by GEM and GEM_u8g2.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMEDIT
+#define HEADER_GEMEDIT
+
+#include <Arduino.h>
+#include "config.h"
+#include "constants.h"
+
+// Forward declaration of necessary classes
+class GEMItem;
+
+// Declaration of GEMEdit class
+// Text representation of the value being edited along with the cursor within it, changed character by character and
+// converted back to the linked variable on save. Drawing of the value is left to GEM and GEM_u8g2, which own the object.
+class GEMEdit {
+  friend class GEM;
+  friend class GEM_u8g2;
+  public:
+    GEMEdit();
+    void begin(GEMItem* menuItem_);                        // Start edit of the value of the menu item (formatted as text, or index of the option for select)
+    void end();                                             // Finish edit (whether value was saved or not)
+    byte getWindowOffset();                                 // Get position of the first visible character of the value (when value is wider than its visible part)
+    const char* getText();                                  // Get characters of the value starting from the first visible one (up to GEM_STR_LEN - 1 of them for GEM_VAL_STRING)
+    void nextCursorPosition(byte steps, byte visibleLength);  // Move cursor to the right, within the value and its visible part of visibleLength characters
+    void prevCursorPosition(byte steps);                    // Move cursor to the left
+    byte nextCode(byte steps);                              // Get code of the character under the cursor, changed to the next allowed one steps times
+    byte prevCode(byte steps);                              // Get code of the character under the cursor, changed to the previous allowed one steps times
+    bool setCode(byte code);                                // Replace character under the cursor (returns false if change can't be made, i.e. journal of GEM_VAL_STRING variable is full)
+    void clamp();                                           // Replace value out of range with the nearest limit of the range (cursor is moved to the start)
+    void save();                                            // Assign edited value to the linked variable (value should be parsed successfully)
+    void cancel();                                          // Discard changes (linked variable is left intact)
+    #ifdef GEM_SUPPORT_SELECT
+    void nextSelect(byte steps);                            // Select the next option steps times (stops at the last one, from no option goes to the first one)
+    void prevSelect(byte steps);                            // Select the previous option steps times (stops at the first one, no option stays as is)
+    #endif
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    static void formatFixed(GEMItem* menuItem, char* buffer, bool withUnit = false);  // Print value of the fixed-point variable, optionally followed by its unit (up to GEM_STR_LEN - 1 characters)
+    #endif
+  private:
+    GEMItem* menuItem;
+    byte type;                    // Type of the linked variable (GEM_VAL_INTEGER, GEM_VAL_CHAR, etc.)
+    byte length;                  // Greatest length of the value, in characters
+    byte cursorPosition;          // Position of the cursor within the visible part of the value
+    byte virtualCursorPosition;   // Position of the cursor within the whole value
+    char valueString[GEM_STR_LEN];  // Text representation of the value being edited (visible part of it for GEM_VAL_STRING, see getText())
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    struct JournalEntry {
+      byte position;              // Position of the changed character
+      char character;             // New value of the character
+    };
+    JournalEntry journal[GEM_EDIT_JOURNAL_LEN];  // Changes made to GEM_VAL_STRING variable, applied to it on save
+    byte journalLength;
+    byte stringLength;            // Length of GEM_VAL_STRING variable before the edit
+    #endif
+    int selectNum;                // Index of the selected option of option select (-1 while not editing)
+    long number;                  // Value of the integer or fixed-point variable being edited, parsed on every change of the character
+    #ifdef GEM_SUPPORT_FLOAT_EDIT
+    double numberFloat;           // Value of the float or double variable being edited, parsed on every change of the character
+    #endif
+    byte status;                  // Status of parsing of the edited value (GEM_PARSE_OK, GEM_PARSE_INVALID, GEM_PARSE_RANGE)
+    bool error;                   // Malformed value is shown inverted after attempt to save it, until the next key press
+    char charAt(byte position);   // Get character of the value, with the changes made to GEM_VAL_STRING variable applied
+    void parse();
+    bool isSigned();
+    bool isDecimal();
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    bool journalChange(char character);
+    #endif
+    static char* trimString(char* str);
+};
+
+#endif
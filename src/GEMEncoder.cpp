@@ -0,0 +1,111 @@
+/*
+  GEMEncoder - interrupt-driven rotary encoder input with velocity-based acceleration for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMEncoder.h"
+
+// Change of the position (in quadrature state changes) for each pair of previous and current levels of pins A and B,
+// invalid transitions (both pins changed, e.g. due to contact bounce) are ignored
+static const int8_t encoderTransitions[16] PROGMEM = {
+   0, -1,  1,  0,
+   1,  0,  0, -1,
+  -1,  0,  0,  1,
+   0,  1, -1,  0
+};
+
+GEMEncoder::GEMEncoder(byte pinA_, byte pinB_, byte stepsPerDetent_)
+  : _pinA(pinA_)
+  , _pinB(pinB_)
+  , _stepsPerDetent(stepsPerDetent_)
+  , _state(0)
+  , _transitions(0)
+  , _detentInterval(255)
+  , _detentTime(0)
+  , _steps(0)
+{ }
+
+void GEMEncoder::begin() {
+  pinMode(_pinA, INPUT_PULLUP);
+  pinMode(_pinB, INPUT_PULLUP);
+  _state = (digitalRead(_pinA) << 1) | digitalRead(_pinB);
+}
+
+void GEMEncoder::setAcceleration(byte interval, byte multiplierMax) {
+  _accelInterval = interval;
+  _accelMultiplierMax = (multiplierMax > 0) ? multiplierMax : 1;
+}
+
+void GEMEncoder::update() {
+  update(digitalRead(_pinA) == HIGH, digitalRead(_pinB) == HIGH);
+}
+
+void GEMEncoder::update(bool a, bool b) {
+  byte state = (a << 1) | b;
+  _transitions += (int8_t)pgm_read_byte(&encoderTransitions[(_state << 2) | state]);
+  _state = state;
+  if (_transitions >= (int8_t)_stepsPerDetent) {
+    _transitions = 0;
+    registerDetent(1);
+  } else if (_transitions <= -(int8_t)_stepsPerDetent) {
+    _transitions = 0;
+    registerDetent(-1);
+  }
+}
+
+void GEMEncoder::registerDetent(int8_t direction) {
+  unsigned long time = millis();
+  unsigned long interval = time - _detentTime;
+  _detentTime = time;
+  if (interval >= _accelInterval) {
+    // Slow rotation (or first detent after a pause) resets the estimate, so that it starts without acceleration
+    _detentInterval = (interval < 255) ? interval : 255;
+  } else {
+    // Exponential moving average of the interval smooths out uneven spacing of the detents
+    _detentInterval = ((unsigned int)_detentInterval * 3 + interval) >> 2;
+  }
+  byte multiplier = 1;
+  if (_detentInterval < _accelInterval) {
+    multiplier += (unsigned int)(_accelMultiplierMax - 1) * (_accelInterval - _detentInterval) / _accelInterval;
+  }
+  int steps = _steps + direction * multiplier;
+  _steps = (steps > 127) ? 127 : ((steps < -127) ? -127 : steps);
+}
+
+int8_t GEMEncoder::read() {
+  noInterrupts();
+  int8_t steps = _steps;
+  _steps = 0;
+  interrupts();
+  return steps;
+}
@@ -0,0 +1,74 @@
+/*
+  GEMEncoder - interrupt-driven rotary encoder input with velocity-based acceleration for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMENCODER
+#define HEADER_GEMENCODER
+
+#include <Arduino.h>
+
+// Declaration of GEMEncoder class
+// Quadrature decoder: update() is called from interrupt service routine (pin change of either encoder pin),
+// accumulated steps are taken from the main loop with read(). Fast rotation is accelerated: each detent
+// counts as several steps depending on the (smoothed) time between consecutive detents
+class GEMEncoder {
+  public:
+    /* 
+      @param 'pinA_' - pin encoder's output A is connected to
+      @param 'pinB_' - pin encoder's output B is connected to
+      @param 'stepsPerDetent_' (optional) - number of quadrature state changes per detent (click) of the encoder
+      values 1, 2, 4
+      default 4
+    */
+    GEMEncoder(byte pinA_, byte pinB_, byte stepsPerDetent_ = 4);
+    void begin();                                  // Set up pins (with internal pull-up resistors) and read initial state of the encoder
+    void setAcceleration(byte interval, byte multiplierMax);  // Set acceleration: detents following each other faster than interval (in ms) count as up to multiplierMax steps
+                                                   // (multiplierMax of 1 disables acceleration, default is 50 ms and 8 steps)
+    void update();                                 // Read encoder pins and decode rotation, safe to call from interrupt service routine
+    void update(bool a, bool b);                   // Decode rotation from the supplied levels of encoder pins (e.g. read directly from port register)
+    int8_t read();                                 // Get number of steps accumulated since the previous call (positive for clockwise rotation) and reset the counter
+  private:
+    byte _pinA;
+    byte _pinB;
+    byte _stepsPerDetent;
+    byte _accelInterval = 50;
+    byte _accelMultiplierMax = 8;
+    byte _state;                    // Previous levels of pins A and B (modified by update() only)
+    int8_t _transitions;            // Quadrature state changes since the last detent (modified by update() only)
+    byte _detentInterval;           // Smoothed time between detents, in ms (modified by update() only)
+    unsigned long _detentTime;      // Value of millis() at the last detent (modified by update() only)
+    volatile int8_t _steps;         // Steps accumulated since the last read()
+    void registerDetent(int8_t direction);
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*
+  GEMFootprint - memory footprint report of the menu configuration for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMFootprint.h"
+
+void GEMFootprint::measure(GEMPage& root) {
+  GEMPage* path[GEM_SNAPSHOT_MAX_DEPTH];
+  measurePage(&root, path, 0);
+}
+
+size_t GEMFootprint::total() {
+  return pagesBytes + itemsBytes + selectsBytes + optionsBytes + stringsBytes + titlesBytes + rendererBytes;
+}
+
+void GEMFootprint::measurePage(GEMPage* page, GEMPage** path, byte depth) {
+  path[depth] = page;
+  pages++;
+  pagesBytes += sizeof(GEMPage);
+  titlesBytes += titleSize(page->title, page->titleProgmem);
+  for (GEMItem* menuItem = page->_menuItem; menuItem != nullptr; menuItem = menuItem->menuItemNext) {
+    if (menuItem->type == GEM_ITEM_BACK) {
+      continue; // Back button is a member of the menu page, its title is empty
+    }
+    measureMenuItem(menuItem);
+    // Pages are walked the same way as by GEMSnapshot: links back to the pages on the current path are not followed
+    if ((menuItem->type == GEM_ITEM_LINK || menuItem->type == GEM_ITEM_LINKED_VAL) && menuItem->linkedPage != nullptr && depth + 1 < GEM_SNAPSHOT_MAX_DEPTH) {
+      bool onPath = false;
+      for (byte i = 0; i <= depth; i++) {
+        onPath = onPath || path[i] == menuItem->linkedPage;
+      }
+      if (!onPath) {
+        measurePage(menuItem->linkedPage, path, depth + 1);
+      }
+    }
+  }
+}
+
+void GEMFootprint::measureMenuItem(GEMItem* menuItem) {
+  items++;
+  itemsBytes += sizeof(GEMItem);
+  titlesBytes += titleSize(menuItem->title, menuItem->titleProgmem);
+  if (menuItem->type != GEM_ITEM_VAL && menuItem->type != GEM_ITEM_LINKED_VAL) {
+    return;
+  }
+  switch (menuItem->linkedType) {
+    case GEM_VAL_CHAR:
+    case GEM_VAL_STRING:
+      stringsBytes += menuItem->getValueSize();
+      break;
+    case GEM_VAL_SELECT:
+      if (selects == 0) {
+        selectsBytes += sizeof(GEMSelect::_optionName);
+      }
+      selects++;
+      selectsBytes += sizeof(GEMSelect);
+      optionsBytes += menuItem->select->getOptionsSize();
+      break;
+  }
+}
+
+size_t GEMFootprint::titleSize(const char* title, bool progmem) {
+  return (title != nullptr && !progmem) ? strlen(title) + 1 : 0; // Titles stored in flash memory don't take RAM
+}
@@ -0,0 +1,81 @@
+/*
+  GEMFootprint - memory footprint report of the menu configuration for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMFOOTPRINT
+#define HEADER_GEMFOOTPRINT
+
+#include <Arduino.h>
+#include "GEMPage.h"
+#include "GEMItem.h"
+#include "GEMSelect.h"
+#include "constants.h"
+
+// Declaration of GEMFootprint class
+// Memory taken by the menu configuration: estimate() gives size of the menu objects at compile time (e.g. for static_assert),
+// measure() walks the actual tree of menu pages and sums sizes of the objects along with the data they refer to
+class GEMFootprint {
+  public:
+    /* 
+      Size (in bytes) of the menu objects, without the data they refer to
+      @param 'pages' - number of menu pages
+      @param 'items' - number of menu items
+      @param 'selects' (optional) - number of option selects
+    */
+    static constexpr size_t estimate(unsigned int pages, unsigned int items, unsigned int selects = 0) {
+      return pages * sizeof(GEMPage) + items * sizeof(GEMItem) + selects * sizeof(GEMSelect);
+    }
+    void measure(GEMPage& root);                    // Add memory taken by menu pages reachable from the root menu page, along with their menu items,
+                                                    // option selects (and their options), linked char arrays and titles
+    template <typename T>
+    void measureRenderer(T& menu) {                 // Add memory taken by the renderer object (GEM or GEM_u8g2), including edit buffers and layout
+      rendererBytes += sizeof(menu);
+    }
+    size_t total();                                 // Get total size of the measured memory, in bytes
+    unsigned int pages = 0;                         // Number of menu pages
+    unsigned int items = 0;                         // Number of menu items (Back buttons are part of the menu page)
+    unsigned int selects = 0;                       // Number of option selects (counted for each menu item it is used by)
+    size_t pagesBytes = 0;                          // Size of GEMPage objects
+    size_t itemsBytes = 0;                          // Size of GEMItem objects
+    size_t selectsBytes = 0;                        // Size of GEMSelect objects (and of the shared buffer of option labels)
+    size_t optionsBytes = 0;                        // Size of the options of option selects kept in RAM (option arrays with their labels, ranges, providers)
+    size_t stringsBytes = 0;                        // Size of the char arrays linked to menu items
+    size_t titlesBytes = 0;                         // Size of the titles of menu pages and menu items kept in RAM
+    size_t rendererBytes = 0;                       // Size of the renderer object
+  private:
+    void measurePage(GEMPage* page, GEMPage** path, byte depth);
+    void measureMenuItem(GEMItem* menuItem);
+    static size_t titleSize(const char* title, bool progmem);
+};
+
+#endif
@@ -0,0 +1,310 @@
+/*
+  GEMFormat - conversion of numeric values to and from strings for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMFormat.h"
+
+// Powers of 10 used to scale fractional part of the floating-point value
+static const uint32_t powersOf10[GEM_FORMAT_MAX_PREC + 1] PROGMEM = {
+  1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+// Print digits of the value (at least 'minDigits' of them, padded with leading zeros) and return their count
+static byte formatDigits(unsigned long value, char* buffer, byte minDigits = 1) {
+  char digits[10];
+  byte count = 0;
+  // Division of 16-bit values is considerably cheaper on 8-bit MCUs, so switch to it as soon as possible
+  while (value > 0xFFFF) {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  }
+  unsigned int valueShort = value;
+  while (valueShort > 0 || count < minDigits) {
+    digits[count++] = '0' + valueShort % 10;
+    valueShort /= 10;
+  }
+  for (byte i = 0; i < count; i++) {
+    buffer[i] = digits[count - 1 - i];
+  }
+  return count;
+}
+
+byte GEMFormatUnsigned(unsigned long value, char* buffer) {
+  byte length = formatDigits(value, buffer);
+  buffer[length] = '\0';
+  return length;
+}
+
+byte GEMFormatInt(long value, char* buffer) {
+  byte length = 0;
+  unsigned long valueAbs = value;
+  if (value < 0) {
+    buffer[length++] = '-';
+    valueAbs = 0UL - valueAbs;
+  }
+  length += formatDigits(valueAbs, buffer + length);
+  buffer[length] = '\0';
+  return length;
+}
+
+// Count digits of the value
+static byte countDigits(unsigned long value) {
+  byte count = 1;
+  while (value >= 10) {
+    value /= 10;
+    count++;
+  }
+  return count;
+}
+
+// Append character to the buffer of the supplied size, unless it is full (the rest of the string is cut off then)
+static void putChar(char* buffer, byte size, byte& length, char c) {
+  if (length + 1 < size) {
+    buffer[length++] = c;
+  }
+}
+
+static void putDigits(char* buffer, byte size, byte& length, unsigned long value, byte minDigits = 1) {
+  char digits[10];
+  byte count = formatDigits(value, digits, minDigits);
+  for (byte i = 0; i < count; i++) {
+    putChar(buffer, size, length, digits[i]);
+  }
+}
+
+byte GEMFormatFloat(double value, byte precision, char* buffer, byte size) {
+  byte length = 0;
+  if (size == 0) {
+    return 0;
+  }
+  // Special values are printed the same way Print::print() does
+  const char* special = isnan(value) ? "nan" : (isinf(value) ? "inf" : nullptr);
+  if (special != nullptr) {
+    while (*special != '\0') {
+      putChar(buffer, size, length, *special++);
+    }
+    buffer[length] = '\0';
+    return length;
+  }
+  if (precision > GEM_FORMAT_MAX_PREC) {
+    precision = GEM_FORMAT_MAX_PREC;
+  }
+  bool negative = value < 0;
+  if (negative) {
+    value = -value;
+  }
+  // Values beyond the range of unsigned long are printed in exponent form, with mantissa scaled down to [1, 10)
+  bool exponentForm = value > 4294967040.0;
+  unsigned int exponent = 0;
+  if (exponentForm) {
+    while (value >= 10) {
+      value /= 10;
+      exponent++;
+    }
+  }
+  unsigned long integerPart;
+  unsigned long fractionalPart;
+  bool minus;
+  while (true) {
+    unsigned long scale = pgm_read_dword(&powersOf10[precision]);
+    integerPart = (unsigned long)value;
+    fractionalPart = (unsigned long)((value - integerPart) * scale + 0.5);
+    // Rounding of the fractional part may carry over to the integer part
+    if (fractionalPart >= scale) {
+      fractionalPart -= scale;
+      integerPart++;
+    }
+    if (exponentForm && integerPart == 10) {
+      integerPart = 1;
+      exponent++;
+    }
+    // Minus sign is omitted for values that are rounded to zero
+    minus = negative && (integerPart > 0 || fractionalPart > 0);
+    // Precision is reduced (and value rounded anew) until the value fits the buffer
+    byte required = minus + countDigits(integerPart) + (precision > 0 ? precision + 1 : 0) + (exponentForm ? countDigits(exponent) + 1 : 0);
+    if (required < size || precision == 0) {
+      break;
+    }
+    precision = (required - (size - 1) < precision) ? precision - (required - (size - 1)) : 0;
+  }
+  if (minus) {
+    putChar(buffer, size, length, '-');
+  }
+  putDigits(buffer, size, length, integerPart);
+  if (precision > 0) {
+    putChar(buffer, size, length, '.');
+    putDigits(buffer, size, length, fractionalPart, precision);
+  }
+  if (exponentForm) {
+    putChar(buffer, size, length, 'e');
+    putDigits(buffer, size, length, exponent);
+  }
+  buffer[length] = '\0';
+  return length;
+}
+
+byte GEMFormatFixed(long value, byte decimals, char* buffer) {
+  if (decimals > GEM_FORMAT_MAX_PREC) {
+    decimals = GEM_FORMAT_MAX_PREC;
+  }
+  byte length = 0;
+  unsigned long valueAbs = value;
+  if (value < 0) {
+    buffer[length++] = '-';
+    valueAbs = 0UL - valueAbs;
+  }
+  byte count = formatDigits(valueAbs, buffer + length, decimals + 1);
+  if (decimals > 0) {
+    // Shift digits of the fractional part to make room for the decimal sign
+    char* point = buffer + length + count - decimals;
+    memmove(point + 1, point, decimals);
+    *point = '.';
+    count++;
+  }
+  length += count;
+  buffer[length] = '\0';
+  return length;
+}
+
+static const char* skipSpaces(const char* str) {
+  while (*str == ' ') {
+    str++;
+  }
+  return str;
+}
+
+// Parse optionally signed decimal number, scaling it by 10^decimals (decimal sign is accepted only if decimals > 0)
+static byte parseScaled(const char* str, byte decimals, long min, long max, long& value) {
+  const char* p = skipSpaces(str);
+  bool negative = (*p == '-');
+  if (negative) {
+    p++;
+  }
+  unsigned long magnitude = 0;
+  bool digits = false;
+  bool fraction = false;
+  bool overflow = false;
+  byte fractionDigits = 0;
+  for (; (*p >= '0' && *p <= '9') || *p == '.'; p++) {
+    if (*p == '.') {
+      if (fraction || decimals == 0) {
+        return GEM_PARSE_INVALID;
+      }
+      fraction = true;
+      continue;
+    }
+    byte digit = *p - '0';
+    digits = true;
+    if (fraction) {
+      if (fractionDigits == decimals) {
+        // Trailing zeros beyond the precision are harmless, any other digit can't be represented
+        if (digit != 0) {
+          return GEM_PARSE_INVALID;
+        }
+        continue;
+      }
+      fractionDigits++;
+    }
+    if (magnitude > (0xFFFFFFFFUL - digit) / 10) {
+      overflow = true;
+    } else {
+      magnitude = magnitude * 10 + digit;
+    }
+  }
+  if (*skipSpaces(p) != '\0' || ((negative || fraction) && !digits)) {
+    return GEM_PARSE_INVALID;
+  }
+  for (; fractionDigits < decimals; fractionDigits++) {
+    if (magnitude > 0xFFFFFFFFUL / 10) {
+      overflow = true;
+    } else {
+      magnitude *= 10;
+    }
+  }
+  if (overflow) {
+    return GEM_PARSE_RANGE;
+  }
+  // Compare magnitudes rather than signed values, so that neither of them overflows
+  if (negative && magnitude > 0) {
+    if (min >= 0 || magnitude - 1 > (unsigned long)(-(min + 1))) {
+      return GEM_PARSE_RANGE;
+    }
+    value = -(long)(magnitude - 1) - 1;
+  } else {
+    if (max < 0 || magnitude > (unsigned long)max || (min > 0 && magnitude < (unsigned long)min)) {
+      return GEM_PARSE_RANGE;
+    }
+    value = magnitude;
+  }
+  return GEM_PARSE_OK;
+}
+
+byte GEMParseInt(const char* str, long min, long max, long& value) {
+  return parseScaled(str, 0, min, max, value);
+}
+
+byte GEMParseFixed(const char* str, byte decimals, long min, long max, long& value) {
+  return parseScaled(str, decimals, min, max, value);
+}
+
+byte GEMParseFloat(const char* str, double& value) {
+  const char* p = skipSpaces(str);
+  bool negative = (*p == '-');
+  if (negative) {
+    p++;
+  }
+  double mantissa = 0;
+  double scale = 1;
+  bool digits = false;
+  bool fraction = false;
+  for (; (*p >= '0' && *p <= '9') || *p == '.'; p++) {
+    if (*p == '.') {
+      if (fraction) {
+        return GEM_PARSE_INVALID;
+      }
+      fraction = true;
+    } else {
+      mantissa = mantissa * 10 + (*p - '0');
+      if (fraction) {
+        scale *= 10;
+      }
+      digits = true;
+    }
+  }
+  if (*skipSpaces(p) != '\0' || ((negative || fraction) && !digits)) {
+    return GEM_PARSE_INVALID;
+  }
+  value = negative ? -mantissa / scale : mantissa / scale;
+  return GEM_PARSE_OK;
+}
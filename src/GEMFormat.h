@@ -0,0 +1,95 @@
+/*
+  GEMFormat - conversion of numeric values to and from strings for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMFORMAT
+#define HEADER_GEMFORMAT
+
+#include <Arduino.h>
+
+// Macro constant (alias) for the greatest supported precision of the float and double variables
+// (the number of digits after the decimal sign is limited by the range of unsigned long used during conversion)
+#define GEM_FORMAT_MAX_PREC 9
+
+/* 
+  Conversion of numeric values to strings, written straight into the supplied buffer (no intermediate buffers or heap).
+  Replaces itoa() and dtostrf(), so float printf machinery isn't pulled into the sketch.
+  @param 'value' - value to convert
+  @param 'buffer' - buffer the '\0'-terminated string is written to (should be big enough to hold the result)
+  @param 'precision' - number of digits after the decimal sign (for float and double values)
+  @param 'size' - size of the buffer (for float and double values, precision is reduced as needed for the value to fit,
+  values beyond the range of unsigned long are printed in exponent form, e.g. "1.5e12")
+  @return length of the string written to buffer (excluding '\0')
+*/
+byte GEMFormatInt(long value, char* buffer);
+byte GEMFormatUnsigned(unsigned long value, char* buffer);
+byte GEMFormatFloat(double value, byte precision, char* buffer, byte size);
+/* 
+  Conversion of fixed-point decimal value to string using integer arithmetic only (e.g. value 1250 with 2 decimals is printed as "12.50")
+  @param 'value' - value to convert, scaled by 10^decimals
+  @param 'decimals' - number of digits after the decimal sign (up to GEM_FORMAT_MAX_PREC)
+  @param 'buffer' - buffer the '\0'-terminated string is written to
+  @return length of the string written to buffer (excluding '\0')
+*/
+byte GEMFormatFixed(long value, byte decimals, char* buffer);
+
+// Macro constants (aliases) for the status of the conversion of the string to number
+#define GEM_PARSE_OK 0       // String holds valid number within the allowed range
+#define GEM_PARSE_INVALID 1  // String is malformed (e.g. minus sign, decimal sign or space in the middle of the number)
+#define GEM_PARSE_RANGE 2    // Number is out of the allowed range (e.g. greater than 255 for byte variable)
+
+/* 
+  Conversion of strings (as produced by the edit mode of menu item) to numeric values.
+  Leading and trailing spaces are ignored, string consisting of spaces only is treated as 0.
+  @param 'str' - '\0'-terminated string to convert
+  @param 'min' - smallest allowed value (for integer values)
+  @param 'max' - greatest allowed value (for integer values)
+  @param 'value' - variable to store the result of conversion in (left unchanged if conversion failed)
+  @return status of conversion
+  values GEM_PARSE_OK, GEM_PARSE_INVALID, GEM_PARSE_RANGE
+*/
+byte GEMParseInt(const char* str, long min, long max, long& value);
+byte GEMParseFloat(const char* str, double& value);
+/* 
+  Conversion of string to fixed-point decimal value using integer arithmetic only (e.g. "12.5" with 2 decimals results in 1250)
+  @param 'str' - '\0'-terminated string to convert
+  @param 'decimals' - number of digits after the decimal sign (more significant digits after the decimal sign make string malformed)
+  @param 'min' - smallest allowed value (scaled by 10^decimals)
+  @param 'max' - greatest allowed value (scaled by 10^decimals)
+  @param 'value' - variable to store the result of conversion in (left unchanged if conversion failed)
+  @return status of conversion
+  values GEM_PARSE_OK, GEM_PARSE_INVALID, GEM_PARSE_RANGE
+*/
+byte GEMParseFixed(const char* str, byte decimals, long min, long max, long& value);
+
+#endif
@@ -34,149 +34,152 @@
 
 #include <Arduino.h>
 #include "GEMItem.h"
+#include "GEMSelect.h"
 #include "constants.h"
 
+#ifdef GEM_SUPPORT_SELECT
 GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, GEMSelect& select_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
   , select(&select_)
   , saveAction(saveAction_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, int& linkedVariable_, GEMSelect& select_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
   , select(&select_)
   , saveAction(saveAction_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, char* linkedVariable_, GEMSelect& select_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
   , select(&select_)
   , saveAction(saveAction_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, float& linkedVariable_, GEMSelect& select_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
   , select(&select_)
   , saveAction(saveAction_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, double& linkedVariable_, GEMSelect& select_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
   , select(&select_)
   , saveAction(saveAction_)
-  , type(GEM_ITEM_VAL)
 { }
 
 //---
 
 GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, GEMSelect& select_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
-  , select(&select_)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
+  , select(&select_)
 { }
 
 GEMItem::GEMItem(const char* const title_, int& linkedVariable_, GEMSelect& select_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
-  , select(&select_)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
+  , select(&select_)
 { }
 
 GEMItem::GEMItem(const char* const title_, char* linkedVariable_, GEMSelect& select_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
-  , select(&select_)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
+  , select(&select_)
 { }
 
 GEMItem::GEMItem(const char* const title_, float& linkedVariable_, GEMSelect& select_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
-  , select(&select_)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
+  , select(&select_)
 { }
 
 GEMItem::GEMItem(const char* const title_, double& linkedVariable_, GEMSelect& select_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_SELECT)
-  , select(&select_)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
+  , select(&select_)
 { }
+#endif
 
 //---
 
 GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_BYTE)
-  , type(GEM_ITEM_VAL)
   , saveAction(saveAction_)
 { }
 
 GEMItem::GEMItem(const char* const title_, int& linkedVariable_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_INTEGER)
-  , type(GEM_ITEM_VAL)
   , saveAction(saveAction_)
 { }
 
 GEMItem::GEMItem(const char* const title_, char* linkedVariable_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(linkedVariable_)
   , linkedType(GEM_VAL_CHAR)
-  , type(GEM_ITEM_VAL)
   , saveAction(saveAction_)
 { }
 
 GEMItem::GEMItem(const char* const title_, bool& linkedVariable_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_BOOL)
-  , type(GEM_ITEM_VAL)
   , saveAction(saveAction_)
 { }
 
 GEMItem::GEMItem(const char* const title_, float& linkedVariable_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_FLOAT)
   , precision(GEM_FLOAT_PREC)
-  , type(GEM_ITEM_VAL)
   , saveAction(saveAction_)
 { }
 
 GEMItem::GEMItem(const char* const title_, double& linkedVariable_, void (*saveAction_)())
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_DOUBLE)
   , precision(GEM_DOUBLE_PREC)
-  , type(GEM_ITEM_VAL)
   , saveAction(saveAction_)
 { }
 
@@ -184,115 +187,178 @@ GEMItem::GEMItem(const char* const title_, double& linkedVariable_, void (*saveA
 
 GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_BYTE)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, int& linkedVariable_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_INTEGER)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, char* linkedVariable_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(linkedVariable_)
   , linkedType(GEM_VAL_CHAR)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, bool& linkedVariable_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_BOOL)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, float& linkedVariable_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_FLOAT)
   , precision(GEM_FLOAT_PREC)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(const char* const title_, double& linkedVariable_, bool readonly_)
   : title(title_)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_DOUBLE)
   , precision(GEM_DOUBLE_PREC)
   , readonly(readonly_)
+{ }
+
+//---
+
+#ifdef GEM_SUPPORT_FIXED_POINT
+GEMItem::GEMItem(const char* const title_, int16_t& linkedVariable_, const FixedPointFormat& format_, void (*saveAction_)())
+  : title(title_)
+  , type(GEM_ITEM_VAL)
+  , linkedVariable(&linkedVariable_)
+  , linkedType(GEM_VAL_FIXED16)
+  , fixedPoint(&format_)
+  , saveAction(saveAction_)
+{ }
+
+GEMItem::GEMItem(const char* const title_, int32_t& linkedVariable_, const FixedPointFormat& format_, void (*saveAction_)())
+  : title(title_)
+  , type(GEM_ITEM_VAL)
+  , linkedVariable(&linkedVariable_)
+  , linkedType(GEM_VAL_FIXED32)
+  , fixedPoint(&format_)
+  , saveAction(saveAction_)
+{ }
+
+GEMItem::GEMItem(const char* const title_, int16_t& linkedVariable_, const FixedPointFormat& format_, bool readonly_)
+  : title(title_)
+  , type(GEM_ITEM_VAL)
+  , linkedVariable(&linkedVariable_)
+  , linkedType(GEM_VAL_FIXED16)
+  , readonly(readonly_)
+  , fixedPoint(&format_)
+{ }
+
+GEMItem::GEMItem(const char* const title_, int32_t& linkedVariable_, const FixedPointFormat& format_, bool readonly_)
+  : title(title_)
   , type(GEM_ITEM_VAL)
+  , linkedVariable(&linkedVariable_)
+  , linkedType(GEM_VAL_FIXED32)
+  , readonly(readonly_)
+  , fixedPoint(&format_)
 { }
+#endif
+
+//---
+
+#ifdef GEM_SUPPORT_STRING_BUFFER
+GEMItem::GEMItem(const char* const title_, const StringBuffer& buffer_, void (*saveAction_)())
+  : title(title_)
+  , type(GEM_ITEM_VAL)
+  , linkedVariable(buffer_.value)
+  , linkedType(GEM_VAL_STRING)
+  , precision(buffer_.capacity)
+  , saveAction(saveAction_)
+{ }
+
+GEMItem::GEMItem(const char* const title_, const StringBuffer& buffer_, bool readonly_)
+  : title(title_)
+  , type(GEM_ITEM_VAL)
+  , linkedVariable(buffer_.value)
+  , linkedType(GEM_VAL_STRING)
+  , precision(buffer_.capacity)
+  , readonly(readonly_)
+{ }
+#endif
 
 //---
 
 GEMItem::GEMItem(byte& linkedVariable_, bool readonly_)
   : title(nullptr)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_BYTE)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(int& linkedVariable_, bool readonly_)
   : title(nullptr)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_INTEGER)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(char* linkedVariable_, bool readonly_)
   : title(nullptr)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(linkedVariable_)
   , linkedType(GEM_VAL_CHAR)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(bool& linkedVariable_, bool readonly_)
   : title(nullptr)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_BOOL)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(float& linkedVariable_, bool readonly_)
   : title(nullptr)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_FLOAT)
   , precision(GEM_FLOAT_PREC)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 GEMItem::GEMItem(double& linkedVariable_, bool readonly_)
   : title(nullptr)
+  , type(GEM_ITEM_VAL)
   , linkedVariable(&linkedVariable_)
   , linkedType(GEM_VAL_DOUBLE)
   , precision(GEM_DOUBLE_PREC)
   , readonly(readonly_)
-  , type(GEM_ITEM_VAL)
 { }
 
 //---
 
+#ifdef GEM_SUPPORT_LINKED_VALUE
 GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, GEMPage* linkedPage_)
   : title(title_)
+  , type(GEM_ITEM_LINKED_VAL)
   , linkedVariable(&linkedVariable_)
-  , linkedPage(linkedPage_)
   , linkedType(GEM_VAL_BYTE)
   , readonly(false)
-  , type(GEM_ITEM_LINKED_VAL)
+  , linkedPage(linkedPage_)
 { }
 
 GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, GEMPage& linkedPage_)
@@ -301,11 +367,11 @@ GEMItem::GEMItem(const char* const title_, byte& linkedVariable_, GEMPage& linke
 
 GEMItem::GEMItem(const char* const title_, int& linkedVariable_, GEMPage* linkedPage_)
   : title(title_)
+  , type(GEM_ITEM_LINKED_VAL)
   , linkedVariable(&linkedVariable_)
-  , linkedPage(linkedPage_)
   , linkedType(GEM_VAL_INTEGER)
   , readonly(false)
-  , type(GEM_ITEM_LINKED_VAL)
+  , linkedPage(linkedPage_)
 { }
 
 GEMItem::GEMItem(const char* const title_, int& linkedVariable_, GEMPage& linkedPage_)
@@ -314,11 +380,11 @@ GEMItem::GEMItem(const char* const title_, int& linkedVariable_, GEMPage& linked
 
 GEMItem::GEMItem(const char* const title_, char* linkedVariable_, GEMPage* linkedPage_)
   : title(title_)
+  , type(GEM_ITEM_LINKED_VAL)
   , linkedVariable(linkedVariable_)
-  , linkedPage(linkedPage_)
   , linkedType(GEM_VAL_CHAR)
   , readonly(false)
-  , type(GEM_ITEM_LINKED_VAL)
+  , linkedPage(linkedPage_)
 { }
 
 GEMItem::GEMItem(const char* const title_, char* linkedVariable_, GEMPage& linkedPage_)
@@ -327,11 +393,11 @@ GEMItem::GEMItem(const char* const title_, char* linkedVariable_, GEMPage& linke
 
 GEMItem::GEMItem(const char* const title_, bool& linkedVariable_, GEMPage* linkedPage_)
   : title(title_)
+  , type(GEM_ITEM_LINKED_VAL)
   , linkedVariable(&linkedVariable_)
-  , linkedPage(linkedPage_)
   , linkedType(GEM_VAL_BOOL)
   , readonly(false)
-  , type(GEM_ITEM_LINKED_VAL)
+  , linkedPage(linkedPage_)
 { }
 
 GEMItem::GEMItem(const char* const title_, bool& linkedVariable_, GEMPage& linkedPage_)
@@ -340,12 +406,12 @@ GEMItem::GEMItem(const char* const title_, bool& linkedVariable_, GEMPage& linke
 
 GEMItem::GEMItem(const char* const title_, float& linkedVariable_, GEMPage* linkedPage_)
   : title(title_)
+  , type(GEM_ITEM_LINKED_VAL)
   , linkedVariable(&linkedVariable_)
-  , linkedPage(linkedPage_)
   , linkedType(GEM_VAL_FLOAT)
   , precision(GEM_FLOAT_PREC)
   , readonly(false)
-  , type(GEM_ITEM_LINKED_VAL)
+  , linkedPage(linkedPage_)
 { }
 
 
@@ -355,65 +421,78 @@ GEMItem::GEMItem(const char* const title_, float& linkedVariable_, GEMPage& link
 
 GEMItem::GEMItem(const char* const title_, double& linkedVariable_, GEMPage* linkedPage_)
   : title(title_)
+  , type(GEM_ITEM_LINKED_VAL)
   , linkedVariable(&linkedVariable_)
-  , linkedPage(linkedPage_)
   , linkedType(GEM_VAL_DOUBLE)
   , precision(GEM_DOUBLE_PREC)
   , readonly(false)
-  , type(GEM_ITEM_LINKED_VAL)
+  , linkedPage(linkedPage_)
 { }
 
 GEMItem::GEMItem(const char* const title_, double& linkedVariable_, GEMPage& linkedPage_)
   : GEMItem(title_, linkedVariable_, &linkedPage_) // call GEMItem* constructor
 { }
+#endif
 
 //---
 
 GEMItem::GEMItem(const char* const title_, GEMPage& linkedPage_, bool readonly_)
   : title(title_)
-  , linkedPage(&linkedPage_)
-  , readonly(readonly_)
   , type(GEM_ITEM_LINK)
+  , readonly(readonly_)
+  , linkedPage(&linkedPage_)
 { }
 
 GEMItem::GEMItem(const char* const title_, GEMPage* linkedPage_, bool readonly_)
   : title(title_)
-  , linkedPage(linkedPage_)
-  , readonly(readonly_)
   , type(GEM_ITEM_LINK)
+  , readonly(readonly_)
+  , linkedPage(linkedPage_)
 { }
 
+#ifdef GEM_SUPPORT_BUTTON
 GEMItem::GEMItem(const char* const title_, void (*buttonAction_)(), bool readonly_)
   : title(title_)
-  , buttonAction(buttonAction_)
-  , readonly(readonly_)
   , type(GEM_ITEM_BUTTON)
+  , readonly(readonly_)
+  , buttonAction(buttonAction_)
 { }
+#endif
 
+#ifdef GEM_SUPPORT_CALLBACK_VALUE
 GEMItem::GEMItem(const char* const title_, const char* const (*getValueStr)(void))
   : title(title_)
-  , getValue(getValueStr)
+  , type(GEM_ITEM_VAL)
   , linkedType(GEM_VAL_CALLBACK)
   , readonly(true)
-  , type(GEM_ITEM_VAL)
+  , getValue(getValueStr)
 { }
 
 GEMItem::GEMItem(const char* const (*getValueStr)(void))
   : title(nullptr)
-  , getValue(getValueStr)
+  , type(GEM_ITEM_VAL)
   , linkedType(GEM_VAL_CALLBACK)
   , readonly(true)
-  , type(GEM_ITEM_VAL)
+  , getValue(getValueStr)
 { }
+#endif
 
+#ifdef GEM_SUPPORT_TEXT
 GEMItem::GEMItem(const char* const title_)
   : title(title_)
-  , readonly(true)
   , type(GEM_ITEM_TEXT)
+  , readonly(true)
 { }
+#endif
 
 void GEMItem::setTitle(const char* const title_) {
   title = title_;
+  titleProgmem = false;
+}
+
+void GEMItem::setTitle(const __FlashStringHelper* title_) {
+  title = reinterpret_cast<const char*>(title_);
+  titleProgmem = true;
 }
 
 const char* GEMItem::getTitle() {
@@ -460,6 +539,83 @@ bool GEMItem::getHidden() {
   return hidden;
 }
 
+void GEMItem::setId(byte id_) {
+  id = id_;
+}
+
+byte GEMItem::getId() {
+  return id;
+}
+
+byte GEMItem::getValueSize() {
+  if (type != GEM_ITEM_VAL && type != GEM_ITEM_LINKED_VAL) {
+    return 0;
+  }
+  switch (linkedType) {
+    case GEM_VAL_INTEGER:
+      return sizeof(int);
+    case GEM_VAL_BYTE:
+      return sizeof(byte);
+    case GEM_VAL_CHAR:
+      return GEM_STR_LEN;
+    case GEM_VAL_BOOL:
+      return sizeof(bool);
+    case GEM_VAL_SELECT:
+      return select->getValueSize();
+    case GEM_VAL_FLOAT:
+      return sizeof(float);
+    case GEM_VAL_DOUBLE:
+      return sizeof(double);
+    case GEM_VAL_FIXED16:
+      return sizeof(int16_t);
+    case GEM_VAL_FIXED32:
+      return sizeof(int32_t);
+    case GEM_VAL_STRING:
+      return precision;
+    default:
+      return 0;
+  }
+}
+
+void GEMItem::readValue(byte* data) {
+  if (linkedType == GEM_VAL_SELECT) {
+    // Option select is stored as value of the variable (or label of the selected option, for providers), rather than index of the option,
+    // so that stored value still restores the same option after options are added or reordered
+    select->readValue(linkedVariable, data);
+  } else {
+    memcpy(data, linkedVariable, getValueSize());
+  }
+}
+
+bool GEMItem::writeValue(const byte* data) {
+  byte size = getValueSize();
+  switch (linkedType) {
+    case GEM_VAL_SELECT:
+      {
+        int index = select->findValue(data);
+        if (index < 0) {
+          return false;
+        }
+        select->setValue(linkedVariable, index);
+      }
+      break;
+    case GEM_VAL_BOOL:
+      *(bool*)linkedVariable = data[0] != 0;
+      break;
+    case GEM_VAL_CHAR:
+    case GEM_VAL_STRING:
+      if (memchr(data, '\0', size) == nullptr) {
+        return false;
+      }
+      memcpy(linkedVariable, data, size);
+      break;
+    default:
+      memcpy(linkedVariable, data, size);
+      break;
+  }
+  return size > 0;
+}
+
 GEMItem* GEMItem::getMenuItemNext() {
   GEMItem* menuItemTmp = menuItemNext;
   while (menuItemTmp != 0 && menuItemTmp->hidden) {
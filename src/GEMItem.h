@@ -35,6 +35,7 @@
 #include <WString.h>     // for __FlashStringHelper (F("asd"))
 
 #include "GEMPage.h"
+#include "config.h"
 #include "constants.h"
 
 #ifndef HEADER_GEMITEM
@@ -57,13 +58,35 @@
 // Forward declaration of necessary classes
 class GEMPage;
 class GEMSelect;
+template <typename E, E... Values> class GEMSelectEnum;
+
+// Declaration of FixedPointFormat type (format of the fixed-point decimal variable, e.g. {2, " V"} for int16_t variable
+// with value 1250 displayed as "12.50 V")
+struct FixedPointFormat {
+  byte decimals;     // Number of digits after the decimal sign, i.e. variable holds value scaled by 10^decimals (up to 9)
+  const char* unit;  // Optional unit suffix printed after the value (not editable), or nullptr
+};
+
+// Declaration of StringBuffer type (character array of arbitrary capacity, e.g. {password, sizeof(password)})
+struct StringBuffer {
+  char* value;    // Pointer to '\0'-terminated character array
+  byte capacity;  // Size of the character array, including terminating '\0' (up to 255)
+};
 
 // Declaration of GEMItem class
 class GEMItem {
   friend class GEM;
   friend class GEM_u8g2;
   friend class GEMPage;
+  friend class GEMEdit;
+  friend class GEMRuntime;
+  friend class GEMPersist;
+  friend class GEMSnapshot;
+  friend class GEMRemote;
+  friend class GEMFootprint;
+  friend class GEMProfiler;
   public:
+    #ifdef GEM_SUPPORT_SELECT
     /* 
       Constructors for menu item that represents option select, w/ callback
       @param 'title_' - title of the menu item displayed on the screen
@@ -90,6 +113,35 @@ class GEMItem {
     GEMItem(const char* const title_, char* linkedVariable_, GEMSelect& select_, bool readonly_ = false);
     GEMItem(const char* const title_, float& linkedVariable_, GEMSelect& select_, bool readonly_ = false);
     GEMItem(const char* const title_, double& linkedVariable_, GEMSelect& select_, bool readonly_ = false);
+    /* 
+      Constructors for menu item that represents option select of enum variable (see GEMSelectEnum)
+      @param 'title_' - title of the menu item displayed on the screen
+      @param 'linkedVariable_' - reference to enum variable that menu item is associated with
+      @param 'select_' - reference to GEMSelectEnum option select of the same enum type (select of another type doesn't compile)
+      @param 'saveAction_' - pointer to callback function executed when associated variable is successfully saved
+      @param 'readonly_' (optional) - set readonly mode for variable that option select is associated with
+    */
+    template <typename E, E... Values>
+    GEMItem(const char* const title_, E& linkedVariable_, GEMSelectEnum<E, Values...>& select_, void (*saveAction_)())
+      : title(title_)
+      , type(GEM_ITEM_VAL)
+      , linkedVariable(&linkedVariable_)
+      , linkedType(GEM_VAL_SELECT)
+      , select(&select_)
+      , saveAction(saveAction_)
+    {
+    }
+    template <typename E, E... Values>
+    GEMItem(const char* const title_, E& linkedVariable_, GEMSelectEnum<E, Values...>& select_, bool readonly_ = false)
+      : title(title_)
+      , type(GEM_ITEM_VAL)
+      , linkedVariable(&linkedVariable_)
+      , linkedType(GEM_VAL_SELECT)
+      , readonly(readonly_)
+      , select(&select_)
+    {
+    }
+    #endif
     /* 
       Constructors for menu item that represents variable, w/ callback
       @param 'title_' - title of the menu item displayed on the screen
@@ -116,6 +168,42 @@ class GEMItem {
     GEMItem(const char* const title_, bool& linkedVariable_, bool readonly_ = false);
     GEMItem(const char* const title_, float& linkedVariable_, bool readonly_ = false);
     GEMItem(const char* const title_, double& linkedVariable_, bool readonly_ = false);
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    /* 
+      Constructors for menu item that represents fixed-point decimal variable (formatted, edited and parsed with integer arithmetic only,
+      hence available even if float support is disabled), w/ callback
+      @param 'title_' - title of the menu item displayed on the screen
+      @param 'linkedVariable_' - reference to variable that menu item is associated with (either int16_t or int32_t), holding value scaled by 10^decimals
+      @param 'format_' - reference to FixedPointFormat format of the variable
+      @param 'saveAction_' - pointer to callback function executed when associated variable is successfully saved
+    */
+    GEMItem(const char* const title_, int16_t& linkedVariable_, const FixedPointFormat& format_, void (*saveAction_)());
+    GEMItem(const char* const title_, int32_t& linkedVariable_, const FixedPointFormat& format_, void (*saveAction_)());
+    /* 
+      Constructors for menu item that represents fixed-point decimal variable, w/o callback
+      @param 'title_' - title of the menu item displayed on the screen
+      @param 'linkedVariable_' - reference to variable that menu item is associated with (either int16_t or int32_t), holding value scaled by 10^decimals
+      @param 'format_' - reference to FixedPointFormat format of the variable
+      @param 'readonly_' (optional) - set readonly mode for variable that menu item is associated with
+      values GEM_READONLY (alias for true)
+      default false
+    */
+    GEMItem(const char* const title_, int16_t& linkedVariable_, const FixedPointFormat& format_, bool readonly_ = false);
+    GEMItem(const char* const title_, int32_t& linkedVariable_, const FixedPointFormat& format_, bool readonly_ = false);
+    #endif
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    /* 
+      Constructors for menu item that represents string variable of arbitrary capacity (edited in place, without intermediate copy)
+      @param 'title_' - title of the menu item displayed on the screen
+      @param 'buffer_' - StringBuffer that describes character array menu item is associated with (array itself should outlive menu item)
+      @param 'saveAction_' - pointer to callback function executed when associated variable is successfully saved
+      @param 'readonly_' (optional) - set readonly mode for variable that menu item is associated with
+      values GEM_READONLY (alias for true)
+      default false
+    */
+    GEMItem(const char* const title_, const StringBuffer& buffer_, void (*saveAction_)());
+    GEMItem(const char* const title_, const StringBuffer& buffer_, bool readonly_ = false);
+    #endif
     /* 
       Constructors for menu item that represents variable, w/o callback and without title (so they can be displayed over the whole width of the screen)
       @param 'linkedVariable_' - reference to variable that menu item is associated with (either byte, int, char*, bool, float, or double)
@@ -129,6 +217,7 @@ class GEMItem {
     GEMItem(bool& linkedVariable_, bool readonly_ = false);
     GEMItem(float& linkedVariable_, bool readonly_ = false);
     GEMItem(double& linkedVariable_, bool readonly_ = false);
+    #ifdef GEM_SUPPORT_LINKED_VALUE
     /* 
       Constructors for menu item that represents variable, that are linked to another screen
       @param 'title_' - title of the menu item displayed on the screen
@@ -147,6 +236,7 @@ class GEMItem {
     GEMItem(const char* const title_, float& linkedVariable_, GEMPage& linkedPage_);
     GEMItem(const char* const title_, double& linkedVariable_, GEMPage* linkedPage_);
     GEMItem(const char* const title_, double& linkedVariable_, GEMPage& linkedPage_);
+    #endif
     /* 
       Constructor for menu item that represents link to another menu page (via reference)
       @param 'title_' - title of the menu item displayed on the screen
@@ -163,6 +253,7 @@ class GEMItem {
       values GEM_READONLY (alias for true)
     */
     GEMItem(const char* const title_, GEMPage* linkedPage_, bool readonly_ = false);
+    #ifdef GEM_SUPPORT_BUTTON
     /* 
       Constructor for menu item that represents button
       @param 'title_' - title of the menu item displayed on the screen
@@ -171,6 +262,8 @@ class GEMItem {
       values GEM_READONLY (alias for true)
     */
     GEMItem(const char* const title_, void (*buttonAction_)(), bool readonly_ = false);
+    #endif
+    #ifdef GEM_SUPPORT_CALLBACK_VALUE
     /* 
       Constructor for menu item that represents a string as value, that is generated by a function call,
       @param 'title_' - title of the menu item displayed on the screen
@@ -178,16 +271,31 @@ class GEMItem {
     */
     GEMItem(const char* const title_, const char* const (*getValueStr)(void));
     GEMItem(const char* const (*getValueStr)(void));
+    #endif
+    #ifdef GEM_SUPPORT_TEXT
     /* 
       Constructor for menu item that represents a single static string as text entry,
       @param 'title_' - title of the menu item displayed on the screen
     */
     GEMItem(const char* const title_);
+    #endif
+    /* 
+      Constructors for menu item with title stored in flash memory, e.g. GEMItem(F("Number:"), number), accept the same arguments
+      as the corresponding constructors above (title is read from flash while being drawn, without copy in RAM)
+      @param 'title_' - title of the menu item wrapped in F() macro
+    */
+    template <typename... Args>
+    GEMItem(const __FlashStringHelper* title_, Args&&... args)
+      : GEMItem(reinterpret_cast<const char*>(title_), static_cast<Args&&>(args)...)
+    {
+      titleProgmem = true;
+    }
 
 
     void setTitle(const char* const title_);            // Set title of the menu item
-    const char* getTitle();                       // Get title of the menu item
-    void setPrecision(byte prec);           // Explicitly set precision for float or double variables as required by dtostrf() conversion,
+    void setTitle(const __FlashStringHelper* title_);   // Set title of the menu item stored in flash memory (wrapped in F() macro)
+    const char* getTitle();                       // Get title of the menu item (pointer to flash memory if title is set with F() macro)
+    void setPrecision(byte prec);           // Explicitly set precision for float or double variables as required by GEMFormatFloat() conversion,
                                             // i.e. the number of digits after the decimal sign
     void setReadonly(bool mode = true);  // Explicitly set or unset readonly mode for variable that menu item is associated with
                                             // (relevant for GEM_VAL_INTEGER, GEM_VAL_BYTE, GEM_VAL_FLOAT, GEM_VAL_DOUBLE, GEM_VAL_CHAR,
@@ -197,21 +305,32 @@ class GEMItem {
     void hide(bool hide = true);         // Explicitly hide or show menu item
     void show();                            // Explicitly show menu item
     bool getHidden();                    // Get hidden state of the menu item
+    void setId(byte id_);                   // Set stable ID of the menu item (identifies value of associated variable in persistent storage, 0 means no ID)
+    byte getId();                           // Get stable ID of the menu item
+    byte getValueSize();                    // Get size (in bytes) of the value of associated variable in its stored form (0 if menu item has no value that can be stored)
+    void readValue(byte* data);             // Copy value of associated variable into data (getValueSize() bytes; for option select value of the variable,
+                                            // or label of the selected option if options are produced by SelectOptionProvider)
+    bool writeValue(const byte* data);      // Assign value stored in data (getValueSize() bytes) to associated variable, returns false if value is invalid
   private:
     const char* title;
     byte type;
-    void* linkedVariable;
+    void* linkedVariable = nullptr;
     byte linkedType;
-    byte precision = GEM_FLOAT_PREC;
+    byte precision = GEM_FLOAT_PREC;         // Precision of float or double variable, or capacity of GEM_VAL_STRING variable
     bool readonly = false;
     bool hidden = false;
-    GEMSelect* select;
+    bool titleProgmem = false;              // Title is stored in flash memory (PROGMEM)
+    byte id = 0;
+    union {
+      GEMSelect* select = nullptr;          // Option select of GEM_VAL_SELECT menu item
+      const FixedPointFormat* fixedPoint;   // Format of GEM_VAL_FIXED16 and GEM_VAL_FIXED32 menu item
+    };
     GEMPage* parentPage = nullptr;
-    GEMPage* linkedPage;
-    GEMItem* menuItemNext;
+    GEMPage* linkedPage = nullptr;
+    GEMItem* menuItemNext = nullptr;
     GEMItem* getMenuItemNext();             // Get next menu item, excluding hidden ones
-    void (*buttonAction)();
-    void (*saveAction)();
+    void (*buttonAction)() = nullptr;
+    void (*saveAction)() = nullptr;
     const char* const (*getValue)(void) = nullptr;
 };
   
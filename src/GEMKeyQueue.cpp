@@ -0,0 +1,87 @@
+/*
+  GEMKeyQueue - interrupt-safe queue of key presses for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMKeyQueue.h"
+
+GEMKeyQueue::GEMKeyQueue()
+  : _head(0)
+  , _tail(0)
+  , _dropped(0)
+{ }
+
+bool GEMKeyQueue::push(byte keyCode) {
+  byte head = _head;
+  // Indices wrap around at 256, which is a multiple of the queue length, so their difference is always the number of entries
+  if ((byte)(head - _tail) >= GEM_KEY_QUEUE_LEN) {
+    if (_dropped < 255) {
+      _dropped++;
+    }
+    return false;
+  }
+  GEMKeyEvent& event = _events[head & (GEM_KEY_QUEUE_LEN - 1)];
+  event.key = keyCode;
+  event.time = millis();
+  GEM_KEY_QUEUE_BARRIER();
+  _head = head + 1;
+  return true;
+}
+
+bool GEMKeyQueue::pop(GEMKeyEvent& event) {
+  byte tail = _tail;
+  if (tail == _head) {
+    return false;
+  }
+  GEM_KEY_QUEUE_BARRIER();
+  event = _events[tail & (GEM_KEY_QUEUE_LEN - 1)];
+  GEM_KEY_QUEUE_BARRIER();
+  _tail = tail + 1;
+  return true;
+}
+
+byte GEMKeyQueue::count() {
+  return _head - _tail;
+}
+
+bool GEMKeyQueue::isEmpty() {
+  return _head == _tail;
+}
+
+void GEMKeyQueue::clear() {
+  _tail = _head;
+}
+
+byte GEMKeyQueue::getDropped() {
+  return _dropped;
+}
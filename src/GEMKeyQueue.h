@@ -0,0 +1,75 @@
+/*
+  GEMKeyQueue - interrupt-safe queue of key presses for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMKEYQUEUE
+#define HEADER_GEMKEYQUEUE
+
+#include <Arduino.h>
+#include "constants.h"
+
+// Compiler (and, where required, hardware) barrier that keeps writes to the queue entry ordered before publishing of the index
+#ifdef __AVR__
+#define GEM_KEY_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define GEM_KEY_QUEUE_BARRIER() __sync_synchronize()
+#endif
+
+// Declaration of GEMKeyEvent type
+struct GEMKeyEvent {
+  byte key;            // Key code (GEM_KEY_UP, GEM_KEY_DOWN, etc.)
+  unsigned long time;  // Value of millis() at the moment key press was pushed to the queue
+};
+
+// Declaration of GEMKeyQueue class
+// Lock-free single-producer/single-consumer ring buffer: push() may be called from interrupt service routine,
+// while pop() is called from the main loop (one producer and one consumer at a time)
+class GEMKeyQueue {
+  public:
+    GEMKeyQueue();
+    bool push(byte keyCode);           // Add key press to the queue (with current millis() timestamp), returns false if queue is full
+    bool pop(GEMKeyEvent& event);      // Take the oldest key press from the queue, returns false if queue is empty
+    byte count();                      // Get number of key presses waiting in the queue
+    bool isEmpty();                    // Check if queue is empty
+    void clear();                      // Discard all key presses waiting in the queue (should not be called concurrently with push())
+    byte getDropped();                 // Get number of key presses dropped because queue was full (saturates at 255)
+  private:
+    static_assert(GEM_KEY_QUEUE_LEN > 0 && GEM_KEY_QUEUE_LEN <= 128 && (GEM_KEY_QUEUE_LEN & (GEM_KEY_QUEUE_LEN - 1)) == 0,
+                  "GEM_KEY_QUEUE_LEN should be power of two not greater than 128");
+    GEMKeyEvent _events[GEM_KEY_QUEUE_LEN];
+    volatile byte _head;      // Free-running index of the next entry to write (modified by producer only)
+    volatile byte _tail;      // Free-running index of the next entry to read (modified by consumer only)
+    volatile byte _dropped;
+};
+
+#endif
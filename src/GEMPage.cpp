@@ -37,11 +37,13 @@
 
 GEMPage::GEMPage(const char* const title_, void (*exitAction_)())
   : title(title_)
+  , titleProgmem(false)
   , exitAction(exitAction_)
 { }
 
 GEMPage::GEMPage(const __FlashStringHelper* title_, void (*exitAction_)())
     : title(reinterpret_cast<PGM_P>(title_))
+    , titleProgmem(true)
     , exitAction(exitAction_)
 { }
 
@@ -44,18 +44,21 @@ class GEMPage {
   friend class GEM;
   friend class GEM_u8g2;
   friend class GEMItem;
+  friend class GEMSnapshot;
+  friend class GEMFootprint;
   public:
     /* 
       @param 'title_' - title of the menu page displayed at top of the screen
       @param 'exitAction_' - pointer to callback function executed when GEM_KEY_CANCEL is pressed while being on top level menu page
     */
     GEMPage(const char* const title_ = "", void (*exitAction_)() = nullptr);
-    GEMPage(const __FlashStringHelper* title_ = F(""), void (*exitAction_)() = nullptr);
+    GEMPage(const __FlashStringHelper* title_, void (*exitAction_)() = nullptr);  // Title stored in flash memory (wrapped in F() macro) is read from flash while being drawn
     void addMenuItem(GEMItem& menuItem);              // Add menu item to menu page
     void setParentMenuPage(GEMPage& parentMenuPage);  // Specify parent level menu page (to know where to go back to when pressing Back button)
-    const char* const getTitle();                           // Get title of the menu page
+    const char* const getTitle();                           // Get title of the menu page (pointer to flash memory if title is set with F() macro)
   private:
     const char* const title;
+    const bool titleProgmem;                          // Title is stored in flash memory (PROGMEM)
     byte currentItemNum = 0;                          // Currently selected (focused) menu item of the page
     byte itemsCount = 0;                              // Items count excluding hidden ones
     byte itemsCountTotal = 0;                         // Items count incuding hidden ones
@@ -64,7 +67,7 @@ class GEMPage {
     int getMenuItemNum(GEMItem& menuItem);            // Find index of the supplied menu item
     void hideMenuItem(GEMItem& menuItem);
     void showMenuItem(GEMItem& menuItem);
-    GEMItem* _menuItem;                                         // First menu item of the page (the following ones are linked from within one another)
+    GEMItem* _menuItem = nullptr;                               // First menu item of the page (the following ones are linked from within one another)
     GEMItem _menuItemBack {"", static_cast<GEMPage*>(nullptr)}; // Local instance of Back button (created when parent level menu page is specified through
                                                                 // setParentMenuPage(); always becomes the first menu item in a list)
     void (*exitAction)();
@@ -0,0 +1,336 @@
+/*
+  GEMPersist - persistence of the menu items' linked variables (with wear leveling and write coalescing) for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMPersist.h"
+
+// Layout of the record: sequence number (2 bytes), length of the payload (2 bytes), CRC of the preceding fields and of the payload (2 bytes),
+// followed by the payload of entries: ID of the menu item (1 byte), size of the value (1 byte), value itself
+#define GEM_PERSIST_HEADER_LEN 6
+#define GEM_PERSIST_ENTRY_HEADER_LEN 2
+
+uint16_t GEMCrc16(uint16_t crc, byte data) {
+  crc ^= (uint16_t)data << 8;
+  for (byte i = 0; i < 8; i++) {
+    crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+//====================== STORAGE
+
+GEMStorageRAM::GEMStorageRAM(byte* data_, unsigned int length_)
+  : _data(data_)
+  , _length(length_)
+  , _writes(0)
+{ }
+
+unsigned int GEMStorageRAM::length() {
+  return _length;
+}
+
+byte GEMStorageRAM::read(unsigned int address) {
+  return _data[address];
+}
+
+void GEMStorageRAM::write(unsigned int address, byte value) {
+  if (_data[address] != value) {
+    _data[address] = value;
+    _writes++;
+  }
+}
+
+unsigned int GEMStorageRAM::getWrites() {
+  return _writes;
+}
+
+//====================== PERSISTENCE
+
+GEMPersist::GEMPersist(GEMStorage& storage_, GEMItem** items_, byte count_, unsigned int address_, unsigned int length_)
+  : _storage(storage_)
+  , _items(items_)
+  , _count(count_)
+  , _address(address_)
+  , _length(length_)
+  , _slotSize(0)
+  , _slots(0)
+  , _slot(0)
+  , _sequence(0)
+  , _hasRecord(false)
+  , _dirty(false)
+  , _dirtyTime(0)
+{ }
+
+void GEMPersist::initLayout() {
+  // Layout is calculated on first use rather than in constructor, because size of some storages (e.g. flash-emulated EEPROM)
+  // is known only after it is initialized in setup()
+  // Slot size is aligned, so that adding an item in later firmware version doesn't necessarily move the slots (and lose stored values)
+  _slotSize = (GEM_PERSIST_HEADER_LEN + getPayloadLength() + GEM_PERSIST_SLOT_ALIGN - 1) / GEM_PERSIST_SLOT_ALIGN * GEM_PERSIST_SLOT_ALIGN;
+  unsigned int length = _length;
+  if (length == 0 && _storage.length() > _address) {
+    length = _storage.length() - _address;
+  }
+  unsigned int slots = length / _slotSize;
+  _slots = (slots < 255) ? slots : 255;
+}
+
+unsigned int GEMPersist::getPayloadLength() {
+  unsigned int length = 0;
+  for (byte i = 0; i < _count; i++) {
+    byte size = _items[i]->getValueSize();
+    if (_items[i]->id != 0 && size > 0) {
+      length += GEM_PERSIST_ENTRY_HEADER_LEN + size;
+    }
+  }
+  return length;
+}
+
+const byte* GEMPersist::getValueData(GEMItem* menuItem, byte* buffer) {
+  if (menuItem->linkedType == GEM_VAL_SELECT) {
+    menuItem->readValue(buffer);
+    return buffer;
+  }
+  // Other values are read straight from linked variable, so that no buffer for strings of arbitrary capacity is required
+  return (const byte*)menuItem->linkedVariable;
+}
+
+uint16_t GEMPersist::getRecordCrc(uint16_t sequence, unsigned int payloadLength) {
+  uint16_t crc = 0xFFFF;
+  crc = GEMCrc16(crc, sequence & 0xFF);
+  crc = GEMCrc16(crc, sequence >> 8);
+  crc = GEMCrc16(crc, payloadLength & 0xFF);
+  crc = GEMCrc16(crc, payloadLength >> 8);
+  byte buffer[GEM_SELECT_VALUE_LEN];
+  for (byte i = 0; i < _count; i++) {
+    GEMItem* menuItem = _items[i];
+    byte size = menuItem->getValueSize();
+    if (menuItem->id != 0 && size > 0) {
+      crc = GEMCrc16(crc, menuItem->id);
+      crc = GEMCrc16(crc, size);
+      const byte* data = getValueData(menuItem, buffer);
+      for (byte j = 0; j < size; j++) {
+        crc = GEMCrc16(crc, data[j]);
+      }
+    }
+  }
+  return crc;
+}
+
+bool GEMPersist::matchesRecord(unsigned int payloadLength) {
+  unsigned int address = _address + _slot * _slotSize;
+  unsigned int payloadLengthStored = _storage.read(address + 2) | (_storage.read(address + 3) << 8);
+  if (payloadLengthStored != payloadLength) {
+    return false;
+  }
+  address += GEM_PERSIST_HEADER_LEN;
+  byte buffer[GEM_SELECT_VALUE_LEN];
+  for (byte i = 0; i < _count; i++) {
+    GEMItem* menuItem = _items[i];
+    byte size = menuItem->getValueSize();
+    if (menuItem->id != 0 && size > 0) {
+      if (_storage.read(address++) != menuItem->id || _storage.read(address++) != size) {
+        return false;
+      }
+      const byte* data = getValueData(menuItem, buffer);
+      for (byte j = 0; j < size; j++) {
+        if (_storage.read(address++) != data[j]) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool GEMPersist::readRecord(byte slot, uint16_t& sequence) {
+  unsigned int address = _address + slot * _slotSize;
+  sequence = _storage.read(address) | (_storage.read(address + 1) << 8);
+  unsigned int payloadLength = _storage.read(address + 2) | (_storage.read(address + 3) << 8);
+  uint16_t crc = _storage.read(address + 4) | (_storage.read(address + 5) << 8);
+  if (payloadLength > _slotSize - GEM_PERSIST_HEADER_LEN) {
+    return false;
+  }
+  uint16_t crcCalculated = 0xFFFF;
+  for (byte i = 0; i < 4; i++) {
+    crcCalculated = GEMCrc16(crcCalculated, _storage.read(address + i));
+  }
+  address += GEM_PERSIST_HEADER_LEN;
+  for (unsigned int i = 0; i < payloadLength; i++) {
+    crcCalculated = GEMCrc16(crcCalculated, _storage.read(address + i));
+  }
+  return crcCalculated == crc;
+}
+
+GEMItem* GEMPersist::getMenuItemById(byte id) {
+  for (byte i = 0; i < _count; i++) {
+    if (_items[i]->id == id) {
+      return _items[i];
+    }
+  }
+  return nullptr;
+}
+
+void GEMPersist::readValue(GEMItem* menuItem, unsigned int address, byte size) {
+  switch (menuItem->linkedType) {
+    case GEM_VAL_SELECT:
+    case GEM_VAL_BOOL:
+      {
+        byte data[GEM_SELECT_VALUE_LEN];
+        for (byte i = 0; i < size; i++) {
+          data[i] = _storage.read(address + i);
+        }
+        menuItem->writeValue(data);
+      }
+      break;
+    default:
+      // Value is read straight into linked variable, so that no buffer for strings of arbitrary capacity is required
+      for (byte i = 0; i < size; i++) {
+        ((byte*)menuItem->linkedVariable)[i] = _storage.read(address + i);
+      }
+      if (menuItem->linkedType == GEM_VAL_CHAR || menuItem->linkedType == GEM_VAL_STRING) {
+        ((char*)menuItem->linkedVariable)[size - 1] = '\0';
+      }
+      break;
+  }
+}
+
+bool GEMPersist::load() {
+  initLayout();
+  bool found = false;
+  for (byte slot = 0; slot < _slots; slot++) {
+    uint16_t sequence;
+    // Sequence numbers are compared with wrap around, so that the latest record is found after 65535 writes as well
+    if (readRecord(slot, sequence) && (!found || (int16_t)(sequence - _sequence) > 0)) {
+      found = true;
+      _slot = slot;
+      _sequence = sequence;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+  _hasRecord = true;
+  unsigned int address = _address + _slot * _slotSize;
+  unsigned int payloadLength = _storage.read(address + 2) | (_storage.read(address + 3) << 8);
+  unsigned int end = address + GEM_PERSIST_HEADER_LEN + payloadLength;
+  address += GEM_PERSIST_HEADER_LEN;
+  while (address + GEM_PERSIST_ENTRY_HEADER_LEN <= end) {
+    byte id = _storage.read(address);
+    byte size = _storage.read(address + 1);
+    address += GEM_PERSIST_ENTRY_HEADER_LEN;
+    GEMItem* menuItem = getMenuItemById(id);
+    // Entries of removed items, or of items which type has changed, are skipped
+    if (menuItem != nullptr && menuItem->getValueSize() == size && address + size <= end) {
+      readValue(menuItem, address, size);
+    }
+    address += size;
+  }
+  return true;
+}
+
+void GEMPersist::markDirty(GEMItem& /* menuItem */) {
+  // Record holds all of the values, so it is enough to know that one of them has changed
+  _dirty = true;
+  _dirtyTime = millis();
+}
+
+void GEMPersist::update() {
+  if (_dirty && millis() - _dirtyTime >= _quietTime) {
+    flush();
+  }
+}
+
+void GEMPersist::flush() {
+  if (_slotSize == 0) {
+    initLayout();
+  }
+  if (_slots == 0) {
+    return;
+  }
+  unsigned int payloadLength = getPayloadLength();
+  // Values that were changed and then changed back produce the same payload as the latest record, so nothing is written
+  // (payload is compared byte by byte, since equal checksums don't guarantee equal values)
+  if (!_hasRecord || !matchesRecord(payloadLength)) {
+    uint16_t sequence = _sequence + 1;
+    uint16_t crc = getRecordCrc(sequence, payloadLength);
+    byte slot = (_slot + 1 < _slots) ? _slot + 1 : 0;
+    unsigned int address = _address + slot * _slotSize;
+    // Payload is written before the header, so that record becomes valid only after it was written completely
+    unsigned int addressEntry = address + GEM_PERSIST_HEADER_LEN;
+    byte buffer[GEM_SELECT_VALUE_LEN];
+    for (byte i = 0; i < _count; i++) {
+      GEMItem* menuItem = _items[i];
+      byte size = menuItem->getValueSize();
+      if (menuItem->id != 0 && size > 0) {
+        _storage.write(addressEntry++, menuItem->id);
+        _storage.write(addressEntry++, size);
+        const byte* data = getValueData(menuItem, buffer);
+        for (byte j = 0; j < size; j++) {
+          _storage.write(addressEntry++, data[j]);
+        }
+      }
+    }
+    _storage.write(address, sequence & 0xFF);
+    _storage.write(address + 1, sequence >> 8);
+    _storage.write(address + 2, payloadLength & 0xFF);
+    _storage.write(address + 3, payloadLength >> 8);
+    _storage.write(address + 4, crc & 0xFF);
+    _storage.write(address + 5, crc >> 8);
+    _storage.commit();
+    _slot = slot;
+    _sequence = sequence;
+    _hasRecord = true;
+  }
+  _dirty = false;
+}
+
+bool GEMPersist::isDirty() {
+  return _dirty;
+}
+
+bool GEMPersist::getNextFlush(unsigned long& time) {
+  time = _dirtyTime + _quietTime;
+  return _dirty;
+}
+
+void GEMPersist::setQuietTime(unsigned int quietTime) {
+  _quietTime = quietTime;
+}
+
+byte GEMPersist::getSlots() {
+  if (_slotSize == 0) {
+    initLayout();
+  }
+  return _slots;
+}
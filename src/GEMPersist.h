@@ -0,0 +1,143 @@
+/*
+  GEMPersist - persistence of the menu items' linked variables (with wear leveling and write coalescing) for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMPERSIST
+#define HEADER_GEMPERSIST
+
+#include <Arduino.h>
+#include "GEMItem.h"
+#include "constants.h"
+
+#if defined(__has_include)
+#if __has_include(<EEPROM.h>)
+#include <EEPROM.h>
+#define GEM_HAS_EEPROM
+#endif
+#endif
+
+// Update CRC-16/CCITT (polynomial 0x1021) checksum with the next byte of data (initial value of the checksum is 0xFFFF)
+uint16_t GEMCrc16(uint16_t crc, byte data);
+
+// Declaration of GEMStorage class (byte-addressable storage persisted values are written to)
+class GEMStorage {
+  public:
+    virtual unsigned int length() = 0;                       // Get size of the storage, in bytes
+    virtual byte read(unsigned int address) = 0;             // Read byte at the address
+    virtual void write(unsigned int address, byte value) = 0;  // Write byte at the address (implementations should skip writing of unchanged value)
+    virtual void commit() { }                                // Finish series of writes (e.g. for flash-emulated EEPROM)
+};
+
+// Declaration of GEMStorageRAM class (storage in the user-supplied array, e.g. for tests on host or for battery-backed RAM)
+class GEMStorageRAM : public GEMStorage {
+  public:
+    /* 
+      @param 'data_' - array that holds content of the storage
+      @param 'length_' - size of the array
+    */
+    GEMStorageRAM(byte* data_, unsigned int length_);
+    unsigned int length();
+    byte read(unsigned int address);
+    void write(unsigned int address, byte value);
+    unsigned int getWrites();                                // Get number of bytes actually written (changed) so far
+  private:
+    byte* _data;
+    unsigned int _length;
+    unsigned int _writes;
+};
+
+#ifdef GEM_HAS_EEPROM
+// Declaration of GEMStorageEEPROM class (storage in EEPROM, or in flash-emulated EEPROM, that should be initialized
+// with EEPROM.begin() beforehand on platforms that require it)
+class GEMStorageEEPROM : public GEMStorage {
+  public:
+    unsigned int length() { return EEPROM.length(); }
+    byte read(unsigned int address) { return EEPROM.read(address); }
+    void write(unsigned int address, byte value) { if (EEPROM.read(address) != value) { EEPROM.write(address, value); } }
+    #if defined(ESP8266) || defined(ESP32)
+    void commit() { EEPROM.commit(); }
+    #endif
+};
+#endif
+
+// Declaration of GEMPersist class
+// Values of the menu items' linked variables are written to the storage as a single record (with entries identified by item IDs, so that items
+// can be added or removed in later firmware versions). Records are written to the slots of the storage area in turn (wear leveling),
+// each one protected with CRC, so that interrupted write leaves the previous record intact. Saves of the menu items are coalesced
+// into one write after a quiet period
+class GEMPersist {
+  public:
+    /* 
+      @param 'storage_' - reference to the storage (e.g. GEMStorageEEPROM)
+      @param 'items_' - array of pointers to menu items to persist (each one should have unique ID set with GEMItem::setId())
+      @param 'count_' - number of the menu items in the array
+      @param 'address_' (optional) - address of the storage area in the storage
+      default 0
+      @param 'length_' (optional) - size of the storage area (the greater the area, the more slots the records are spread across)
+      default 0 (up to the end of the storage)
+    */
+    GEMPersist(GEMStorage& storage_, GEMItem** items_, byte count_, unsigned int address_ = 0, unsigned int length_ = 0);
+    bool load();                                   // Load the latest valid record and assign stored values to linked variables, returns false if there is no valid record
+                                                   // (should be called in setup(), after the storage is initialized)
+    void markDirty(GEMItem& menuItem);             // Mark value of the menu item as changed (called by GEM when menu item is saved), record is written after quiet period
+    void update();                                 // Write record if quiet period since the last change has elapsed (called by GEM along with tasks)
+    void flush();                                  // Write record right away if any of the values has changed
+    bool isDirty();                                // Check that there are changes not yet written to the storage
+    bool getNextFlush(unsigned long& time);        // Get value of millis() at which pending changes will be written, returns false if there are none
+    void setQuietTime(unsigned int quietTime);     // Set time (in ms) without changes after which record is written (default GEM_PERSIST_QUIET_TIME)
+    byte getSlots();                               // Get number of slots the records are spread across (0 if storage area is too small for a single record)
+  private:
+    GEMStorage& _storage;
+    GEMItem** _items;
+    byte _count;
+    unsigned int _address;
+    unsigned int _length;
+    unsigned int _slotSize;
+    byte _slots;
+    byte _slot;                    // Slot of the latest record
+    uint16_t _sequence;            // Sequence number of the latest record
+    bool _hasRecord;               // Storage holds valid record (loaded or written)
+    bool _dirty;
+    unsigned long _dirtyTime;
+    unsigned int _quietTime = GEM_PERSIST_QUIET_TIME;
+    void initLayout();
+    unsigned int getPayloadLength();
+    uint16_t getRecordCrc(uint16_t sequence, unsigned int payloadLength);
+    bool readRecord(byte slot, uint16_t& sequence);
+    bool matchesRecord(unsigned int payloadLength);  // Check that the latest record holds exactly the same payload
+    void readValue(GEMItem* menuItem, unsigned int address, byte size);
+    const byte* getValueData(GEMItem* menuItem, byte* buffer);  // Get bytes of the value in its stored form (buffer of GEM_SELECT_VALUE_LEN is used for option select)
+    GEMItem* getMenuItemById(byte id);
+};
+
+#endif
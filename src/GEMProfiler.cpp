@@ -0,0 +1,152 @@
+/*
+  GEMProfiler - timing of the phases of drawing of the menu for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "GEMProfiler.h"
+#include "GEMItem.h"
+#include "GEMFormat.h"
+
+static const char phaseNames[GEM_PHASE_COUNT][10] PROGMEM = {"clear", "title", "items", "pointer", "scrollbar", "transfer", "frame"};
+static const char kindNames[GEM_PROFILE_KINDS][10] PROGMEM = {"int", "byte", "char", "bool", "select", "float", "double", "callback",
+                                                              "fixed16", "fixed32", "string", "link", "back", "button", "linkedval", "text"};
+
+unsigned long GEMProfileStats::avg() const {
+  return count > 0 ? total / count : 0;
+}
+
+GEMProfiler::GEMProfiler()
+  : _frameStart(0)
+  , _framePhases(0)
+  , _frameCallback(nullptr)
+{
+  reset();
+}
+
+void GEMProfiler::setFrameCallback(void (*frameCallback)(GEMProfiler& profiler)) {
+  _frameCallback = frameCallback;
+}
+
+void GEMProfiler::reset() {
+  memset(_phases, 0, sizeof(_phases));
+  memset(_items, 0, sizeof(_items));
+  memset(_frame, 0, sizeof(_frame));
+}
+
+const GEMProfileStats& GEMProfiler::getPhase(byte phase) {
+  return _phases[phase < GEM_PHASE_COUNT ? phase : GEM_PHASE_FRAME];
+}
+
+const GEMProfileStats& GEMProfiler::getItem(byte kind) {
+  return _items[kind < GEM_PROFILE_KINDS ? kind : 0];
+}
+
+unsigned long GEMProfiler::getLastFrame(byte phase) {
+  return phase < GEM_PHASE_COUNT ? _frame[phase] : 0;
+}
+
+byte GEMProfiler::getItemKind(GEMItem& menuItem) {
+  byte kind = (menuItem.type == GEM_ITEM_VAL) ? menuItem.linkedType : GEM_VAL_STRING + menuItem.type;
+  return kind < GEM_PROFILE_KINDS ? kind : 0;
+}
+
+void GEMProfiler::beginFrame() {
+  memset(_frame, 0, sizeof(_frame));
+  _framePhases = 0;
+  _frameStart = micros();
+}
+
+void GEMProfiler::addPhase(byte phase, unsigned long duration) {
+  _frame[phase] += duration;
+  _framePhases |= 1 << phase;
+}
+
+void GEMProfiler::addItem(GEMItem* menuItem, unsigned long duration) {
+  addSample(_items[getItemKind(*menuItem)], duration);
+}
+
+void GEMProfiler::endFrame() {
+  _frame[GEM_PHASE_FRAME] = micros() - _frameStart;
+  for (byte i = 0; i < GEM_PHASE_COUNT; i++) {
+    // Phases that weren't part of the frame (e.g. transfer in GEM) are left without samples
+    if ((_framePhases & (1 << i)) || i == GEM_PHASE_FRAME) {
+      addSample(_phases[i], _frame[i]);
+    }
+  }
+  if (_frameCallback != nullptr) {
+    _frameCallback(*this);
+  }
+}
+
+void GEMProfiler::addSample(GEMProfileStats& stats, unsigned long duration) {
+  if (stats.count == 0 || duration < stats.min) {
+    stats.min = duration;
+  }
+  if (duration > stats.max) {
+    stats.max = duration;
+  }
+  stats.total += duration;
+  stats.count++;
+}
+
+void GEMProfiler::printTo(Print& out) {
+  out.println(F("phase/item    count      min      avg      max (us)"));
+  for (byte i = 0; i < GEM_PHASE_COUNT; i++) {
+    printStats(out, reinterpret_cast<const __FlashStringHelper*>(phaseNames[i]), _phases[i]);
+  }
+  for (byte i = 0; i < GEM_PROFILE_KINDS; i++) {
+    printStats(out, reinterpret_cast<const __FlashStringHelper*>(kindNames[i]), _items[i]);
+  }
+}
+
+void GEMProfiler::printStats(Print& out, const __FlashStringHelper* name, const GEMProfileStats& stats) {
+  if (stats.count == 0) {
+    return;
+  }
+  out.print(name);
+  printColumn(out, strlen_P(reinterpret_cast<PGM_P>(name)), 10);
+  unsigned long values[4] = {stats.count, stats.min, stats.avg(), stats.max};
+  char buffer[11];
+  for (byte i = 0; i < 4; i++) {
+    byte length = GEMFormatUnsigned(values[i], buffer);
+    printColumn(out, length, 9);
+    out.print(buffer);
+  }
+  out.println();
+}
+
+void GEMProfiler::printColumn(Print& out, byte length, byte width) {
+  for (byte i = length; i < width; i++) {
+    out.print(' ');
+  }
+}
@@ -0,0 +1,105 @@
+/*
+  GEMProfiler - timing of the phases of drawing of the menu for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef HEADER_GEMPROFILER
+#define HEADER_GEMPROFILER
+
+#include <Arduino.h>
+#include "config.h"
+#include "constants.h"
+
+// Forward declaration of necessary classes
+class GEMItem;
+
+// Declaration of GEMProfileStats type
+struct GEMProfileStats {
+  unsigned long count;         // Number of samples
+  unsigned long total;         // Sum of the samples, in us
+  unsigned long min;           // Shortest sample, in us
+  unsigned long max;           // Longest sample, in us
+  unsigned long avg() const;   // Average of the samples, in us (0 if there are no samples)
+};
+
+// Declaration of GEMProfiler class
+// Accumulates min/avg/max time (in us, measured with micros()) of each phase of drawMenu() (GEM_PHASE_...) per frame, and of each menu item
+// being drawn per kind of menu item. Timing is done by GEM and GEM_u8g2 only when GEM_ENABLE_PROFILER is defined (see config.h),
+// otherwise no code is added to drawMenu(). Note that with page buffer mode of U8g2 the frame is drawn in several pages:
+// phases are summed over the pages of the frame, while each menu item is timed once per page.
+class GEMProfiler {
+  public:
+    GEMProfiler();
+    void setFrameCallback(void (*frameCallback)(GEMProfiler& profiler));  // Set function to call at the end of each frame (e.g. to log getLastFrame() values)
+    void reset();                                     // Discard accumulated samples
+    const GEMProfileStats& getPhase(byte phase);      // Get accumulated time of the phase of drawMenu() (GEM_PHASE_...) per frame
+    const GEMProfileStats& getItem(byte kind);        // Get accumulated time of drawing of the single menu item of the kind (see getItemKind())
+    unsigned long getLastFrame(byte phase);           // Get time of the phase (GEM_PHASE_...) in the last frame, in us
+    static byte getItemKind(GEMItem& menuItem);       // Get kind of the menu item: type of associated variable (GEM_VAL_...) for GEM_ITEM_VAL menu items,
+                                                      // GEM_VAL_STRING + type for other types of menu items (e.g. GEM_VAL_STRING + GEM_ITEM_LINK)
+    void printTo(Print& out);                         // Print table of accumulated time (count, min, avg and max, in us) of phases and kinds of menu items (that have samples)
+
+    /* Called by GEM and GEM_u8g2 */
+
+    void beginFrame();
+    void addPhase(byte phase, unsigned long duration);
+    void addItem(GEMItem* menuItem, unsigned long duration);
+    void endFrame();
+  private:
+    GEMProfileStats _phases[GEM_PHASE_COUNT];
+    GEMProfileStats _items[GEM_PROFILE_KINDS];
+    unsigned long _frame[GEM_PHASE_COUNT];            // Time of the phases of the current (or last) frame
+    unsigned long _frameStart;
+    byte _framePhases;                                // Bit mask of the phases that were part of the current frame
+    void (*_frameCallback)(GEMProfiler& profiler);
+    static void addSample(GEMProfileStats& stats, unsigned long duration);
+    static void printStats(Print& out, const __FlashStringHelper* name, const GEMProfileStats& stats);
+    static void printColumn(Print& out, byte length, byte width);  // Pad value of the length to the width of the column
+};
+
+// Hooks placed by GEM and GEM_u8g2 in drawMenu(), expand to plain statement (or nothing) when profiler is disabled
+#ifdef GEM_ENABLE_PROFILER
+  #define GEM_PROFILE_FRAME_BEGIN(profiler) if (profiler != nullptr) { profiler->beginFrame(); }
+  #define GEM_PROFILE_FRAME_END(profiler) if (profiler != nullptr) { profiler->endFrame(); }
+  #define GEM_PROFILE_PHASE(profiler, phase, statement) { unsigned long gemPhaseStart = micros(); statement; if (profiler != nullptr) { profiler->addPhase(phase, micros() - gemPhaseStart); } }
+  #define GEM_PROFILE_ITEM_BEGIN() unsigned long gemItemStart = micros()
+  #define GEM_PROFILE_ITEM_END(profiler, menuItem) if (profiler != nullptr) { profiler->addItem(menuItem, micros() - gemItemStart); }
+#else
+  #define GEM_PROFILE_FRAME_BEGIN(profiler)
+  #define GEM_PROFILE_FRAME_END(profiler)
+  #define GEM_PROFILE_PHASE(profiler, phase, statement) statement
+  #define GEM_PROFILE_ITEM_BEGIN()
+  #define GEM_PROFILE_ITEM_END(profiler, menuItem)
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+/*
+  GEMRemote - remote control of menu values over serial link for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMRemote.h"
+#include "GEMSnapshot.h"
+#include "GEMPersist.h"
+
+#define GEM_REMOTE_START_BYTE 0xA5
+#define GEM_REMOTE_RESPONSE 0x80
+
+// States of the frame receiver (see GEMRemote::update())
+#define GEM_REMOTE_STATE_START 0
+#define GEM_REMOTE_STATE_COMMAND 1
+#define GEM_REMOTE_STATE_LENGTH 2
+#define GEM_REMOTE_STATE_PAYLOAD 3
+#define GEM_REMOTE_STATE_CRC_LOW 4
+#define GEM_REMOTE_STATE_CRC_HIGH 5
+
+// Flags of the menu item reported by GEM_REMOTE_LIST command
+#define GEM_REMOTE_FLAG_READONLY 0x01
+#define GEM_REMOTE_FLAG_HIDDEN 0x02
+
+GEMRemote::GEMRemote(Stream& stream_, GEMPage& root_)
+  : _stream(stream_)
+  , _root(root_)
+{ }
+
+unsigned int GEMRemote::getErrors() {
+  return _errors;
+}
+
+//====================== RECEIVE
+
+GEMItem* GEMRemote::update(GEMItem* menuItemLocked) {
+  if (_state != GEM_REMOTE_STATE_START && millis() - _byteTime > GEM_REMOTE_TIMEOUT) {
+    // Rest of the frame is lost, receiver waits for the start of the next one
+    _state = GEM_REMOTE_STATE_START;
+    _errors++;
+  }
+  while (_stream.available() > 0) {
+    byte data = _stream.read();
+    _byteTime = millis();
+    switch (_state) {
+      case GEM_REMOTE_STATE_START:
+        if (data == GEM_REMOTE_START_BYTE) {
+          _crc = 0xFFFF;
+          _state = GEM_REMOTE_STATE_COMMAND;
+        }
+        break;
+      case GEM_REMOTE_STATE_COMMAND:
+        _command = data;
+        _crc = GEMCrc16(_crc, data);
+        _state = GEM_REMOTE_STATE_LENGTH;
+        break;
+      case GEM_REMOTE_STATE_LENGTH:
+        _length = data;
+        _received = 0;
+        _crc = GEMCrc16(_crc, data);
+        _state = (_length > 0) ? GEM_REMOTE_STATE_PAYLOAD : GEM_REMOTE_STATE_CRC_LOW;
+        break;
+      case GEM_REMOTE_STATE_PAYLOAD:
+        // Payload that doesn't fit is still received up to its end (and rejected then), so that its bytes aren't mistaken for the start of the frame
+        if (_received < GEM_REMOTE_FRAME_LEN) {
+          _payload[_received] = data;
+        }
+        _crc = GEMCrc16(_crc, data);
+        if (++_received == _length) {
+          _state = GEM_REMOTE_STATE_CRC_LOW;
+        }
+        break;
+      case GEM_REMOTE_STATE_CRC_LOW:
+        _crcLow = data;
+        _state = GEM_REMOTE_STATE_CRC_HIGH;
+        break;
+      case GEM_REMOTE_STATE_CRC_HIGH:
+        _state = GEM_REMOTE_STATE_START;
+        if ((_crcLow | (data << 8)) != _crc) {
+          _errors++;
+          beginResponse(GEM_REMOTE_ERROR, 0, GEM_REMOTE_BAD_FRAME);
+          endResponse();
+        } else if (_length > GEM_REMOTE_FRAME_LEN) {
+          // Frame is intact, but its payload doesn't fit, so the request is answered as usual (with ID it starts with)
+          _errors++;
+          beginResponse(_command, 1, GEM_REMOTE_TOO_LONG);
+          sendByte(_payload[0]);
+          endResponse();
+        } else {
+          GEMItem* menuItem = processFrame(menuItemLocked);
+          if (menuItem != nullptr) {
+            return menuItem; // Remaining bytes are processed by the next call, after save action of the menu item is run
+          }
+        }
+        break;
+    }
+  }
+  return nullptr;
+}
+
+//====================== REQUESTS
+
+GEMItem* GEMRemote::processFrame(GEMItem* menuItemLocked) {
+  if (_command == GEM_REMOTE_LIST) {
+    GEMSnapshot::walk(_root, listMenuItem, this);
+    beginResponse(GEM_REMOTE_LIST, 0, GEM_REMOTE_OK);
+    endResponse();
+    return nullptr;
+  }
+  if (_command != GEM_REMOTE_READ && _command != GEM_REMOTE_WRITE) {
+    beginResponse(_command, 0, GEM_REMOTE_UNKNOWN_COMMAND);
+    endResponse();
+    return nullptr;
+  }
+  byte id = (_length > 0) ? _payload[0] : 0;
+  GEMItem* menuItem = GEMSnapshot::findMenuItem(_root, id);
+  byte size = (menuItem != nullptr) ? menuItem->getValueSize() : 0;
+  byte status = GEM_REMOTE_OK;
+  if (menuItem == nullptr || size == 0) {
+    status = GEM_REMOTE_UNKNOWN_ID;
+  } else if (_command == GEM_REMOTE_READ) {
+    if (size > 255 - 4) {
+      status = GEM_REMOTE_INVALID_VALUE; // Value doesn't fit the frame along with status, ID, type and size
+    } else {
+      beginResponse(_command, 3 + size, GEM_REMOTE_OK);
+      sendByte(id);
+      sendByte(menuItem->linkedType);
+      sendByte(size);
+      sendValue(*menuItem);
+      endResponse();
+      return nullptr;
+    }
+  } else if (menuItem->readonly) {
+    status = GEM_REMOTE_READONLY;
+  } else if (menuItem == menuItemLocked) {
+    status = GEM_REMOTE_BUSY;
+  } else if (_length - 1 != size || !menuItem->writeValue(_payload + 1)) {
+    status = GEM_REMOTE_INVALID_VALUE;
+  }
+  beginResponse(_command, 1, status);
+  sendByte(id);
+  endResponse();
+  return (_command == GEM_REMOTE_WRITE && status == GEM_REMOTE_OK) ? menuItem : nullptr;
+}
+
+bool GEMRemote::listMenuItem(GEMItem& menuItem, void* context) {
+  GEMRemote* remote = (GEMRemote*)context;
+  if (menuItem.id == 0) {
+    return true;
+  }
+  size_t titleLength = (menuItem.title == nullptr) ? 0 : (menuItem.titleProgmem ? strlen_P(menuItem.title) : strlen(menuItem.title));
+  if (titleLength > 255 - 5) {
+    titleLength = 255 - 5;
+  }
+  byte flags = (menuItem.readonly ? GEM_REMOTE_FLAG_READONLY : 0) | (menuItem.hidden ? GEM_REMOTE_FLAG_HIDDEN : 0);
+  remote->beginResponse(GEM_REMOTE_LIST, 4 + titleLength, GEM_REMOTE_OK);
+  remote->sendByte(menuItem.id);
+  remote->sendByte(menuItem.linkedType);
+  remote->sendByte(menuItem.getValueSize());
+  remote->sendByte(flags);
+  for (size_t i = 0; i < titleLength; i++) {
+    remote->sendByte(menuItem.titleProgmem ? pgm_read_byte(menuItem.title + i) : menuItem.title[i]);
+  }
+  remote->endResponse();
+  return true;
+}
+
+//====================== SEND
+
+void GEMRemote::beginResponse(byte command, byte length, byte status) {
+  _stream.write(GEM_REMOTE_START_BYTE);
+  _crc = 0xFFFF;
+  sendByte(command | GEM_REMOTE_RESPONSE);
+  sendByte(length + 1); // Status is part of the payload
+  sendByte(status);
+}
+
+void GEMRemote::sendByte(byte data) {
+  _stream.write(data);
+  _crc = GEMCrc16(_crc, data);
+}
+
+void GEMRemote::endResponse() {
+  uint16_t crc = _crc;
+  _stream.write(crc & 0xFF);
+  _stream.write(crc >> 8);
+}
+
+void GEMRemote::sendValue(GEMItem& menuItem) {
+  byte size = menuItem.getValueSize();
+  if (menuItem.linkedType == GEM_VAL_SELECT) {
+    byte data[GEM_SELECT_VALUE_LEN];
+    menuItem.readValue(data);
+    for (byte i = 0; i < size; i++) {
+      sendByte(data[i]);
+    }
+  } else {
+    // Value is sent straight from the associated variable
+    for (byte i = 0; i < size; i++) {
+      sendByte(((byte*)menuItem.linkedVariable)[i]);
+    }
+  }
+}
@@ -0,0 +1,101 @@
+/*
+  GEMRemote - remote control of menu values over serial link for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMREMOTE
+#define HEADER_GEMREMOTE
+
+#include <Arduino.h>
+#include "GEMPage.h"
+#include "GEMItem.h"
+#include "constants.h"
+
+// Macro constants (aliases) for the commands of the remote control protocol
+#define GEM_REMOTE_LIST 0x01    // Enumerate menu items that have ID set
+#define GEM_REMOTE_READ 0x02    // Read value of the menu item
+#define GEM_REMOTE_WRITE 0x03   // Write value of the menu item
+#define GEM_REMOTE_ERROR 0x7F   // Response to the frame that can't be processed (e.g. with CRC mismatch)
+
+// Macro constants (aliases) for the status of the request (first byte of the payload of each response)
+#define GEM_REMOTE_OK 0                 // Request is processed
+#define GEM_REMOTE_UNKNOWN_ID 1         // There is no menu item with the supplied ID
+#define GEM_REMOTE_INVALID_VALUE 2      // Value is of the wrong size or is rejected by GEMItem::writeValue()
+#define GEM_REMOTE_READONLY 3           // Menu item is readonly
+#define GEM_REMOTE_BUSY 4               // Value of the menu item is being edited on the device
+#define GEM_REMOTE_UNKNOWN_COMMAND 5    // Command is not supported
+#define GEM_REMOTE_BAD_FRAME 6          // CRC of the frame doesn't match
+#define GEM_REMOTE_TOO_LONG 7           // Payload of the frame is longer than GEM_REMOTE_FRAME_LEN (e.g. value of long string variable)
+
+// Declaration of GEMRemote class
+// Frame (in both directions) consists of start byte 0xA5, command, length of the payload, payload and CRC-16 of command, length and payload
+// (see GEMCrc16(), low byte first). Command of the response has its high bit set, e.g. 0x82 for GEM_REMOTE_READ request:
+//   GEM_REMOTE_LIST  request: none;             response: status, ID, type, size, flags (1 - readonly, 2 - hidden), title (for each menu item),
+//                                               followed by response with status only
+//   GEM_REMOTE_READ  request: ID;               response: status, ID, type, size, value (as returned by GEMItem::readValue())
+//   GEM_REMOTE_WRITE request: ID, value;        response: status, ID
+// Value is written in a single frame, so values longer than GEM_REMOTE_FRAME_LEN - 1 (of long string variables) can be read, but not written
+class GEMRemote {
+  public:
+    /* 
+      @param 'stream_' - stream requests are read from and responses are written to (e.g. Serial)
+      @param 'root_' - menu page to start from (menu items of child pages linked from it are accessible too)
+    */
+    GEMRemote(Stream& stream_, GEMPage& root_);
+    /* 
+      Process received bytes (without waiting for more), responding to complete frames
+      @param 'menuItemLocked' (optional) - menu item writes to which are rejected with GEM_REMOTE_BUSY (e.g. one being edited)
+      returns menu item which value is written (so that caller can run its save action) or nullptr if received bytes are exhausted
+    */
+    GEMItem* update(GEMItem* menuItemLocked = nullptr);
+    unsigned int getErrors();                     // Get number of frames dropped because of CRC mismatch, excessive length or timeout
+  private:
+    Stream& _stream;
+    GEMPage& _root;
+    byte _state = 0;                              // Position within the frame being received
+    byte _command;
+    byte _length;
+    byte _received;                               // Number of bytes of the payload received so far
+    byte _payload[GEM_REMOTE_FRAME_LEN];
+    uint16_t _crc;                                // CRC of the frame being received or sent
+    byte _crcLow;                                 // Low byte of CRC of the frame being received
+    unsigned long _byteTime;                      // Value of millis() when the latest byte is received
+    unsigned int _errors = 0;
+    GEMItem* processFrame(GEMItem* menuItemLocked);
+    void beginResponse(byte command, byte length, byte status);
+    void sendByte(byte data);
+    void endResponse();
+    void sendValue(GEMItem& menuItem);
+    static bool listMenuItem(GEMItem& menuItem, void* context);
+};
+
+#endif
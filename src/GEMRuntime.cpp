@@ -0,0 +1,127 @@
+/*
+  GEMRuntime - background work of the menu (tasks, persistence, key queue, remote control), shared by GEM and GEM_u8g2.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMRuntime.h"
+#include "GEMItem.h"
+
+GEMRuntime::GEMRuntime()
+  #ifdef GEM_ENABLE_PERSIST
+  : _persist(nullptr)
+  #endif
+{ }
+
+void GEMRuntime::runTasks(GEMPage* pageCurrent) {
+  #ifdef GEM_ENABLE_SCHEDULER
+  _scheduler.run(pageCurrent);
+  #endif
+  #ifdef GEM_ENABLE_PERSIST
+  if (_persist != nullptr) {
+    _persist->update();
+  }
+  #endif
+  #ifndef GEM_ENABLE_SCHEDULER
+  (void)pageCurrent;
+  #endif
+}
+
+unsigned long GEMRuntime::nextDeadlineMillis(GEMPage* pageCurrent) {
+  unsigned long time = millis();
+  if (pageCurrent == nullptr) {
+    return time; // Running context needs loop() right away
+  }
+  #ifdef GEM_ENABLE_KEY_QUEUE
+  if (!_keyQueue.isEmpty()) {
+    return time; // So do queued key presses
+  }
+  #endif
+  unsigned long deadline = time + GEM_DEADLINE_MAX_WAIT;
+  #if defined(GEM_ENABLE_SCHEDULER) || defined(GEM_ENABLE_PERSIST)
+  unsigned long taskTime;
+  #endif
+  #ifdef GEM_ENABLE_SCHEDULER
+  if (_scheduler.getNextRun(pageCurrent, taskTime)) {
+    deadline = taskTime;
+  }
+  #endif
+  #ifdef GEM_ENABLE_PERSIST
+  if (_persist != nullptr && _persist->getNextFlush(taskTime) && (long)(taskTime - deadline) < 0) {
+    deadline = taskTime;
+  }
+  #endif
+  return deadline;
+}
+
+void GEMRuntime::markSaved(GEMItem* menuItem) {
+  #ifdef GEM_ENABLE_PERSIST
+  if (_persist != nullptr) {
+    _persist->markDirty(*menuItem);
+  }
+  #else
+  (void)menuItem;
+  #endif
+}
+
+#ifdef GEM_ENABLE_SCHEDULER
+GEMScheduler& GEMRuntime::getScheduler() {
+  return _scheduler;
+}
+#endif
+
+#ifdef GEM_ENABLE_PERSIST
+void GEMRuntime::setPersist(GEMPersist& persist) {
+  _persist = &persist;
+}
+#endif
+
+#ifdef GEM_ENABLE_KEY_QUEUE
+GEMKeyQueue& GEMRuntime::getKeyQueue() {
+  return _keyQueue;
+}
+#endif
+
+#ifdef GEM_ENABLE_REMOTE
+bool GEMRuntime::processRemote(GEMRemote& remote, GEMItem* menuItemLocked) {
+  GEMItem* menuItem;
+  bool saved = false;
+  while ((menuItem = remote.update(menuItemLocked)) != nullptr) {
+    markSaved(menuItem);
+    if (menuItem->saveAction != nullptr) {
+      menuItem->saveAction();
+    }
+    saved = true;
+  }
+  return saved;
+}
+#endif
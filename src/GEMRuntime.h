@@ -0,0 +1,117 @@
+/*
+  GEMRuntime - background work of the menu (tasks, persistence, key queue, remote control), shared by GEM and GEM_u8g2.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMRUNTIME
+#define HEADER_GEMRUNTIME
+
+#include <Arduino.h>
+#include "config.h"
+#include "constants.h"
+#ifdef GEM_ENABLE_KEY_QUEUE
+#include "GEMKeyQueue.h"
+#endif
+#ifdef GEM_ENABLE_ENCODER
+#include "GEMEncoder.h"
+#endif
+#ifdef GEM_ENABLE_SCHEDULER
+#include "GEMScheduler.h"
+#endif
+#ifdef GEM_ENABLE_PERSIST
+#include "GEMPersist.h"
+#endif
+#ifdef GEM_ENABLE_REMOTE
+#include "GEMRemote.h"
+#endif
+
+// Forward declaration of necessary classes
+class GEMItem;
+class GEMPage;
+
+// Declaration of GEMRuntime class
+// Work of the menu that doesn't depend on the way it is drawn: tasks, persistence of saved values, queued key presses,
+// encoder steps and remote requests. Owned by GEM and GEM_u8g2, which pass key presses back to themselves and redraw as needed.
+class GEMRuntime {
+  public:
+    GEMRuntime();
+    void runTasks(GEMPage* pageCurrent);                    // Run tasks that are due (pageCurrent is nullptr while context is running, so that tasks of menu pages don't run)
+    unsigned long nextDeadlineMillis(GEMPage* pageCurrent); // Get value of millis() by which tasks or queued key presses need loop() (right away while context is running, i.e. pageCurrent is nullptr)
+    void markSaved(GEMItem* menuItem);                      // Account for the value of the menu item saved by the user (or remote request)
+    #ifdef GEM_ENABLE_SCHEDULER
+    GEMScheduler& getScheduler();
+    #endif
+    #ifdef GEM_ENABLE_PERSIST
+    void setPersist(GEMPersist& persist);
+    #endif
+    #ifdef GEM_ENABLE_KEY_QUEUE
+    GEMKeyQueue& getKeyQueue();
+    // Register key presses queued so far with the menu, in order they were made
+    template <class Menu>
+    void processKeyQueue(Menu& menu) {
+      GEMKeyEvent event;
+      // Only key presses queued so far are processed, so that continuous stream of presses from ISR can't stall the loop
+      byte count = _keyQueue.count();
+      while (count-- > 0 && _keyQueue.pop(event)) {
+        menu.registerKeyPress(event.key);
+      }
+    }
+    #endif
+    #ifdef GEM_ENABLE_ENCODER
+    // Register steps accumulated by rotary encoder with the menu, as presses of keyClockwise or keyCounterclockwise key
+    template <class Menu>
+    void processEncoder(Menu& menu, GEMEncoder& encoder, byte keyClockwise, byte keyCounterclockwise) {
+      int8_t steps = encoder.read();
+      if (steps > 0) {
+        menu.registerKeyPress(keyClockwise, steps);
+      } else if (steps < 0) {
+        menu.registerKeyPress(keyCounterclockwise, -steps);
+      }
+    }
+    #endif
+    #ifdef GEM_ENABLE_REMOTE
+    bool processRemote(GEMRemote& remote, GEMItem* menuItemLocked);  // Process requests received by remote control, written values are saved (see markSaved()) along with their save actions,
+                                                                     // returns true if any value was written (and menu should be redrawn)
+    #endif
+  private:
+    #ifdef GEM_ENABLE_SCHEDULER
+    GEMScheduler _scheduler;
+    #endif
+    #ifdef GEM_ENABLE_PERSIST
+    GEMPersist* _persist;
+    #endif
+    #ifdef GEM_ENABLE_KEY_QUEUE
+    GEMKeyQueue _keyQueue;
+    #endif
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+  GEMScheduler - cooperative scheduler of periodic tasks for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMScheduler.h"
+
+GEMScheduler::GEMScheduler()
+  : _tasks(nullptr)
+  , _resume(nullptr)
+  , _modified(false)
+  , _tickBudget(0)
+  , _overruns(0)
+  , _overrunCallback(nullptr)
+{ }
+
+void GEMScheduler::add(GEMTask& task) {
+  remove(task);
+  task.lastRun = millis() - task.interval;
+  task.duration = 0;
+  task.overruns = 0;
+  task.next = _tasks;
+  _tasks = &task;
+  _modified = true;
+}
+
+void GEMScheduler::remove(GEMTask& task) {
+  for (GEMTask** link = &_tasks; *link != nullptr; link = &(*link)->next) {
+    if (*link == &task) {
+      *link = task.next;
+      if (_resume == &task) {
+        _resume = task.next;
+      }
+      task.next = nullptr;
+      _modified = true;
+      return;
+    }
+  }
+}
+
+void GEMScheduler::clear() {
+  _tasks = nullptr;
+  _resume = nullptr;
+  _modified = true;
+}
+
+void GEMScheduler::setTickBudget(unsigned int budget) {
+  _tickBudget = budget;
+}
+
+void GEMScheduler::setOverrunCallback(void (*overrunCallback)(GEMTask& task)) {
+  _overrunCallback = overrunCallback;
+}
+
+bool GEMScheduler::isActive(GEMTask* task, GEMPage* pageCurrent) {
+  return task->page == nullptr || task->page == pageCurrent;
+}
+
+void GEMScheduler::run(GEMPage* pageCurrent) {
+  if (_tasks == nullptr) {
+    return;
+  }
+  GEMTask* start = (_resume != nullptr) ? _resume : _tasks;
+  GEMTask* task = start;
+  unsigned long tickStart = micros();
+  do {
+    if (isActive(task, pageCurrent) && millis() - task->lastRun >= task->interval) {
+      if (_tickBudget > 0 && micros() - tickStart >= _tickBudget) {
+        _resume = task; // Budget of this call is spent, the rest of the due tasks wait until the next call
+        return;
+      }
+      _modified = false;
+      task->lastRun = millis();
+      unsigned long runStart = micros();
+      task->callback();
+      unsigned long duration = micros() - runStart;
+      task->duration = (duration < 65535) ? duration : 65535;
+      if (task->budget > 0 && duration > task->budget) {
+        if (task->overruns < 65535) {
+          task->overruns++;
+        }
+        if (_overruns < 65535) {
+          _overruns++;
+        }
+        if (_overrunCallback != nullptr) {
+          _overrunCallback(*task);
+        }
+      }
+      if (_modified) {
+        _resume = nullptr;
+        return; // Task added or removed tasks, so the list is walked anew on the next call
+      }
+    }
+    task = (task->next != nullptr) ? task->next : _tasks;
+  } while (task != start && task != nullptr);
+  _resume = nullptr;
+}
+
+unsigned int GEMScheduler::getOverruns() {
+  return _overruns;
+}
+
+bool GEMScheduler::getNextRun(GEMPage* pageCurrent, unsigned long& time) {
+  bool found = false;
+  unsigned long now = millis();
+  unsigned long wait = 0;
+  for (GEMTask* task = _tasks; task != nullptr; task = task->next) {
+    if (isActive(task, pageCurrent)) {
+      unsigned long elapsed = now - task->lastRun;
+      unsigned long taskWait = (elapsed >= task->interval) ? 0 : task->interval - elapsed;
+      if (!found || taskWait < wait) {
+        wait = taskWait;
+        found = true;
+      }
+    }
+  }
+  time = now + wait;
+  return found;
+}
@@ -0,0 +1,80 @@
+/*
+  GEMScheduler - cooperative scheduler of periodic tasks for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMSCHEDULER
+#define HEADER_GEMSCHEDULER
+
+#include <Arduino.h>
+
+// Forward declaration of necessary classes
+class GEMPage;
+
+// Declaration of GEMTask type
+struct GEMTask {
+  void (*callback)();          // Pointer to function of the task, should do a short portion of work and return
+  unsigned long interval;      // Interval between runs of the task, in ms
+  unsigned int budget;         // Time the single run of the task is expected to fit in, in us (optional, 0 for no limit)
+  GEMPage* page;               // Menu page the task belongs to: task runs only while the page is current (optional, nullptr to run regardless of the current page)
+  unsigned long lastRun;       // Value of millis() at the last run (managed by GEMScheduler)
+  unsigned int duration;       // Duration of the last run, in us (managed by GEMScheduler)
+  unsigned int overruns;       // Number of runs that exceeded the budget (managed by GEMScheduler)
+  GEMTask* next;               // Next task in the list (managed by GEMScheduler)
+};
+
+// Declaration of GEMScheduler class
+// Tasks are run from the main loop one after another (none is preempted), each when its interval elapses
+class GEMScheduler {
+  public:
+    GEMScheduler();
+    void add(GEMTask& task);                    // Add task to the scheduler (task is first run on the next call of run())
+    void remove(GEMTask& task);                 // Remove task from the scheduler
+    void clear();                               // Remove all tasks
+    void setTickBudget(unsigned int budget);    // Set time (in us) all tasks run by single call of run() are expected to fit in (0 for no limit, default)
+                                                // tasks that are due when the budget is spent wait until the next call
+    void setOverrunCallback(void (*overrunCallback)(GEMTask& task));  // Set function to call when task exceeds its budget
+    void run(GEMPage* pageCurrent = nullptr);   // Run tasks that are due (skipping tasks of menu pages other than pageCurrent)
+    unsigned int getOverruns();                 // Get total number of runs of all tasks that exceeded their budget (saturates at 65535)
+    bool getNextRun(GEMPage* pageCurrent, unsigned long& time);  // Get value of millis() at which the next task (of all tasks except those of menu pages other than pageCurrent) is due,
+                                                                 // returns false if there are no such tasks
+  private:
+    GEMTask* _tasks;
+    GEMTask* _resume;                           // Task to start the next call of run() from, so that tasks at the end of the list aren't starved by the tick budget
+    bool _modified;                             // List of tasks was changed (e.g. from within the task)
+    unsigned int _tickBudget;
+    unsigned int _overruns;
+    void (*_overrunCallback)(GEMTask& task);
+    bool isActive(GEMTask* task, GEMPage* pageCurrent);
+};
+
+#endif
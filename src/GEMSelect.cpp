@@ -35,73 +35,41 @@
 #include <Arduino.h>
 #include "GEMSelect.h"
 #include "constants.h"
+#include "GEMFormat.h"
+#include <limits.h>
 
-GEMSelect::GEMSelect(byte length_, SelectOptionInt* options_)
-  : _type(GEM_VAL_INTEGER)
-  , _length(length_)
-  , _options(options_)
-{ }
+char GEMSelect::_optionName[GEM_STR_LEN];
 
-GEMSelect::GEMSelect(byte length_, SelectOptionByte* options_)
-  : _type(GEM_VAL_BYTE)
+GEMSelect::GEMSelect(const GEMSelectOps* ops_, byte length_, void* options_)
+  : _ops(ops_)
   , _length(length_)
   , _options(options_)
 { }
 
-GEMSelect::GEMSelect(byte length_, SelectOptionChar* options_)
-  : _type(GEM_VAL_CHAR)
-  , _length(length_)
-  , _options(options_)
+GEMSelect::GEMSelect(SelectOptionProvider& provider_)
+  : _ops(&GEMSelectOptions<SelectOptionProvider>::ops)
+  , _length(0)
+  , _options(&provider_)
 { }
 
-GEMSelect::GEMSelect(byte length_, SelectOptionFloat* options_)
-  : _type(GEM_VAL_FLOAT)
-  , _length(length_)
-  , _options(options_)
+GEMSelect::GEMSelect(SelectOptionRangeInt& range_)
+  : _ops(&GEMSelectOptions<SelectOptionRangeInt>::ops)
+  , _length(0)
+  , _options(&range_)
 { }
 
-GEMSelect::GEMSelect(byte length_, SelectOptionDouble* options_)
-  : _type(GEM_VAL_DOUBLE)
-  , _length(length_)
-  , _options(options_)
+GEMSelect::GEMSelect(SelectOptionRangeByte& range_)
+  : _ops(&GEMSelectOptions<SelectOptionRangeByte>::ops)
+  , _length(0)
+  , _options(&range_)
 { }
 
-byte GEMSelect::getType() {
-  return _type;
-}
-
-byte GEMSelect::getLength() {
-  return _length;
+int GEMSelect::getLength() {
+  return _ops->getLength(this);
 }
 
 int GEMSelect::getSelectedOptionNum(void* variable) {
-  SelectOptionInt* optsInt = (SelectOptionInt*)_options;
-  SelectOptionByte* optsByte = (SelectOptionByte*)_options;
-  SelectOptionChar* optsChar = (SelectOptionChar*)_options;
-  SelectOptionFloat* optsFloat = (SelectOptionFloat*)_options;
-  SelectOptionDouble* optsDouble = (SelectOptionDouble*)_options;
-  bool found = false;
-  for (byte i=0; i<_length; i++) {
-    switch (_type) {
-      case GEM_VAL_INTEGER:
-        if (optsInt[i].val_int == *(int*)variable) { found = true; }
-        break;
-      case GEM_VAL_BYTE:
-        if (optsByte[i].val_byte == *(byte*)variable) { found = true; }
-        break;
-      case GEM_VAL_CHAR:
-        if (strcmp(optsChar[i].val_char, (char*)variable) == 0) { found = true; }
-        break;
-      case GEM_VAL_FLOAT:
-        if (optsFloat[i].val_float == *(float*)variable) { found = true; }
-        break;
-      case GEM_VAL_DOUBLE:
-        if (optsDouble[i].val_double == *(double*)variable) { found = true; }
-        break;
-    }
-    if (found) { return i; }
-  }
-  if (!found) { return -1; }
+  return _ops->getSelectedOptionNum(this, variable);
 }
 
 char* GEMSelect::getSelectedOptionName(void* variable) {
@@ -110,56 +78,231 @@ char* GEMSelect::getSelectedOptionName(void* variable) {
 }
 
 char* GEMSelect::getOptionNameByIndex(int index) {
-  const char* name;
-  SelectOptionInt* optsInt = (SelectOptionInt*)_options;
-  SelectOptionByte* optsByte = (SelectOptionByte*)_options;
-  SelectOptionChar* optsChar = (SelectOptionChar*)_options;
-  SelectOptionFloat* optsFloat = (SelectOptionFloat*)_options;
-  SelectOptionDouble* optsDouble = (SelectOptionDouble*)_options;
-  switch (_type) {
-    case GEM_VAL_INTEGER:
-      name = (index > -1 && index < _length) ? optsInt[index].name : "";
-      break;
-    case GEM_VAL_BYTE:
-      name = (index > -1 && index < _length) ? optsByte[index].name : "";
-      break;
-    case GEM_VAL_CHAR:
-      name = (index > -1 && index < _length) ? optsChar[index].name : "";
-      break;
-    case GEM_VAL_FLOAT:
-      name = (index > -1 && index < _length) ? optsFloat[index].name : "";
-      break;
-    case GEM_VAL_DOUBLE:
-      name = (index > -1 && index < _length) ? optsDouble[index].name : "";
-      break;
-  }
-  return const_cast<char*>(name);
+  const char* name = (index > -1 && index < getLength()) ? _ops->getOptionNameByIndex(this, index) : "";
+  return const_cast<char*>(name != nullptr ? name : "");
 }
 
 void GEMSelect::setValue(void* variable, int index) {
-  SelectOptionInt* optsInt = (SelectOptionInt*)_options;
-  SelectOptionByte* optsByte = (SelectOptionByte*)_options;
-  SelectOptionChar* optsChar = (SelectOptionChar*)_options;
-  SelectOptionFloat* optsFloat = (SelectOptionFloat*)_options;
-  SelectOptionDouble* optsDouble = (SelectOptionDouble*)_options;
-  if (index > -1 && index < _length) {
-    switch (_type) {
-      case GEM_VAL_INTEGER:
-        *(int*)variable = optsInt[index].val_int;
-        break;
-      case GEM_VAL_BYTE:
-        *(byte*)variable = optsByte[index].val_byte;
-        break;
-      case GEM_VAL_CHAR:
-        strcpy((char*)variable, optsChar[index].val_char);
-        break;
-      case GEM_VAL_FLOAT:
-        *(float*)variable = optsFloat[index].val_float;
-        break;
-        break;
-      case GEM_VAL_DOUBLE:
-        *(double*)variable = optsDouble[index].val_double;
-        break;
+  if (index > -1 && index < getLength()) {
+    _ops->setValue(this, variable, index);
+  }
+}
+
+size_t GEMSelect::getOptionsSize() {
+  return _ops->getOptionsSize(this);
+}
+
+byte GEMSelect::getValueSize() {
+  return _ops->getValueSize(this);
+}
+
+void GEMSelect::readValue(void* variable, byte* data) {
+  _ops->readValue(this, variable, data);
+}
+
+int GEMSelect::findValue(const byte* data) {
+  return _ops->findValue(this, data);
+}
+
+const char* GEMSelect::getProgmemOptionName(const char* names, int index) {
+  const char* name = names;
+  while (index > 0) {
+    if (pgm_read_byte(name++) == '\0') {
+      index--;
     }
   }
+  strncpy_P(_optionName, name, GEM_STR_LEN - 1);
+  _optionName[GEM_STR_LEN - 1] = '\0';
+  return _optionName;
+}
+
+//---
+
+int GEMSelectOptions<SelectOptionProvider>::getLength(GEMSelect* select) {
+  return ((SelectOptionProvider*)select->_options)->count();
+}
+
+int GEMSelectOptions<SelectOptionProvider>::getSelectedOptionNum(GEMSelect* select, void* variable) {
+  return ((SelectOptionProvider*)select->_options)->indexOf(variable);
+}
+
+const char* GEMSelectOptions<SelectOptionProvider>::getOptionNameByIndex(GEMSelect* select, int index) {
+  return ((SelectOptionProvider*)select->_options)->name(index);
+}
+
+void GEMSelectOptions<SelectOptionProvider>::setValue(GEMSelect* select, void* variable, int index) {
+  ((SelectOptionProvider*)select->_options)->apply(variable, index);
+}
+
+size_t GEMSelectOptions<SelectOptionProvider>::getOptionsSize(GEMSelect* /* select */) {
+  return sizeof(SelectOptionProvider);
+}
+
+// Type of the variable is unknown to the select, so text label of the selected option is stored in place of its value
+byte GEMSelectOptions<SelectOptionProvider>::getValueSize(GEMSelect* /* select */) {
+  return GEM_STR_LEN;
+}
+
+void GEMSelectOptions<SelectOptionProvider>::readValue(GEMSelect* select, void* variable, byte* data) {
+  strncpy((char*)data, select->getSelectedOptionName(variable), GEM_STR_LEN - 1);
+  data[GEM_STR_LEN - 1] = '\0';
+}
+
+int GEMSelectOptions<SelectOptionProvider>::findValue(GEMSelect* select, const byte* data) {
+  SelectOptionProvider* provider = (SelectOptionProvider*)select->_options;
+  int length = provider->count();
+  for (int i = 0; i < length; i++) {
+    const char* name = provider->name(i);
+    if (name != nullptr && strncmp(name, (const char*)data, GEM_STR_LEN - 1) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const GEMSelectOps GEMSelectOptions<SelectOptionProvider>::ops = {
+  GEMSelectOptions<SelectOptionProvider>::getLength,
+  GEMSelectOptions<SelectOptionProvider>::getSelectedOptionNum,
+  GEMSelectOptions<SelectOptionProvider>::getOptionNameByIndex,
+  GEMSelectOptions<SelectOptionProvider>::setValue,
+  GEMSelectOptions<SelectOptionProvider>::getOptionsSize,
+  GEMSelectOptions<SelectOptionProvider>::getValueSize,
+  GEMSelectOptions<SelectOptionProvider>::readValue,
+  GEMSelectOptions<SelectOptionProvider>::findValue
+};
+
+//---
+
+// Options of the range are never stored: count, value and index of the option are calculated arithmetically.
+// Differences of the values are calculated in unsigned long, as they may exceed the range of long where it is as wide as int
+// (e.g. whole range of int on 32-bit boards); unsigned arithmetic wraps around, yet difference itself is never negative
+template <typename R>
+static int getRangeLength(R* range) {
+  if (range->step <= 0 || range->max < range->min) {
+    return 0;
+  }
+  // Count of the options can exceed the range of int (e.g. whole range of int with step 1), so it is capped,
+  // leaving options past INT_MAX out of the select
+  unsigned long span = ((unsigned long)range->max - (unsigned long)range->min) / (unsigned long)range->step;
+  return (span >= INT_MAX) ? INT_MAX : span + 1;
+}
+
+template <typename R>
+static int getRangeOptionNum(R* range, long value) {
+  if (value < range->min || value > range->max || range->step <= 0) {
+    return -1;
+  }
+  unsigned long offset = (unsigned long)value - (unsigned long)range->min;
+  if (offset % (unsigned long)range->step != 0) {
+    return -1;
+  }
+  unsigned long index = offset / (unsigned long)range->step;
+  return (index >= (unsigned long)getRangeLength(range)) ? -1 : (int)index;
+}
+
+template <typename R>
+static int getRangeOptionValue(R* range, int index) {
+  return (int)((unsigned long)range->min + (unsigned long)index * (unsigned long)range->step);
+}
+
+template <typename R>
+static const char* getRangeOptionName(R* range, int index, char* buffer) {
+  int value = getRangeOptionValue(range, index);
+  if (range->format != nullptr) {
+    range->format(value, buffer);
+    buffer[GEM_STR_LEN - 1] = '\0';
+  } else {
+    GEMFormatInt(value, buffer);
+  }
+  return buffer;
+}
+
+int GEMSelectOptions<SelectOptionRangeInt>::getLength(GEMSelect* select) {
+  return getRangeLength((SelectOptionRangeInt*)select->_options);
+}
+
+int GEMSelectOptions<SelectOptionRangeInt>::getSelectedOptionNum(GEMSelect* select, void* variable) {
+  return getRangeOptionNum((SelectOptionRangeInt*)select->_options, *(int*)variable);
+}
+
+const char* GEMSelectOptions<SelectOptionRangeInt>::getOptionNameByIndex(GEMSelect* select, int index) {
+  return getRangeOptionName((SelectOptionRangeInt*)select->_options, index, GEMSelect::_optionName);
+}
+
+void GEMSelectOptions<SelectOptionRangeInt>::setValue(GEMSelect* select, void* variable, int index) {
+  *(int*)variable = getRangeOptionValue((SelectOptionRangeInt*)select->_options, index);
+}
+
+size_t GEMSelectOptions<SelectOptionRangeInt>::getOptionsSize(GEMSelect* /* select */) {
+  return sizeof(SelectOptionRangeInt);
+}
+
+byte GEMSelectOptions<SelectOptionRangeInt>::getValueSize(GEMSelect* /* select */) {
+  return sizeof(int);
+}
+
+void GEMSelectOptions<SelectOptionRangeInt>::readValue(GEMSelect* /* select */, void* variable, byte* data) {
+  memcpy(data, variable, sizeof(int));
+}
+
+int GEMSelectOptions<SelectOptionRangeInt>::findValue(GEMSelect* select, const byte* data) {
+  int value;
+  memcpy(&value, data, sizeof(int));
+  return getRangeOptionNum((SelectOptionRangeInt*)select->_options, value);
+}
+
+const GEMSelectOps GEMSelectOptions<SelectOptionRangeInt>::ops = {
+  GEMSelectOptions<SelectOptionRangeInt>::getLength,
+  GEMSelectOptions<SelectOptionRangeInt>::getSelectedOptionNum,
+  GEMSelectOptions<SelectOptionRangeInt>::getOptionNameByIndex,
+  GEMSelectOptions<SelectOptionRangeInt>::setValue,
+  GEMSelectOptions<SelectOptionRangeInt>::getOptionsSize,
+  GEMSelectOptions<SelectOptionRangeInt>::getValueSize,
+  GEMSelectOptions<SelectOptionRangeInt>::readValue,
+  GEMSelectOptions<SelectOptionRangeInt>::findValue
+};
+
+int GEMSelectOptions<SelectOptionRangeByte>::getLength(GEMSelect* select) {
+  return getRangeLength((SelectOptionRangeByte*)select->_options);
+}
+
+int GEMSelectOptions<SelectOptionRangeByte>::getSelectedOptionNum(GEMSelect* select, void* variable) {
+  return getRangeOptionNum((SelectOptionRangeByte*)select->_options, *(byte*)variable);
+}
+
+const char* GEMSelectOptions<SelectOptionRangeByte>::getOptionNameByIndex(GEMSelect* select, int index) {
+  return getRangeOptionName((SelectOptionRangeByte*)select->_options, index, GEMSelect::_optionName);
 }
+
+void GEMSelectOptions<SelectOptionRangeByte>::setValue(GEMSelect* select, void* variable, int index) {
+  *(byte*)variable = getRangeOptionValue((SelectOptionRangeByte*)select->_options, index);
+}
+
+size_t GEMSelectOptions<SelectOptionRangeByte>::getOptionsSize(GEMSelect* /* select */) {
+  return sizeof(SelectOptionRangeByte);
+}
+
+byte GEMSelectOptions<SelectOptionRangeByte>::getValueSize(GEMSelect* /* select */) {
+  return sizeof(byte);
+}
+
+void GEMSelectOptions<SelectOptionRangeByte>::readValue(GEMSelect* /* select */, void* variable, byte* data) {
+  memcpy(data, variable, sizeof(byte));
+}
+
+int GEMSelectOptions<SelectOptionRangeByte>::findValue(GEMSelect* select, const byte* data) {
+  byte value;
+  memcpy(&value, data, sizeof(byte));
+  return getRangeOptionNum((SelectOptionRangeByte*)select->_options, value);
+}
+
+const GEMSelectOps GEMSelectOptions<SelectOptionRangeByte>::ops = {
+  GEMSelectOptions<SelectOptionRangeByte>::getLength,
+  GEMSelectOptions<SelectOptionRangeByte>::getSelectedOptionNum,
+  GEMSelectOptions<SelectOptionRangeByte>::getOptionNameByIndex,
+  GEMSelectOptions<SelectOptionRangeByte>::setValue,
+  GEMSelectOptions<SelectOptionRangeByte>::getOptionsSize,
+  GEMSelectOptions<SelectOptionRangeByte>::getValueSize,
+  GEMSelectOptions<SelectOptionRangeByte>::readValue,
+  GEMSelectOptions<SelectOptionRangeByte>::findValue
+};
@@ -35,6 +35,9 @@
 #ifndef HEADER_GEMSELECT
 #define HEADER_GEMSELECT
 
+#include <Arduino.h>
+#include "constants.h"
+
 // Declaration of SelectOptionInt type
 struct SelectOptionInt {
   char* name;    // Text label of the option as displayed in select
@@ -65,30 +68,408 @@ struct SelectOptionDouble {
   double val_double;
 };
 
+// Declaration of SelectOptionProvider type (options of the select are produced on demand by the user-defined callbacks,
+// so no array of options has to be kept in RAM)
+struct SelectOptionProvider {
+  int (*count)();                            // Pointer to function that returns number of the currently available options
+  const char* (*name)(int index);            // Pointer to function that returns text label of the option with the supplied index
+  void (*apply)(void* variable, int index);  // Pointer to function that assigns value of the option with the supplied index to linked variable
+  int (*indexOf)(void* variable);            // Pointer to function that returns index of the option matching current value of linked variable (or -1 if there is no such option)
+};
+
+// Declaration of SelectOptionRangeInt type (options of the select are calculated from the range,
+// so no array of options has to be kept in RAM)
+struct SelectOptionRangeInt {
+  int min;                                   // Value of the first option
+  int max;                                   // Value of the last option (the last option is the greatest value not exceeding max, reachable from min with step)
+  int step;                                  // Difference between values of the adjacent options (should be positive)
+  void (*format)(int value, char* buffer);   // Pointer to function that prints text label of the option into supplied buffer of GEM_STR_LEN size (optional,
+                                             // value itself is printed if nullptr)
+};
+
+// Declaration of SelectOptionRangeByte type
+struct SelectOptionRangeByte {
+  byte min;
+  byte max;
+  byte step;
+  void (*format)(int value, char* buffer);
+};
+
+// Forward declaration of necessary classes
+class GEMSelect;
+
+// Declaration of GEMSelectOps type (set of functions implementing option select for the particular kind of options;
+// one table per kind is shared by all of the selects of that kind)
+struct GEMSelectOps {
+  int (*getLength)(GEMSelect* select);
+  int (*getSelectedOptionNum)(GEMSelect* select, void* variable);
+  const char* (*getOptionNameByIndex)(GEMSelect* select, int index);  // Index is guaranteed to be within range
+  void (*setValue)(GEMSelect* select, void* variable, int index);     // Index is guaranteed to be within range
+  size_t (*getOptionsSize)(GEMSelect* select);                       // RAM taken by the options (0 if they are kept in PROGMEM), see GEMFootprint
+  byte (*getValueSize)(GEMSelect* select);                           // Size of the value in its stored form (up to GEM_SELECT_VALUE_LEN bytes)
+  void (*readValue)(GEMSelect* select, void* variable, byte* data);  // Copy value of the variable into data in its stored form
+  int (*findValue)(GEMSelect* select, const byte* data);             // Find index of the option with the value stored in data (-1 if there is no such option)
+};
+
+// Value of any of the supported types of options (aligned, so that stored value can be matched against the options in place)
+union GEMSelectValue {
+  int valInt;
+  byte valByte;
+  char valChar[GEM_STR_LEN];
+  float valFloat;
+  double valDouble;
+};
+
+// Comparison and assignment of the option value for each of the supported types of options
+// (not defined for other types, so GEMSelect can't be created with an array of unsupported options)
+template <typename T>
+struct GEMSelectOption;
+
+template <>
+struct GEMSelectOption<SelectOptionInt> {
+  static bool matches(const SelectOptionInt& option, void* variable) { return option.val_int == *(int*)variable; }
+  static void assign(const SelectOptionInt& option, void* variable) { *(int*)variable = option.val_int; }
+  static const byte size = sizeof(int);
+  static void read(void* variable, byte* data) { memcpy(data, variable, sizeof(int)); }
+};
+
+template <>
+struct GEMSelectOption<SelectOptionByte> {
+  static bool matches(const SelectOptionByte& option, void* variable) { return option.val_byte == *(byte*)variable; }
+  static void assign(const SelectOptionByte& option, void* variable) { *(byte*)variable = option.val_byte; }
+  static const byte size = sizeof(byte);
+  static void read(void* variable, byte* data) { memcpy(data, variable, sizeof(byte)); }
+};
+
+template <>
+struct GEMSelectOption<SelectOptionChar> {
+  static bool matches(const SelectOptionChar& option, void* variable) { return strcmp(option.val_char, (char*)variable) == 0; }
+  static void assign(const SelectOptionChar& option, void* variable) { strcpy((char*)variable, option.val_char); }
+  static const byte size = GEM_STR_LEN;
+  static void read(void* variable, byte* data) { strncpy((char*)data, (char*)variable, GEM_STR_LEN - 1); data[GEM_STR_LEN - 1] = '\0'; }
+};
+
+template <>
+struct GEMSelectOption<SelectOptionFloat> {
+  static bool matches(const SelectOptionFloat& option, void* variable) { return option.val_float == *(float*)variable; }
+  static void assign(const SelectOptionFloat& option, void* variable) { *(float*)variable = option.val_float; }
+  static const byte size = sizeof(float);
+  static void read(void* variable, byte* data) { memcpy(data, variable, sizeof(float)); }
+};
+
+template <>
+struct GEMSelectOption<SelectOptionDouble> {
+  static bool matches(const SelectOptionDouble& option, void* variable) { return option.val_double == *(double*)variable; }
+  static void assign(const SelectOptionDouble& option, void* variable) { *(double*)variable = option.val_double; }
+  static const byte size = sizeof(double);
+  static void read(void* variable, byte* data) { memcpy(data, variable, sizeof(double)); }
+};
+
+// Implementation of option select for array of options of type T
+template <typename T>
+struct GEMSelectOptions {
+  static int getLength(GEMSelect* select);
+  static int getSelectedOptionNum(GEMSelect* select, void* variable);
+  static const char* getOptionNameByIndex(GEMSelect* select, int index);
+  static void setValue(GEMSelect* select, void* variable, int index);
+  static size_t getOptionsSize(GEMSelect* select);
+  static byte getValueSize(GEMSelect* select);
+  static void readValue(GEMSelect* select, void* variable, byte* data);
+  static int findValue(GEMSelect* select, const byte* data);
+  static const GEMSelectOps ops;
+};
+
+// Implementation of option select, backed by SelectOptionProvider callbacks
+template <>
+struct GEMSelectOptions<SelectOptionProvider> {
+  static int getLength(GEMSelect* select);
+  static int getSelectedOptionNum(GEMSelect* select, void* variable);
+  static const char* getOptionNameByIndex(GEMSelect* select, int index);
+  static void setValue(GEMSelect* select, void* variable, int index);
+  static size_t getOptionsSize(GEMSelect* select);
+  static byte getValueSize(GEMSelect* select);
+  static void readValue(GEMSelect* select, void* variable, byte* data);
+  static int findValue(GEMSelect* select, const byte* data);
+  static const GEMSelectOps ops;
+};
+
+// Implementation of option select, calculated from SelectOptionRangeInt and SelectOptionRangeByte ranges
+template <>
+struct GEMSelectOptions<SelectOptionRangeInt> {
+  static int getLength(GEMSelect* select);
+  static int getSelectedOptionNum(GEMSelect* select, void* variable);
+  static const char* getOptionNameByIndex(GEMSelect* select, int index);
+  static void setValue(GEMSelect* select, void* variable, int index);
+  static size_t getOptionsSize(GEMSelect* select);
+  static byte getValueSize(GEMSelect* select);
+  static void readValue(GEMSelect* select, void* variable, byte* data);
+  static int findValue(GEMSelect* select, const byte* data);
+  static const GEMSelectOps ops;
+};
+
+template <>
+struct GEMSelectOptions<SelectOptionRangeByte> {
+  static int getLength(GEMSelect* select);
+  static int getSelectedOptionNum(GEMSelect* select, void* variable);
+  static const char* getOptionNameByIndex(GEMSelect* select, int index);
+  static void setValue(GEMSelect* select, void* variable, int index);
+  static size_t getOptionsSize(GEMSelect* select);
+  static byte getValueSize(GEMSelect* select);
+  static void readValue(GEMSelect* select, void* variable, byte* data);
+  static int findValue(GEMSelect* select, const byte* data);
+  static const GEMSelectOps ops;
+};
+
 // Declaration of GEMSelect class
 class GEMSelect {
   friend class GEM;
   friend class GEM_u8g2;
+  friend class GEMItem;
+  friend class GEMEdit;
+  friend class GEMFootprint;
+  template <typename T> friend struct GEMSelectOptions;
+  template <typename E, E... Values> friend class GEMSelectEnum;
   public:
     /* 
       @param 'length_' - length of the 'options_' array
-      @param 'options_' - array of the available options
+      @param 'options_' - array of the available options (of type SelectOptionInt, SelectOptionByte, SelectOptionChar, SelectOptionFloat or SelectOptionDouble)
     */
-    GEMSelect(byte length_, SelectOptionInt* options_);
-    GEMSelect(byte length_, SelectOptionByte* options_);
-    GEMSelect(byte length_, SelectOptionChar* options_);
-    GEMSelect(byte length_, SelectOptionFloat* options_);
-    GEMSelect(byte length_, SelectOptionDouble* options_);
+    template <typename T>
+    GEMSelect(byte length_, T* options_)
+      : _ops(&GEMSelectOptions<T>::ops)
+      , _length(length_)
+      , _options(options_)
+    { }
+    /* 
+      @param 'provider_' - reference to SelectOptionProvider with callbacks that produce options of the select on demand
+    */
+    GEMSelect(SelectOptionProvider& provider_);
+    /* 
+      @param 'range_' - reference to SelectOptionRangeInt (for int variable) or SelectOptionRangeByte (for byte variable) range
+      the options of the select are calculated from
+    */
+    GEMSelect(SelectOptionRangeInt& range_);
+    GEMSelect(SelectOptionRangeByte& range_);
   private:
-    byte _type;
+    GEMSelect(const GEMSelectOps* ops_, byte length_, void* options_);
+    const GEMSelectOps* _ops;
     byte _length;
     void* _options;
-    byte getType();
-    byte getLength();
+    static char _optionName[GEM_STR_LEN];                                 // Text label of the last option calculated on demand (valid until the next request)
+    static const char* getProgmemOptionName(const char* names, int index);  // Copy label with the supplied index from PROGMEM list of '\0'-separated labels
+    int getLength();
     int getSelectedOptionNum(void* variable);
     char* getSelectedOptionName(void* variable);
     char* getOptionNameByIndex(int index);
     void setValue(void* variable, int index);  // Assign value of the selected option to supplied variable
+    size_t getOptionsSize();
+    byte getValueSize();
+    void readValue(void* variable, byte* data);
+    int findValue(const byte* data);
+};
+
+// Compile-time helpers of GEMSelectEnum (greatest of the enum values, and index of the enum value in the list)
+constexpr unsigned GEMEnumMax(unsigned max) {
+  return max;
+}
+
+template <typename E, typename... Rest>
+constexpr unsigned GEMEnumMax(unsigned max, E first, Rest... rest) {
+  return GEMEnumMax((unsigned)first > max ? (unsigned)first : max, rest...);
+}
+
+constexpr byte GEMEnumIndex(unsigned, byte) {
+  return 0xFF;
+}
+
+template <typename E, typename... Rest>
+constexpr byte GEMEnumIndex(unsigned value, byte index, E first, Rest... rest) {
+  return (unsigned)first == value ? index : GEMEnumIndex(value, index + 1, rest...);
+}
+
+template <unsigned... I>
+struct GEMIndexSequence { };
+
+template <unsigned N, unsigned... I>
+struct GEMMakeIndexSequence : GEMMakeIndexSequence<N - 1, N - 1, I...> { };
+
+template <unsigned... I>
+struct GEMMakeIndexSequence<0, I...> {
+  typedef GEMIndexSequence<I...> type;
+};
+
+// Lookup table (stored in PROGMEM) that maps each value from 0 to the greatest enum value to the index of the option (0xFF if value is not in the list)
+template <typename S, typename E, E... Values>
+struct GEMEnumLookup;
+
+template <unsigned... I, typename E, E... Values>
+struct GEMEnumLookup<GEMIndexSequence<I...>, E, Values...> {
+  static const byte table[sizeof...(I)];
+};
+
+template <unsigned... I, typename E, E... Values>
+const byte GEMEnumLookup<GEMIndexSequence<I...>, E, Values...>::table[sizeof...(I)] PROGMEM = { GEMEnumIndex(I, 0, Values...)... };
+
+// Declaration of GEMSelectEnum class (option select of enum variable, with the list of values and lookup table generated at compile time and stored in PROGMEM)
+template <typename E, E... Values>
+class GEMSelectEnum : public GEMSelect {
+  static_assert(__is_enum(E), "GEMSelectEnum should be used with enum type");
+  static_assert(sizeof...(Values) > 0 && sizeof...(Values) < 256, "GEMSelectEnum should list from 1 to 255 values");
+  static_assert(GEMEnumMax(0, Values...) < 256, "Values of GEMSelectEnum should be in range from 0 to 255");
+  public:
+    /* 
+      @param 'names_' - PROGMEM string with text labels of the options (in the same order as values), separated by '\0' character, e.g. "Off\0Auto\0Manual"
+    */
+    GEMSelectEnum(const char* names_);
+    static const E values[sizeof...(Values)];
+    typedef GEMEnumLookup<typename GEMMakeIndexSequence<GEMEnumMax(0, Values...) + 1>::type, E, Values...> lookup;
+};
+
+// Implementation of option select of enum variable, listed in GEMSelectEnum
+template <typename E, E... Values>
+struct GEMSelectOptions<GEMSelectEnum<E, Values...>> {
+  typedef GEMSelectEnum<E, Values...> Select;
+  static int getLength(GEMSelect* select);
+  static int getSelectedOptionNum(GEMSelect* select, void* variable);
+  static const char* getOptionNameByIndex(GEMSelect* select, int index);
+  static void setValue(GEMSelect* select, void* variable, int index);
+  static size_t getOptionsSize(GEMSelect* select);
+  static byte getValueSize(GEMSelect* select);
+  static void readValue(GEMSelect* select, void* variable, byte* data);
+  static int findValue(GEMSelect* select, const byte* data);
+  static const GEMSelectOps ops;
+};
+
+template <typename T>
+int GEMSelectOptions<T>::getLength(GEMSelect* select) {
+  return select->_length;
+}
+
+template <typename T>
+int GEMSelectOptions<T>::getSelectedOptionNum(GEMSelect* select, void* variable) {
+  T* options = (T*)select->_options;
+  for (byte i=0; i<select->_length; i++) {
+    if (GEMSelectOption<T>::matches(options[i], variable)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+template <typename T>
+const char* GEMSelectOptions<T>::getOptionNameByIndex(GEMSelect* select, int index) {
+  return ((T*)select->_options)[index].name;
+}
+
+template <typename T>
+void GEMSelectOptions<T>::setValue(GEMSelect* select, void* variable, int index) {
+  GEMSelectOption<T>::assign(((T*)select->_options)[index], variable);
+}
+
+template <typename T>
+size_t GEMSelectOptions<T>::getOptionsSize(GEMSelect* select) {
+  size_t size = select->_length * sizeof(T);
+  for (byte i=0; i<select->_length; i++) {
+    size += strlen(((T*)select->_options)[i].name) + 1;
+  }
+  return size;
+}
+
+template <typename T>
+byte GEMSelectOptions<T>::getValueSize(GEMSelect* /* select */) {
+  return GEMSelectOption<T>::size;
+}
+
+template <typename T>
+void GEMSelectOptions<T>::readValue(GEMSelect* /* select */, void* variable, byte* data) {
+  GEMSelectOption<T>::read(variable, data);
+}
+
+template <typename T>
+int GEMSelectOptions<T>::findValue(GEMSelect* select, const byte* data) {
+  GEMSelectValue value;
+  memcpy(&value, data, GEMSelectOption<T>::size);
+  value.valChar[GEM_STR_LEN - 1] = '\0'; // In case of char[] value
+  return getSelectedOptionNum(select, &value);
+}
+
+template <typename T>
+const GEMSelectOps GEMSelectOptions<T>::ops = {
+  GEMSelectOptions<T>::getLength,
+  GEMSelectOptions<T>::getSelectedOptionNum,
+  GEMSelectOptions<T>::getOptionNameByIndex,
+  GEMSelectOptions<T>::setValue,
+  GEMSelectOptions<T>::getOptionsSize,
+  GEMSelectOptions<T>::getValueSize,
+  GEMSelectOptions<T>::readValue,
+  GEMSelectOptions<T>::findValue
+};
+
+template <typename E, E... Values>
+GEMSelectEnum<E, Values...>::GEMSelectEnum(const char* names_)
+  : GEMSelect(&GEMSelectOptions<GEMSelectEnum>::ops, sizeof...(Values), const_cast<char*>(names_))
+{ }
+
+template <typename E, E... Values>
+const E GEMSelectEnum<E, Values...>::values[sizeof...(Values)] PROGMEM = { Values... };
+
+template <typename E, E... Values>
+int GEMSelectOptions<GEMSelectEnum<E, Values...>>::getLength(GEMSelect* /* select */) {
+  return sizeof...(Values);
+}
+
+template <typename E, E... Values>
+int GEMSelectOptions<GEMSelectEnum<E, Values...>>::getSelectedOptionNum(GEMSelect* /* select */, void* variable) {
+  unsigned value = (unsigned)*(E*)variable;
+  if (value > GEMEnumMax(0, Values...)) {
+    return -1;
+  }
+  byte index = pgm_read_byte(&Select::lookup::table[value]);
+  return (index != 0xFF) ? index : -1;
+}
+
+template <typename E, E... Values>
+const char* GEMSelectOptions<GEMSelectEnum<E, Values...>>::getOptionNameByIndex(GEMSelect* select, int index) {
+  return GEMSelect::getProgmemOptionName((const char*)select->_options, index);
+}
+
+template <typename E, E... Values>
+void GEMSelectOptions<GEMSelectEnum<E, Values...>>::setValue(GEMSelect* /* select */, void* variable, int index) {
+  memcpy_P(variable, &Select::values[index], sizeof(E));
+}
+
+template <typename E, E... Values>
+size_t GEMSelectOptions<GEMSelectEnum<E, Values...>>::getOptionsSize(GEMSelect* /* select */) {
+  return 0; // Labels and values are kept in PROGMEM
+}
+
+template <typename E, E... Values>
+byte GEMSelectOptions<GEMSelectEnum<E, Values...>>::getValueSize(GEMSelect* /* select */) {
+  return sizeof(E);
+}
+
+template <typename E, E... Values>
+void GEMSelectOptions<GEMSelectEnum<E, Values...>>::readValue(GEMSelect* /* select */, void* variable, byte* data) {
+  memcpy(data, variable, sizeof(E));
+}
+
+template <typename E, E... Values>
+int GEMSelectOptions<GEMSelectEnum<E, Values...>>::findValue(GEMSelect* select, const byte* data) {
+  E value;
+  memcpy(&value, data, sizeof(E));
+  return getSelectedOptionNum(select, &value);
+}
+
+template <typename E, E... Values>
+const GEMSelectOps GEMSelectOptions<GEMSelectEnum<E, Values...>>::ops = {
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::getLength,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::getSelectedOptionNum,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::getOptionNameByIndex,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::setValue,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::getOptionsSize,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::getValueSize,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::readValue,
+  GEMSelectOptions<GEMSelectEnum<E, Values...>>::findValue
 };
   
 #endif
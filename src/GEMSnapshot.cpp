@@ -0,0 +1,290 @@
+/*
+  GEMSnapshot - binary snapshot and restore of the values of the whole menu for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <Arduino.h>
+#include "GEMSnapshot.h"
+#include "GEMPersist.h"
+
+#define GEM_SNAPSHOT_MAGIC_0 'G'
+#define GEM_SNAPSHOT_MAGIC_1 'S'
+
+// State of the snapshot being written
+struct GEMSnapshotWriter {
+  Print* out;
+  uint16_t crc;
+  uint16_t crcEntry;
+  unsigned int count;
+  void write(byte data) {
+    out->write(data);
+    crc = GEMCrc16(crc, data);
+    crcEntry = GEMCrc16(crcEntry, data);
+  }
+};
+
+//====================== MENU WALK
+
+void GEMSnapshot::beginWalk(GEMPage& root, GEMSnapshotCursor& cursor) {
+  cursor.root = &root;
+  cursor.depth = 0;
+  cursor.pages[0] = &root;
+  cursor.items[0] = root._menuItem;
+}
+
+GEMItem* GEMSnapshot::nextMenuItem(GEMSnapshotCursor& cursor) {
+  while (true) {
+    GEMItem* menuItem = cursor.items[cursor.depth];
+    if (menuItem == nullptr) {
+      if (cursor.depth == 0) {
+        return nullptr;
+      }
+      cursor.depth--;
+      continue;
+    }
+    cursor.items[cursor.depth] = menuItem->menuItemNext;
+    // Hidden menu items are included, so that their values are part of the snapshot too; linked page is entered
+    // right after the menu item that links to it
+    if ((menuItem->type == GEM_ITEM_LINK || menuItem->type == GEM_ITEM_LINKED_VAL) && menuItem->linkedPage != nullptr && cursor.depth + 1 < GEM_SNAPSHOT_MAX_DEPTH) {
+      bool onPath = false;
+      for (byte i = 0; i <= cursor.depth; i++) {
+        onPath = onPath || cursor.pages[i] == menuItem->linkedPage;
+      }
+      if (!onPath) {
+        cursor.depth++;
+        cursor.pages[cursor.depth] = menuItem->linkedPage;
+        cursor.items[cursor.depth] = menuItem->linkedPage->_menuItem;
+      }
+    }
+    if (menuItem->type == GEM_ITEM_VAL || menuItem->type == GEM_ITEM_LINKED_VAL) {
+      return menuItem;
+    }
+  }
+}
+
+GEMItem* GEMSnapshot::findMenuItem(GEMSnapshotCursor& cursor, byte id) {
+  // Search resumes right after the previous match and wraps around once, so entries written in the order of the walk
+  // (as save() does) are each found in a single step
+  GEMItem* first = nullptr;
+  bool wrapped = false;
+  while (id != 0) {
+    GEMItem* menuItem = nextMenuItem(cursor);
+    if (menuItem == nullptr) {
+      if (wrapped) {
+        break;
+      }
+      wrapped = true;
+      beginWalk(*cursor.root, cursor);
+      continue;
+    }
+    if (menuItem == first) {
+      break;
+    }
+    if (first == nullptr) {
+      first = menuItem;
+    }
+    if (menuItem->id == id) {
+      return menuItem;
+    }
+  }
+  return nullptr;
+}
+
+bool GEMSnapshot::walk(GEMPage& root, bool (*visit)(GEMItem& menuItem, void* context), void* context) {
+  GEMSnapshotCursor cursor;
+  beginWalk(root, cursor);
+  for (GEMItem* menuItem = nextMenuItem(cursor); menuItem != nullptr; menuItem = nextMenuItem(cursor)) {
+    if (!visit(*menuItem, context)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+GEMItem* GEMSnapshot::findMenuItem(GEMPage& root, byte id) {
+  GEMSnapshotCursor cursor;
+  beginWalk(root, cursor);
+  return findMenuItem(cursor, id);
+}
+
+//====================== SAVE
+
+bool GEMSnapshot::saveMenuItem(GEMItem& menuItem, void* context) {
+  GEMSnapshotWriter* writer = (GEMSnapshotWriter*)context;
+  byte size = menuItem.getValueSize();
+  if (menuItem.id == 0 || size == 0) {
+    return true;
+  }
+  writer->crcEntry = 0xFFFF;
+  writer->write(menuItem.id);
+  writer->write(menuItem.linkedType);
+  writer->write(size);
+  if (menuItem.linkedType == GEM_VAL_SELECT) {
+    byte data[GEM_SELECT_VALUE_LEN];
+    menuItem.readValue(data);
+    for (byte i = 0; i < size; i++) {
+      writer->write(data[i]);
+    }
+  } else {
+    // Value is written straight from the linked variable
+    for (byte i = 0; i < size; i++) {
+      writer->write(((byte*)menuItem.linkedVariable)[i]);
+    }
+  }
+  uint16_t crcEntry = writer->crcEntry;
+  writer->write(crcEntry & 0xFF);
+  writer->write(crcEntry >> 8);
+  writer->count++;
+  return true;
+}
+
+unsigned int GEMSnapshot::save(GEMPage& root, Print& out) {
+  GEMSnapshotWriter writer = {&out, 0xFFFF, 0xFFFF, 0};
+  writer.write(GEM_SNAPSHOT_MAGIC_0);
+  writer.write(GEM_SNAPSHOT_MAGIC_1);
+  writer.write(GEM_SNAPSHOT_VERSION);
+  walk(root, saveMenuItem, &writer);
+  writer.write(0); // End marker
+  uint16_t crc = writer.crc;
+  out.write(crc & 0xFF);
+  out.write(crc >> 8);
+  return writer.count;
+}
+
+//====================== RESTORE
+
+// Read next byte of the snapshot (waiting for it up to the timeout of the stream), updating checksums; returns false if there is no more data
+static bool readSnapshotByte(Stream& in, byte& data, uint16_t& crc, uint16_t& crcEntry) {
+  if (in.readBytes(&data, 1) != 1) {
+    return false;
+  }
+  crc = GEMCrc16(crc, data);
+  crcEntry = GEMCrc16(crcEntry, data);
+  return true;
+}
+
+static bool readSnapshotCrc(Stream& in, uint16_t& crc) {
+  byte data[2];
+  if (in.readBytes(data, 2) != 2) {
+    return false;
+  }
+  crc = data[0] | (data[1] << 8);
+  return true;
+}
+
+byte GEMSnapshot::restore(GEMPage& root, Stream& in) {
+  unsigned int applied;
+  return restore(root, in, applied);
+}
+
+byte GEMSnapshot::restore(GEMPage& root, Stream& in, unsigned int& applied) {
+  byte buffer[GEM_SNAPSHOT_BUFFER_LEN];
+  return restore(root, in, buffer, GEM_SNAPSHOT_BUFFER_LEN, applied);
+}
+
+byte GEMSnapshot::restore(GEMPage& root, Stream& in, byte* buffer, unsigned int bufferSize, unsigned int& applied) {
+  applied = 0;
+  uint16_t crc = 0xFFFF;
+  uint16_t crcEntry = 0xFFFF;
+  byte header[3];
+  for (byte i = 0; i < 3; i++) {
+    if (!readSnapshotByte(in, header[i], crc, crcEntry)) {
+      return GEM_SNAPSHOT_INVALID;
+    }
+  }
+  if (header[0] != GEM_SNAPSHOT_MAGIC_0 || header[1] != GEM_SNAPSHOT_MAGIC_1 || header[2] != GEM_SNAPSHOT_VERSION) {
+    return GEM_SNAPSHOT_INVALID;
+  }
+  unsigned int staged = 0;
+  bool skipped = false;
+  GEMSnapshotCursor cursor;
+  beginWalk(root, cursor);
+  while (true) {
+    crcEntry = 0xFFFF;
+    byte id;
+    if (!readSnapshotByte(in, id, crc, crcEntry)) {
+      return GEM_SNAPSHOT_CORRUPT;
+    }
+    if (id == 0) {
+      uint16_t crcStored;
+      if (!readSnapshotCrc(in, crcStored) || crcStored != crc) {
+        return GEM_SNAPSHOT_CORRUPT;
+      }
+      break;
+    }
+    byte linkedType;
+    byte size;
+    if (!readSnapshotByte(in, linkedType, crc, crcEntry) || !readSnapshotByte(in, size, crc, crcEntry)) {
+      return GEM_SNAPSHOT_CORRUPT;
+    }
+    GEMItem* menuItem = findMenuItem(cursor, id);
+    // Values of unknown menu items, or of menu items which type has changed, are skipped silently (as they can't be applied
+    // anyway); values that don't fit the rest of the buffer are skipped as well, but are reported
+    bool stage = menuItem != nullptr && menuItem->linkedType == linkedType && menuItem->getValueSize() == size;
+    if (stage && staged + 2 + size > bufferSize) {
+      stage = false;
+      skipped = true;
+    }
+    if (stage) {
+      buffer[staged] = id;
+      buffer[staged + 1] = size;
+    }
+    for (byte i = 0; i < size; i++) {
+      byte data;
+      if (!readSnapshotByte(in, data, crc, crcEntry)) {
+        return GEM_SNAPSHOT_CORRUPT;
+      }
+      if (stage) {
+        buffer[staged + 2 + i] = data;
+      }
+    }
+    uint16_t crcCalculated = crcEntry;
+    uint16_t crcStored;
+    if (!readSnapshotCrc(in, crcStored) || crcStored != crcCalculated) {
+      return GEM_SNAPSHOT_CORRUPT;
+    }
+    crc = GEMCrc16(crc, crcStored & 0xFF);
+    crc = GEMCrc16(crc, crcStored >> 8);
+    if (stage) {
+      staged += 2 + size;
+    }
+  }
+  // Whole snapshot is verified, so staged values are applied (menu items are looked up again, in the same order)
+  beginWalk(root, cursor);
+  for (unsigned int i = 0; i < staged; i += 2 + buffer[i + 1]) {
+    GEMItem* menuItem = findMenuItem(cursor, buffer[i]);
+    if (menuItem != nullptr && menuItem->writeValue(buffer + i + 2)) {
+      applied++;
+    }
+  }
+  return skipped ? GEM_SNAPSHOT_PARTIAL : GEM_SNAPSHOT_OK;
+}
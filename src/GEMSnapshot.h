@@ -0,0 +1,101 @@
+/*
+  GEMSnapshot - binary snapshot and restore of the values of the whole menu for GEM library.
+
+  GEM (a.k.a. Good Enough Menu) - Arduino library for creation of graphic multi-level menu with
+  editable menu items, such as variables (supports int, byte, float, double, bool, char[17] data types)
+  and option selects. User-defined callback function can be specified to invoke when menu item is saved.
+  
+  Supports buttons that can invoke user-defined actions and create action-specific
+  context, which can have its own enter (setup) and exit callbacks as well as loop function.
+
+  Supports AltSerialGraphicLCD library by Jon Green (http://www.jasspa.com/serialGLCD.html)
+  and U8g2 library by olikraus (https://github.com/olikraus/U8g2_Arduino).
+
+  For documentation visit:
+  https://github.com/Spirik/GEM
+
+  Copyright (c) 2018-2020 Alexander 'Spirik' Spiridonov
+
+  This file is part of GEM library.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+  
+  You should have received a copy of the GNU Lesser General Public License
+  along with this library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADER_GEMSNAPSHOT
+#define HEADER_GEMSNAPSHOT
+
+#include <Arduino.h>
+#include "GEMPage.h"
+#include "GEMItem.h"
+#include "constants.h"
+
+// Macro constants (aliases) for the status of the snapshot restore
+#define GEM_SNAPSHOT_OK 0       // Snapshot is valid, all of its values (of known menu items) are applied
+#define GEM_SNAPSHOT_INVALID 1  // Data is not a snapshot (or snapshot of unsupported version), nothing is applied
+#define GEM_SNAPSHOT_CORRUPT 2  // Snapshot is truncated or damaged, nothing is applied
+#define GEM_SNAPSHOT_PARTIAL 3  // Snapshot is valid, but some of its values don't fit the buffer and are skipped, the rest are applied
+
+// Position of the walk over the menu items reachable from the root menu page (see GEMSnapshot::nextMenuItem())
+struct GEMSnapshotCursor {
+  GEMPage* root;
+  byte depth;
+  GEMPage* pages[GEM_SNAPSHOT_MAX_DEPTH];  // Menu pages on the current path
+  GEMItem* items[GEM_SNAPSHOT_MAX_DEPTH];  // Next menu item to visit on each of the pages of the path
+};
+
+// Declaration of GEMSnapshot class
+// Snapshot consists of the header ('G', 'S', version), entries of the menu items that have ID set (ID, type of the variable, size of the value,
+// value itself as returned by GEMItem::readValue(), CRC-16 of the entry), end marker (0) and CRC-16 of the whole snapshot
+class GEMSnapshot {
+  public:
+    /* 
+      Write values of all menu items (that have ID set) reachable from the root menu page, without intermediate buffer
+      @param 'root' - menu page to start from (menu items of child pages linked from it are included)
+      @param 'out' - destination of the snapshot (e.g. Serial or File)
+      returns number of menu items written
+    */
+    static unsigned int save(GEMPage& root, Print& out);
+    /* 
+      Read snapshot and assign its values to menu items (matched by ID, type and size) reachable from the root menu page.
+      Values are staged in the buffer (each preceded by ID and size) and applied only after CRC of the whole snapshot is verified,
+      so truncated or damaged snapshot is never applied. Values that don't fit the rest of the buffer are skipped (and reported
+      with GEM_SNAPSHOT_PARTIAL status); buffer of GEM_SNAPSHOT_BUFFER_LEN bytes on stack is used unless one is supplied
+      @param 'root' - menu page to start from
+      @param 'in' - source of the snapshot (reads are subject to timeout of the stream)
+      @param 'buffer' (optional) - buffer to stage values in, e.g. to restore long string variables
+      @param 'bufferSize' (optional) - size of the buffer
+      @param 'applied' (optional) - number of values applied
+      returns GEM_SNAPSHOT_OK, GEM_SNAPSHOT_INVALID, GEM_SNAPSHOT_CORRUPT, GEM_SNAPSHOT_PARTIAL
+    */
+    static byte restore(GEMPage& root, Stream& in);
+    static byte restore(GEMPage& root, Stream& in, unsigned int& applied);
+    static byte restore(GEMPage& root, Stream& in, byte* buffer, unsigned int bufferSize, unsigned int& applied);
+    /* 
+      Call function for each menu item with associated variable reachable from the root menu page
+      (pages are entered up to GEM_SNAPSHOT_MAX_DEPTH levels deep, links back to the pages on the current path are not followed)
+      @param 'root' - menu page to start from
+      @param 'visit' - pointer to function called for each menu item, should return false to stop
+      @param 'context' - pointer passed to the function as is
+      returns false if stopped by the function
+    */
+    static bool walk(GEMPage& root, bool (*visit)(GEMItem& menuItem, void* context), void* context);
+    static GEMItem* findMenuItem(GEMPage& root, byte id);  // Find menu item with the supplied ID reachable from the root menu page (or nullptr)
+    static void beginWalk(GEMPage& root, GEMSnapshotCursor& cursor);  // Start walk over menu items with associated variable (in the same order as walk())
+    static GEMItem* nextMenuItem(GEMSnapshotCursor& cursor);          // Get next menu item of the walk (nullptr at the end)
+  private:
+    static bool saveMenuItem(GEMItem& menuItem, void* context);
+    static GEMItem* findMenuItem(GEMSnapshotCursor& cursor, byte id);
+};
+
+#endif
@@ -35,23 +35,22 @@
 
 #ifdef GEM_ENABLE_U8G2_VERSION
 
-// AVR-based Arduinos have suppoort for dtostrf, others require manual inclusion,
-// see https://github.com/plotly/arduino-api/issues/38#issuecomment-108987647;
-// the same goes for itoa support on some non-AVR boards
-#ifndef __AVR__
-#include <avr/dtostrf.h>
-#include <itoa.h>
+#include "GEMFormat.h"
+#include "GEMProfiler.h"    // Timing hooks of drawMenu(), no-op unless GEM_ENABLE_PROFILER is defined
+#include "GEMBusCounter.h"  // Frame hooks of drawMenu(), no-op unless GEM_ENABLE_BUS_COUNTER is defined
+#include <limits.h>
+
+// Read character of the string stored either in RAM or in flash memory (PROGMEM), e.g. title set with F() macro
+#define GEM_READ_CHAR(str, index, progmem) ((progmem) ? (char)pgm_read_byte((str) + (index)) : (str)[index])
+
+// Type of the menu pointer drawn, constant if only one type of the pointer is supported (see config.h)
+#if defined(GEM_SUPPORT_POINTER_DASH) && defined(GEM_SUPPORT_POINTER_ROW)
+  #define GEM_MENU_POINTER_TYPE _menuPointerType
+#elif defined(GEM_SUPPORT_POINTER_DASH)
+  #define GEM_MENU_POINTER_TYPE GEM_POINTER_DASH
+#else
+  #define GEM_MENU_POINTER_TYPE GEM_POINTER_ROW
 #endif
-
-// Macro constants (aliases) for some of the ASCII character codes
-#define GEM_CHAR_CODE_9 57
-#define GEM_CHAR_CODE_0 48
-#define GEM_CHAR_CODE_MINUS 45
-#define GEM_CHAR_CODE_DOT 46
-#define GEM_CHAR_CODE_SPACE 32
-#define GEM_CHAR_CODE_UNDERSCORE 95
-#define GEM_CHAR_CODE_LINE 124
-#define GEM_CHAR_CODE_TILDA 126
 /*
 // WIP for Cyrillic values support
 #define GEM_CHAR_CODE_CYR_YO 1025
@@ -133,9 +132,6 @@ GEM_u8g2::GEM_u8g2(U8G2& u8g2_, byte menuPointerType_, byte menuItemsPerScreen_,
   _splash = {logo_width, logo_height, logo_bits};
   clearContext();
   _editValueMode = false;
-  _editValueCursorPosition = 0;
-  memset(_valueString, '\0', GEM_STR_LEN - 1);
-  _valueSelectNum = -1;
 }
 
 //====================== INIT OPERATIONS
@@ -148,6 +144,7 @@ void GEM_u8g2::hideVersion(bool flag) {
   _enableVersion = !flag;
 }
 
+#ifdef GEM_SUPPORT_CYRILLIC
 void GEM_u8g2::enableCyrillic(bool flag) {
   _cyrillicEnabled = flag;
   if (_cyrillicEnabled) {
@@ -158,6 +155,7 @@ void GEM_u8g2::enableCyrillic(bool flag) {
     _u8g2.disableUTF8Print();
   }
 }
+#endif
 
 void GEM_u8g2::init() {
   _u8g2.clear();
@@ -204,11 +202,13 @@ void GEM_u8g2::reInit() {
   _u8g2.clear();
   _u8g2.setDrawColor(1);
   _u8g2.setFontPosTop();
+  #ifdef GEM_SUPPORT_CYRILLIC
   if (_cyrillicEnabled) {
     _u8g2.enableUTF8Print();
   } else {
     _u8g2.disableUTF8Print();
   }
+  #endif
 }
 
 void GEM_u8g2::setMenuPageCurrent(GEMPage& menuPageCurrent) {
@@ -224,33 +224,81 @@ void GEM_u8g2::clearContext() {
   context.allowExit = true;
 }
 
+//====================== PROFILING
+
+#ifdef GEM_ENABLE_PROFILER
+void GEM_u8g2::setProfiler(GEMProfiler& profiler) {
+  _profiler = &profiler;
+}
+#endif
+
+//====================== BUS TRAFFIC
+
+#ifdef GEM_ENABLE_BUS_COUNTER
+// Byte callback of U8g2 is wrapped to count bytes and transfers before they are passed to the original one
+// (single counter and display at a time, since callback has no reference to GEM_u8g2 object)
+static GEMBusCounter* busCounter = nullptr;
+static u8x8_msg_cb busByteCallback = nullptr;
+
+static uint8_t countBusBytes(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+  if (msg == U8X8_MSG_BYTE_SEND) {
+    busCounter->add(arg_int, 0);
+  } else if (msg == U8X8_MSG_BYTE_START_TRANSFER) {
+    busCounter->add(0, 1);
+  }
+  return busByteCallback(u8x8, msg, arg_int, arg_ptr);
+}
+
+void GEM_u8g2::setBusCounter(GEMBusCounter& counter) {
+  _busCounter = &counter;
+  busCounter = &counter;
+  u8x8_t* u8x8 = _u8g2.getU8x8();
+  if (u8x8->byte_cb != countBusBytes) {
+    busByteCallback = u8x8->byte_cb;
+    u8x8->byte_cb = countBusBytes;
+  }
+}
+#endif
+
 //====================== DRAW OPERATIONS
 
 void GEM_u8g2::drawMenu() {
   // _u8g2.clear(); // Not clearing for better performance
-  _u8g2.firstPage();
+  GEM_PROFILE_FRAME_BEGIN(_profiler);
+  GEM_BUS_FRAME_BEGIN(_busCounter);
+  GEM_PROFILE_PHASE(_profiler, GEM_PHASE_CLEAR, _u8g2.firstPage());
+  bool nextPage;
   do {
-    drawTitleBar();
-    printMenuItems();
-    drawMenuPointer();
-    drawScrollbar();
-  } while (_u8g2.nextPage());
+    GEM_PROFILE_PHASE(_profiler, GEM_PHASE_TITLE, drawTitleBar());
+    GEM_PROFILE_PHASE(_profiler, GEM_PHASE_ITEMS, printMenuItems());
+    GEM_PROFILE_PHASE(_profiler, GEM_PHASE_POINTER, drawMenuPointer());
+    GEM_PROFILE_PHASE(_profiler, GEM_PHASE_SCROLLBAR, drawScrollbar());
+    GEM_PROFILE_PHASE(_profiler, GEM_PHASE_TRANSFER, nextPage = _u8g2.nextPage());
+  } while (nextPage);
+  GEM_BUS_FRAME_END(_busCounter);
+  GEM_PROFILE_FRAME_END(_profiler);
 }
 
 void GEM_u8g2::drawTitleBar() {
  _u8g2.setFont(_fontFamilies.small);
  _u8g2.setCursor(5, 0);
- _u8g2.print(_menuPageCurrent->title);
+ if (_menuPageCurrent->titleProgmem) {
+   _u8g2.print(reinterpret_cast<const __FlashStringHelper*>(_menuPageCurrent->title));
+ } else {
+   _u8g2.print(_menuPageCurrent->title);
+ }
  _u8g2.setFont(_menuItemFontSize ? _fontFamilies.small : _fontFamilies.big);
 }
 
-void GEM_u8g2::printMenuItemString(const char* str, byte num, byte startPos) {
+void GEM_u8g2::printMenuItemString(const char* str, byte num, byte startPos, bool progmem) {
+  #ifdef GEM_SUPPORT_CYRILLIC
   if (_cyrillicEnabled) {
 
     byte j = 0;
     byte p = 0;
-    while (j < startPos && str[p] != '\0') {
-      if ((byte)str[p] != 208 && (byte)str[p] != 209) {
+    char c;
+    while (j < startPos && (c = GEM_READ_CHAR(str, p, progmem)) != '\0') {
+      if ((byte)c != 208 && (byte)c != 209) {
         j++;
       }
       p++;
@@ -259,27 +307,30 @@ void GEM_u8g2::printMenuItemString(const char* str, byte num, byte startPos) {
 
     byte i = startPosReal;
     byte k = startPosReal;
-    while (i < num + startPosReal && str[k] != '\0') {
-      _u8g2.print(str[k]);
-      if ((byte)str[k] != 208 && (byte)str[k] != 209) {
+    while (i < num + startPosReal && (c = GEM_READ_CHAR(str, k, progmem)) != '\0') {
+      _u8g2.print(c);
+      if ((byte)c != 208 && (byte)c != 209) {
         i++;
       }
       k++;
     }
 
-  } else {
+  } else
+  #endif
+  {
 
     byte i = startPos;
-    while (i < num + startPos && str[i] != '\0') {
-      _u8g2.print(str[i]);
+    char c;
+    while (i < num + startPos && (c = GEM_READ_CHAR(str, i, progmem)) != '\0') {
+      _u8g2.print(c);
       i++;
     }
 
   }
 }
 
-void GEM_u8g2::printMenuItemTitle(const char* str, int offset) {
-  printMenuItemString(str, _menuItemTitleLength + offset);
+void GEM_u8g2::printMenuItemTitle(const char* str, int offset, bool progmem) {
+  printMenuItemString(str, _menuItemTitleLength + offset, 0, progmem);
 }
 
 void GEM_u8g2::printMenuItemValue(const char* str, int offset, byte startPos) {
@@ -305,25 +356,35 @@ void GEM_u8g2::printMenuItemValue(GEMItem* menuItemTmp, byte yDraw, byte yText)
   }
 
   // print item value on screen - print conversion dependent on tpye
-  char valueStringTmp[GEM_STR_LEN];
-  memset(valueStringTmp, '\0', GEM_STR_LEN - 1);
   switch (menuItemTmp->linkedType) {
     case GEM_VAL_INTEGER:
-        itoa(*(int*)menuItemTmp->linkedVariable, valueStringTmp, 10);
-        printMenuItemValuePrintFunction(valueStringTmp, yText,(menuItemTmp->title == nullptr));
+        GEMFormatInt(*(int*)menuItemTmp->linkedVariable, _formatBuffer);
+        printMenuItemValuePrintFunction(_formatBuffer, yText,(menuItemTmp->title == nullptr));
       break;
     case GEM_VAL_BYTE:
-        itoa(*(byte*)menuItemTmp->linkedVariable, valueStringTmp, 10);
-        printMenuItemValuePrintFunction(valueStringTmp, yText, (menuItemTmp->title == nullptr));
+        GEMFormatInt(*(byte*)menuItemTmp->linkedVariable, _formatBuffer);
+        printMenuItemValuePrintFunction(_formatBuffer, yText, (menuItemTmp->title == nullptr));
       break;
     case GEM_VAL_CHAR:
+    #ifdef GEM_SUPPORT_STRING_BUFFER
+    case GEM_VAL_STRING:
+    #endif
         printMenuItemValuePrintFunction((const char*)menuItemTmp->linkedVariable, yText, (menuItemTmp->title == nullptr));
       break;
+    #ifdef GEM_SUPPORT_FIXED_POINT
+    case GEM_VAL_FIXED16:
+    case GEM_VAL_FIXED32:
+        GEMEdit::formatFixed(menuItemTmp, _formatBuffer, true);
+        printMenuItemValuePrintFunction(_formatBuffer, yText, (menuItemTmp->title == nullptr));
+      break;
+    #endif
+    #ifdef GEM_SUPPORT_CALLBACK_VALUE
     case GEM_VAL_CALLBACK:
         if (menuItemTmp->getValue != nullptr) {
           printMenuItemValuePrintFunction(menuItemTmp->getValue(), yText, (menuItemTmp->title == nullptr));
         }
       break;
+    #endif
     case GEM_VAL_BOOL:
       if (*(bool*)menuItemTmp->linkedVariable) {
         _u8g2.drawXBMP(_menuValuesLeftOffset, yDraw, checkboxChecked_width, checkboxChecked_height, checkboxChecked_bits);
@@ -331,6 +392,7 @@ void GEM_u8g2::printMenuItemValue(GEMItem* menuItemTmp, byte yDraw, byte yText)
         _u8g2.drawXBMP(_menuValuesLeftOffset, yDraw, checkboxUnchecked_width, checkboxUnchecked_height, checkboxUnchecked_bits);
       }
       break;
+    #ifdef GEM_SUPPORT_SELECT
     case GEM_VAL_SELECT:
       {
         GEMSelect* select = menuItemTmp->select;
@@ -338,25 +400,22 @@ void GEM_u8g2::printMenuItemValue(GEMItem* menuItemTmp, byte yDraw, byte yText)
           _u8g2.drawXBMP(_u8g2.getDisplayWidth() - 7, yDraw, selectArrows_width, selectArrows_height, selectArrows_bits);
       }
       break;
+    #endif
     #ifdef GEM_SUPPORT_FLOAT_EDIT
     case GEM_VAL_FLOAT:
-        // sprintf(valueStringTmp,"%.6f", *(float*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-        dtostrf(*(float*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, valueStringTmp);
-        printMenuItemValuePrintFunction(valueStringTmp, yText, (menuItemTmp->title == nullptr));
+        GEMFormatFloat(*(float*)menuItemTmp->linkedVariable, menuItemTmp->precision, _formatBuffer, sizeof(_formatBuffer));
+        printMenuItemValuePrintFunction(_formatBuffer, yText, (menuItemTmp->title == nullptr));
       break;
     case GEM_VAL_DOUBLE:
-        // sprintf(valueStringTmp,"%.6f", *(double*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-        dtostrf(*(double*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, valueStringTmp);
-        printMenuItemValuePrintFunction(valueStringTmp, yText, (menuItemTmp->title == nullptr));
+        GEMFormatFloat(*(double*)menuItemTmp->linkedVariable, menuItemTmp->precision, _formatBuffer, sizeof(_formatBuffer));
+        printMenuItemValuePrintFunction(_formatBuffer, yText, (menuItemTmp->title == nullptr));
       break;
     #endif
   }
-  // ensure srting termination
-  memset(valueStringTmp, '\0', GEM_STR_LEN - 1);
 }
 
-void GEM_u8g2::printMenuItemFull(const char* str, int offset) {
-  printMenuItemString(str, _menuItemTitleLength + _menuItemValueLength + offset);
+void GEM_u8g2::printMenuItemFull(const char* str, int offset, bool progmem) {
+  printMenuItemString(str, _menuItemTitleLength + _menuItemValueLength + offset, 0, progmem);
 }
 
 byte GEM_u8g2::getMenuItemInsetOffset(bool forSprite) {
@@ -373,6 +432,7 @@ void GEM_u8g2::printMenuItems() {
   byte y = _menuPageScreenTopOffset;
   byte i = 0;
   while (menuItemTmp != 0 && i < _menuItemsPerScreen) {
+    GEM_PROFILE_ITEM_BEGIN();
     byte yText = y + getMenuItemInsetOffset() - 4;
     byte yDraw = y + getMenuItemInsetOffset(true);
     switch (menuItemTmp->type) {
@@ -380,7 +440,7 @@ void GEM_u8g2::printMenuItems() {
         // print item title without edit symbol
         if (menuItemTmp->title != nullptr){
           _u8g2.setCursor(5, yText);
-          printMenuItemTitle(menuItemTmp->title);
+          printMenuItemTitle(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
         }
 
         // print item value
@@ -392,18 +452,24 @@ void GEM_u8g2::printMenuItems() {
           case GEM_VAL_INTEGER:
           case GEM_VAL_BYTE:
           case GEM_VAL_CHAR:
-          case GEM_VAL_CALLBACK:
+          #ifdef GEM_SUPPORT_STRING_BUFFER
+          case GEM_VAL_STRING:
+          #endif
+          #ifdef GEM_SUPPORT_FIXED_POINT
+          case GEM_VAL_FIXED16:
+          case GEM_VAL_FIXED32:
+          #endif
           #ifdef GEM_SUPPORT_FLOAT_EDIT
           case GEM_VAL_FLOAT:
           case GEM_VAL_DOUBLE:
           #endif
-              _u8g2.setCursor(_editValuefullScreenWidth ? 11 : _menuValuesLeftOffset, yText);
-              printMenuItemString(_valueString, _editValuefullScreenWidth ? 11 : _menuItemValueLength, _editValueVirtualCursorPosition - _editValueCursorPosition);
-              drawEditValueCursor();
+              printEditValue();
             break;
           // draw item - there is no difference if in edit mode or not
           case GEM_VAL_BOOL:
+          #ifdef GEM_SUPPORT_SELECT
           case GEM_VAL_SELECT:
+          #endif
               printMenuItemValue(menuItemTmp, yDraw, yText);
             break;
         }
@@ -416,7 +482,7 @@ void GEM_u8g2::printMenuItems() {
       case GEM_ITEM_LINK:
         // print item value without read only marker
         _u8g2.setCursor(5, yText);
-        printMenuItemFull(menuItemTmp->title);
+        printMenuItemFull(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
 
         _u8g2.drawXBMP(_u8g2.getDisplayWidth() - 8, yDraw, arrowRight_width, arrowRight_height, arrowRight_bits);
         break;
@@ -424,17 +490,20 @@ void GEM_u8g2::printMenuItems() {
         _u8g2.setCursor(11, yText);
         _u8g2.drawXBMP(5, yDraw, arrowLeft_width, arrowLeft_height, arrowLeft_bits);
         break;
+      #ifdef GEM_SUPPORT_BUTTON
       case GEM_ITEM_BUTTON:
         // print item value without read only marker
         _u8g2.setCursor(11, yText);
-        printMenuItemFull(menuItemTmp->title);
+        printMenuItemFull(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
 
         _u8g2.drawXBMP(5, yDraw, arrowBtn_width, arrowBtn_height, arrowBtn_bits);
         break;
+      #endif
+      #ifdef GEM_SUPPORT_LINKED_VALUE
       case GEM_ITEM_LINKED_VAL:
         // print title
         _u8g2.setCursor(5, yText);
-        printMenuItemTitle(menuItemTmp->title);
+        printMenuItemTitle(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
 
         // print item value
         _u8g2.setCursor(_menuValuesLeftOffset, yText);
@@ -443,12 +512,16 @@ void GEM_u8g2::printMenuItems() {
         // draw the link arrow
         _u8g2.drawXBMP(_u8g2.getDisplayWidth() - 8, yDraw, arrowRight_width, arrowRight_height, arrowRight_bits);
         break;
+      #endif
+      #ifdef GEM_SUPPORT_TEXT
       case GEM_ITEM_TEXT:
         // print title
         _u8g2.setCursor(5, yText);
-        printMenuItemFull(menuItemTmp->title);
+        printMenuItemFull(menuItemTmp->title, 0, menuItemTmp->titleProgmem);
         break;
+      #endif
     }
+    GEM_PROFILE_ITEM_END(_profiler, menuItemTmp);
     menuItemTmp = menuItemTmp->getMenuItemNext();
     y += _menuItemHeight;
     i++;
@@ -459,7 +532,7 @@ void GEM_u8g2::drawMenuPointer() {
   if (_menuPageCurrent->itemsCount > 0) {
     GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
     int pointerPosition = getCurrentItemTopOffset(true);
-    if (_menuPointerType == GEM_POINTER_DASH) {
+    if (GEM_MENU_POINTER_TYPE == GEM_POINTER_DASH) {
       if (menuItemTmp->readonly) {
         for (byte i = 0; i < (_menuItemHeight - 1) / 2; i++) {
           _u8g2.drawPixel(0, pointerPosition + i * 2);
@@ -496,26 +569,28 @@ void GEM_u8g2::drawScrollbar() {
 
 //====================== MENU ITEMS NAVIGATION
 
-void GEM_u8g2::nextMenuItem() {
-  if (_menuPageCurrent->currentItemNum == _menuPageCurrent->itemsCount-1) {
-    _menuPageCurrent->currentItemNum = 0;
-  } else {
-    _menuPageCurrent->currentItemNum++;
-  }
-  if (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_TEXT){
-    nextMenuItem();
+void GEM_u8g2::nextMenuItem(byte steps) {
+  for (; steps > 0; steps--) {
+    do {
+      if (_menuPageCurrent->currentItemNum == _menuPageCurrent->itemsCount-1) {
+        _menuPageCurrent->currentItemNum = 0;
+      } else {
+        _menuPageCurrent->currentItemNum++;
+      }
+    } while (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_TEXT);
   }
   drawMenu();
 }
 
-void GEM_u8g2::prevMenuItem() {
-  if (_menuPageCurrent->currentItemNum == 0) {
-    _menuPageCurrent->currentItemNum = _menuPageCurrent->itemsCount-1;
-  } else {
-    _menuPageCurrent->currentItemNum--;
-  }
-  if (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_TEXT){
-    prevMenuItem();
+void GEM_u8g2::prevMenuItem(byte steps) {
+  for (; steps > 0; steps--) {
+    do {
+      if (_menuPageCurrent->currentItemNum == 0) {
+        _menuPageCurrent->currentItemNum = _menuPageCurrent->itemsCount-1;
+      } else {
+        _menuPageCurrent->currentItemNum--;
+      }
+    } while (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_TEXT);
   }
   drawMenu();
 }
@@ -539,17 +614,21 @@ void GEM_u8g2::menuItemSelect() {
       _menuPageCurrent = menuItemTmp->linkedPage;
       drawMenu();
       break;
+    #ifdef GEM_SUPPORT_BUTTON
     case GEM_ITEM_BUTTON:
       if (!menuItemTmp->readonly) {
         menuItemTmp->buttonAction();
       }
       break;
+    #endif
+    #ifdef GEM_SUPPORT_LINKED_VALUE
     case GEM_ITEM_LINKED_VAL:
       if (menuItemTmp->linkedPage != NULL){
         _menuPageCurrent = menuItemTmp->linkedPage;
         drawMenu();
       }
       break;
+    #endif
   }
 }
 
@@ -559,56 +638,23 @@ void GEM_u8g2::enterEditValueMode() {
   _editValueMode = true;
   
   GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  _editValueType = menuItemTmp->linkedType;
-  switch (_editValueType) {
-    case GEM_VAL_INTEGER:
-      itoa(*(int*)menuItemTmp->linkedVariable, _valueString, 10);
-      _editValueLength = (menuItemTmp->title == nullptr) ? 16 : 6;
-      initEditValueCursor(menuItemTmp->title == nullptr);
-      break;
-    case GEM_VAL_BYTE:
-      itoa(*(byte*)menuItemTmp->linkedVariable, _valueString, 10);
-      _editValueLength = (menuItemTmp->title == nullptr) ? 16 : 3;
-      initEditValueCursor(menuItemTmp->title == nullptr);
-      break;
-    case GEM_VAL_CHAR:
-      strcpy(_valueString, (const char*)menuItemTmp->linkedVariable);
-      _editValueLength = (menuItemTmp->title == nullptr) ? 16 : GEM_STR_LEN - 1;
-      initEditValueCursor(menuItemTmp->title == nullptr);
-      break;
-    case GEM_VAL_BOOL:
-      checkboxToggle();
-      drawMenu();
-      break;
-    case GEM_VAL_SELECT:
-      {
-        GEMSelect* select = menuItemTmp->select;
-        _valueSelectNum = select->getSelectedOptionNum(menuItemTmp->linkedVariable);
-        initEditValueCursor(menuItemTmp->title == nullptr);
-      }
-      break;
-    #ifdef GEM_SUPPORT_FLOAT_EDIT
-    case GEM_VAL_FLOAT:
-      // sprintf(_valueString,"%.6f", *(float*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-      dtostrf(*(float*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, _valueString);
-      _editValueLength = (menuItemTmp->title == nullptr) ? 16 : GEM_STR_LEN - 1;
-      initEditValueCursor(menuItemTmp->title == nullptr);
-      break;
-    case GEM_VAL_DOUBLE:
-      // sprintf(_valueString,"%.6f", *(double*)menuItemTmp->linkedVariable); // May work for non-AVR boards
-      dtostrf(*(double*)menuItemTmp->linkedVariable, menuItemTmp->precision + 1, menuItemTmp->precision, _valueString);
-      _editValueLength = (menuItemTmp->title == nullptr) ? 16 : GEM_STR_LEN - 1;
-      initEditValueCursor(menuItemTmp->title == nullptr);
-      break;
-    #endif
+  _edit.begin(menuItemTmp);
+  if (_edit.type == GEM_VAL_BOOL) {
+    checkboxToggle();
+    drawMenu();
+  } else {
+    if (menuItemTmp->title == nullptr && _edit.type != GEM_VAL_STRING) {
+      _edit.length = 16; // Value without title takes the whole width of the screen
+    }
+    initEditValueCursor(menuItemTmp->title == nullptr);
   }
 }
 
 void GEM_u8g2::checkboxToggle() {
   GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  int topOffset = getCurrentItemTopOffset(true, true);
   bool checkboxValue = *(bool*)menuItemTmp->linkedVariable;
   *(bool*)menuItemTmp->linkedVariable = !checkboxValue;
+  _runtime.markSaved(menuItemTmp);
   if (menuItemTmp->saveAction != nullptr) {
     menuItemTmp->saveAction();
     exitEditValue();
@@ -619,221 +665,147 @@ void GEM_u8g2::checkboxToggle() {
 
 void GEM_u8g2::initEditValueCursor(bool fullScreenWidth) {
   _editValueItemLength = fullScreenWidth ? (_menuItemTitleLength + _menuItemValueLength) : _menuItemValueLength ;
-  _editValueCursorPosition = 0;
-  _editValueVirtualCursorPosition = 0;
   _editValuefullScreenWidth = fullScreenWidth;
   drawMenu();
 }
 
-void GEM_u8g2::nextEditValueCursorPosition() {
-  if ((_editValueCursorPosition != _editValueItemLength - 1) && (_editValueCursorPosition != _editValueLength - 1) && (_valueString[_editValueCursorPosition] != '\0')) {
-    _editValueCursorPosition++;
-  }
-  if ((_editValueVirtualCursorPosition != _editValueLength - 1) && (_valueString[_editValueVirtualCursorPosition] != '\0')) {
-    _editValueVirtualCursorPosition++;
+void GEM_u8g2::nextEditValueCursorPosition(byte steps) {
+  byte cursorPositionPrev = _edit.cursorPosition;
+  byte windowOffsetPrev = _edit.getWindowOffset();
+  _edit.nextCursorPosition(steps, _editValueItemLength);
+  drawEditValueCursorMove(cursorPositionPrev, windowOffsetPrev);
+}
+
+void GEM_u8g2::prevEditValueCursorPosition(byte steps) {
+  byte cursorPositionPrev = _edit.cursorPosition;
+  byte windowOffsetPrev = _edit.getWindowOffset();
+  _edit.prevCursorPosition(steps);
+  drawEditValueCursorMove(cursorPositionPrev, windowOffsetPrev);
+}
+
+void GEM_u8g2::drawEditValueCursorMove(byte cursorPositionPrev, byte windowOffsetPrev) {
+  byte width = _menuItemFont[_menuItemFontSize].width;
+  if (windowOffsetPrev != _edit.getWindowOffset()) {
+    // Visible part of the value scrolled, so the whole value area is redrawn
+    drawEditValueAreaFull();
+  } else if (cursorPositionPrev != _edit.cursorPosition) {
+    // Only cells from the one the cursor left to the one it entered (may be several steps apart) are redrawn
+    byte cursorPositionMin = (cursorPositionPrev < _edit.cursorPosition) ? cursorPositionPrev : _edit.cursorPosition;
+    byte cursorPositionMax = (cursorPositionPrev < _edit.cursorPosition) ? _edit.cursorPosition : cursorPositionPrev;
+    drawEditValueArea(getEditValueCellLeft(cursorPositionMin) - 1, (cursorPositionMax - cursorPositionMin + 1) * width + 1);
   }
-  drawMenu();
 }
 
-void GEM_u8g2::prevEditValueCursorPosition() {
-  if (_editValueCursorPosition != 0) {
-    _editValueCursorPosition--;
+byte GEM_u8g2::getEditValueCellLeft(byte cursorPosition) {
+  return (_editValuefullScreenWidth ? 11 : _menuValuesLeftOffset) + cursorPosition * _menuItemFont[_menuItemFontSize].width;
+}
+
+void GEM_u8g2::printEditValue() {
+  _u8g2.setCursor(getEditValueCellLeft(0), getCurrentItemTopOffset(true) - 4);
+  printMenuItemString(_edit.getText(), _editValuefullScreenWidth ? 11 : _menuItemValueLength);
+  if (_edit.error) {
+    // Malformed value is shown inverted as a whole, in place of the cursor
+    _u8g2.setDrawColor(2);
+    _u8g2.drawBox(getEditValueCellLeft(0) - 1, getCurrentItemTopOffset(true) - 1, _editValueItemLength * _menuItemFont[_menuItemFontSize].width + 1, _menuItemHeight + 1);
+    _u8g2.setDrawColor(1);
+  } else {
+    drawEditValueCursor();
   }
-  if (_editValueVirtualCursorPosition != 0) {
-    _editValueVirtualCursorPosition--;
+}
+
+void GEM_u8g2::drawEditValueAreaFull() {
+  drawEditValueArea(getEditValueCellLeft(0) - 1, _editValueItemLength * _menuItemFont[_menuItemFontSize].width + 1);
+}
+
+void GEM_u8g2::drawEditValueArea(byte x, byte w) {
+  byte y = getCurrentItemTopOffset(true) - 1;
+  byte h = _menuItemHeight + 1;
+  byte tileRow = y / 8;
+  byte tileRows = (y + h + 7) / 8 - tileRow;
+  if (_u8g2.getBufferTileHeight() * 8 >= _u8g2.getDisplayHeight()) {
+    // Full frame buffer still holds the rest of the screen, so only the area itself is redrawn (clipped) and sent to display
+    _u8g2.setClipWindow(x, y, x + w, y + h);
+    _u8g2.setDrawColor(0);
+    _u8g2.drawBox(x, y, w, h);
+    _u8g2.setDrawColor(1);
+    printEditValue();
+    _u8g2.setMaxClipWindow();
+    _u8g2.updateDisplayArea(x / 8, tileRow, (x + w + 7) / 8 - x / 8, tileRows);
+  } else {
+    // Page buffer holds only part of the screen, so everything within affected tile rows is drawn anew, other rows are left intact
+    for (byte row = tileRow; row < tileRow + tileRows; row += _u8g2.getBufferTileHeight()) {
+      _u8g2.setBufferCurrTileRow(row);
+      _u8g2.clearBuffer();
+      drawTitleBar();
+      printMenuItems();
+      drawMenuPointer();
+      drawScrollbar();
+      _u8g2.sendBuffer();
+    }
   }
-  drawMenu();
 }
 
 void GEM_u8g2::drawEditValueCursor() {
   int pointerPosition = getCurrentItemTopOffset(true);
-  byte cursorLeftOffset = (_editValuefullScreenWidth ? 11 : _menuValuesLeftOffset) + _editValueCursorPosition * _menuItemFont[_menuItemFontSize].width;
+  byte cursorLeftOffset = getEditValueCellLeft(_edit.cursorPosition);
   _u8g2.setDrawColor(2);
-  if (_editValueType == GEM_VAL_SELECT) {
+  #ifdef GEM_SUPPORT_SELECT
+  if (_edit.type == GEM_VAL_SELECT) {
     _u8g2.drawBox(cursorLeftOffset - 1, pointerPosition - 1, _u8g2.getDisplayWidth() - cursorLeftOffset - 1, _menuItemHeight + 1);
-  } else {
+  } else
+  #endif
+  {
     _u8g2.drawBox(cursorLeftOffset - 1, pointerPosition - 1, _menuItemFont[_menuItemFontSize].width + 1, _menuItemHeight + 1);
   }
   _u8g2.setDrawColor(1);
 }
 
-void GEM_u8g2::nextEditValueDigit() {
-  char chr = _valueString[_editValueVirtualCursorPosition];
-  byte code = (byte)chr;
-  if (_editValueType == GEM_VAL_CHAR) {
-    switch (code) {
-      case 0:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_TILDA:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      /*
-      // WIP for Cyrillic values support
-      case GEM_CHAR_CODE_TILDA:
-        code = _cyrillicEnabled ? GEM_CHAR_CODE_CYR_A : GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_CYR_YA_SM:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_CYR_E:
-        code = GEM_CHAR_CODE_CYR_YO;
-        break;
-      case GEM_CHAR_CODE_CYR_YO:
-        code = GEM_CHAR_CODE_CYR_E + 1;
-        break;
-      case GEM_CHAR_CODE_CYR_E_SM:
-        code = GEM_CHAR_CODE_CYR_YO_SM;
-        break;
-      case GEM_CHAR_CODE_CYR_YO_SM:
-        code = GEM_CHAR_CODE_CYR_E_SM + 1;
-        break;
-      */
-      default:
-        code++;
-        break;
-    }
-  } else {
-    switch (code) {
-      case 0:
-        code = GEM_CHAR_CODE_0;
-        break;
-      case GEM_CHAR_CODE_9:
-        code = (_editValueCursorPosition == 0 && (_editValueType == GEM_VAL_INTEGER || _editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_MINUS:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = (_editValueCursorPosition != 0 && (_editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_DOT : GEM_CHAR_CODE_0;
-        break;
-      case GEM_CHAR_CODE_DOT:
-        code = GEM_CHAR_CODE_0;
-        break;
-      default:
-        code++;
-        break;
-    }
-  }
-  drawEditValueDigit(code);
+void GEM_u8g2::nextEditValueDigit(byte steps) {
+  drawEditValueDigit(_edit.nextCode(steps));
 }
 
-void GEM_u8g2::prevEditValueDigit() {
-  char chr = _valueString[_editValueVirtualCursorPosition];
-  byte code = (byte)chr;
-  if (_editValueType == GEM_VAL_CHAR) {
-    switch (code) {
-      case 0:
-        code = GEM_CHAR_CODE_TILDA;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = GEM_CHAR_CODE_TILDA;
-        break;
-      /*
-      // WIP for Cyrillic values support
-      case 0:
-        code = _cyrillicEnabled ? GEM_CHAR_CODE_CYR_YA_SM : GEM_CHAR_CODE_TILDA;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = _cyrillicEnabled ? GEM_CHAR_CODE_CYR_YA_SM : GEM_CHAR_CODE_TILDA;
-        break;
-      case GEM_CHAR_CODE_CYR_A:
-        code = GEM_CHAR_CODE_TILDA;
-        break;
-      case GEM_CHAR_CODE_CYR_E + 1:
-        code = GEM_CHAR_CODE_CYR_YO;
-        break;
-      case GEM_CHAR_CODE_CYR_YO:
-        code = GEM_CHAR_CODE_CYR_E;
-        break;
-      case GEM_CHAR_CODE_CYR_E_SM + 1:
-        code = GEM_CHAR_CODE_CYR_YO_SM;
-        break;
-      case GEM_CHAR_CODE_CYR_YO_SM:
-        code = GEM_CHAR_CODE_CYR_E_SM;
-        break;
-      */
-      default:
-        code--;
-        break;
-    }
-  } else {
-    switch (code) {
-      case 0:
-        code = (_editValueCursorPosition == 0 && (_editValueType == GEM_VAL_INTEGER || _editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_9;
-        break;
-      case GEM_CHAR_CODE_MINUS:
-        code = GEM_CHAR_CODE_9;
-        break;
-      case GEM_CHAR_CODE_0:
-        code = (_editValueCursorPosition != 0 && (_editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_DOT : GEM_CHAR_CODE_SPACE;
-        break;
-      case GEM_CHAR_CODE_SPACE:
-        code = (_editValueCursorPosition == 0 && (_editValueType == GEM_VAL_INTEGER || _editValueType == GEM_VAL_FLOAT || _editValueType == GEM_VAL_DOUBLE)) ? GEM_CHAR_CODE_MINUS : GEM_CHAR_CODE_9;
-        break;
-      case GEM_CHAR_CODE_DOT:
-        code = GEM_CHAR_CODE_SPACE;
-        break;
-      default:
-        code--;
-        break;
-    }
-  }
-  drawEditValueDigit(code);
+void GEM_u8g2::prevEditValueDigit(byte steps) {
+  drawEditValueDigit(_edit.prevCode(steps));
 }
 
 void GEM_u8g2::drawEditValueDigit(byte code) {
-  char chrNew = (char)code;
-  _valueString[_editValueVirtualCursorPosition] = chrNew;
-  drawMenu();
+  if (!_edit.setCode(code)) {
+    // Change is refused (see GEM_EDIT_JOURNAL_LEN), so value is shown inverted until the next key press
+    _edit.error = true;
+    drawEditValueAreaFull();
+    return;
+  }
+  drawEditValueArea(getEditValueCellLeft(_edit.cursorPosition) - 1, _menuItemFont[_menuItemFontSize].width + 1);
 }
 
-void GEM_u8g2::nextEditValueSelect() {
-  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  GEMSelect* select = menuItemTmp->select;
-  if (_valueSelectNum+1 < select->getLength()) {
-    _valueSelectNum++;
-  }
+#ifdef GEM_SUPPORT_SELECT
+void GEM_u8g2::nextEditValueSelect(byte steps) {
+  _edit.nextSelect(steps);
   drawMenu();
 }
 
-void GEM_u8g2::prevEditValueSelect() {
-  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  GEMSelect* select = menuItemTmp->select;
-  if (_valueSelectNum > 0) {
-    _valueSelectNum--;
-  }
+void GEM_u8g2::prevEditValueSelect(byte steps) {
+  _edit.prevSelect(steps);
   drawMenu();
 }
+#endif
 
 void GEM_u8g2::saveEditValue() {
-  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
-  void* temp;
-  switch (menuItemTmp->linkedType) {
-    case GEM_VAL_INTEGER:
-      *(int*)menuItemTmp->linkedVariable = atoi(_valueString);
-      break;
-    case GEM_VAL_BYTE:
-      *(byte*)menuItemTmp->linkedVariable = atoi(_valueString);
-      break;
-    case GEM_VAL_CHAR:
-      strcpy((char*)menuItemTmp->linkedVariable, trimString(_valueString)); // Potential overflow if string length is not defined
-      break;
-    case GEM_VAL_SELECT:
-      {
-        GEMSelect* select = menuItemTmp->select;
-        select->setValue(menuItemTmp->linkedVariable, _valueSelectNum);
-      }
-      break;
-    #ifdef GEM_SUPPORT_FLOAT_EDIT
-    case GEM_VAL_FLOAT:
-      *(float*)menuItemTmp->linkedVariable = atof(_valueString);
-      break;
-    case GEM_VAL_DOUBLE:
-      *(double*)menuItemTmp->linkedVariable = atof(_valueString);
-      break;
-    #endif
+  // Malformed or out of range value can't be saved, edit mode stays on until it is corrected or canceled
+  if (_edit.status == GEM_PARSE_RANGE) {
+    // Value is clamped to the range and shown, so that the next press of OK saves it
+    _edit.clamp();
+    drawEditValueAreaFull();
+    return;
+  } else if (_edit.status != GEM_PARSE_OK) {
+    // Value is shown inverted until the next key press
+    _edit.error = true;
+    drawEditValueAreaFull();
+    return;
   }
+  GEMItem* menuItemTmp = _menuPageCurrent->getCurrentMenuItem();
+  _edit.save();
+  _runtime.markSaved(menuItemTmp);
   if (menuItemTmp->saveAction != nullptr) {
     menuItemTmp->saveAction();
   }
@@ -841,41 +813,21 @@ void GEM_u8g2::saveEditValue() {
 }
 
 void GEM_u8g2::cancelEditValue() {
+  _edit.cancel();
   exitEditValue();
 }
 
 void GEM_u8g2::exitEditValue() {
-  memset(_valueString, '\0', GEM_STR_LEN - 1);
-  _valueSelectNum = -1;
+  _edit.end();
   _editValueMode = false;
   drawEditValueCursor();
   drawMenu();
 }
 
-// Trim leading/trailing whitespaces
-// Author: Adam Rosenfield, https://stackoverflow.com/a/122721
-char* GEM_u8g2::trimString(char* str) {
-  char *end;
-
-  // Trim leading space
-  while(isspace((unsigned char)*str)) str++;
-
-  if(*str == 0)  // All spaces?
-    return str;
-
-  // Trim trailing space
-  end = str + strlen(str) - 1;
-  while(end > str && isspace((unsigned char)*end)) end--;
-
-  // Write new null terminator
-  *(end+1) = 0;
-  
-  return str;
-}
-
 //====================== KEY DETECTION
 
 bool GEM_u8g2::readyForKey() {
+  runTasks();
   if ( (context.loop == nullptr) ||
       ((context.loop != nullptr) && (context.allowExit)) ) {
     return true;
@@ -887,10 +839,91 @@ bool GEM_u8g2::readyForKey() {
 }
 
 void GEM_u8g2::registerKeyPress(byte keyCode) {
+  registerKeyPress(keyCode, 1);
+}
+
+void GEM_u8g2::registerKeyPress(byte keyCode, byte count) {
   _currentKey = keyCode;
+  _currentKeyCount = count;
+  #ifdef GEM_ENABLE_BUS_COUNTER
+  // GEM_KEY_NONE (registered by readyForKey() while context is running) isn't counted as interaction
+  bool interaction = _busCounter != nullptr && keyCode != GEM_KEY_NONE;
+  if (interaction) {
+    _busCounter->beginInteraction();
+  }
+  #endif
   dispatchKeyPress();
+  #ifdef GEM_ENABLE_BUS_COUNTER
+  if (interaction) {
+    _busCounter->endInteraction();
+  }
+  #endif
 }
 
+#ifdef GEM_ENABLE_KEY_QUEUE
+bool GEM_u8g2::queueKeyPress(byte keyCode) {
+  return _runtime.getKeyQueue().push(keyCode);
+}
+
+void GEM_u8g2::processKeyQueue() {
+  _runtime.processKeyQueue(*this);
+}
+
+GEMKeyQueue& GEM_u8g2::getKeyQueue() {
+  return _runtime.getKeyQueue();
+}
+#endif
+
+#ifdef GEM_ENABLE_SCHEDULER
+void GEM_u8g2::addTask(GEMTask& task) {
+  _runtime.getScheduler().add(task);
+}
+
+void GEM_u8g2::removeTask(GEMTask& task) {
+  _runtime.getScheduler().remove(task);
+}
+
+GEMScheduler& GEM_u8g2::getScheduler() {
+  return _runtime.getScheduler();
+}
+#endif
+
+void GEM_u8g2::runTasks() {
+  // Tasks of the menu page run only while the page is on screen, i.e. not while context is running
+  _runtime.runTasks((context.loop == nullptr) ? _menuPageCurrent : nullptr);
+}
+
+#ifdef GEM_ENABLE_PERSIST
+void GEM_u8g2::setPersist(GEMPersist& persist) {
+  _runtime.setPersist(persist);
+}
+#endif
+
+unsigned long GEM_u8g2::nextDeadlineMillis() {
+  return _runtime.nextDeadlineMillis((context.loop == nullptr) ? _menuPageCurrent : nullptr);
+}
+
+#ifdef GEM_ENABLE_REMOTE
+void GEM_u8g2::processRemote(GEMRemote& remote) {
+  // Value being edited is locked, so that remote write isn't overwritten when edit is saved
+  GEMItem* menuItemLocked = _editValueMode ? _menuPageCurrent->getCurrentMenuItem() : nullptr;
+  // Full redraw includes the value being edited along with the cursor, so it is safe in edit mode as well
+  if (_runtime.processRemote(remote, menuItemLocked) && context.loop == nullptr) {
+    drawMenu();
+  }
+}
+#endif
+
+bool GEM_u8g2::isIdle() {
+  return (long)(nextDeadlineMillis() - millis()) > 0;
+}
+
+#ifdef GEM_ENABLE_ENCODER
+void GEM_u8g2::processEncoder(GEMEncoder& encoder) {
+  _runtime.processEncoder(*this, encoder, GEM_KEY_DOWN, GEM_KEY_UP);
+}
+#endif
+
 void GEM_u8g2::dispatchKeyPress() {
 
   if (context.loop != nullptr) {
@@ -908,29 +941,37 @@ void GEM_u8g2::dispatchKeyPress() {
   } else {
   
     if (_editValueMode) {
+      if (_edit.error) {
+        _edit.error = false;
+        drawEditValueAreaFull();
+      }
       switch (_currentKey) {
         case GEM_KEY_UP:
-          if (_editValueType == GEM_VAL_SELECT) {
-            prevEditValueSelect();
-          } else {
-            nextEditValueDigit();
+          #ifdef GEM_SUPPORT_SELECT
+          if (_edit.type == GEM_VAL_SELECT) {
+            prevEditValueSelect(_currentKeyCount);
+            break;
           }
+          #endif
+          nextEditValueDigit(_currentKeyCount);
           break;
         case GEM_KEY_RIGHT:
-          if (_editValueType != GEM_VAL_SELECT) {
-            nextEditValueCursorPosition();
+          if (_edit.type != GEM_VAL_SELECT) {
+            nextEditValueCursorPosition(_currentKeyCount);
           }
           break;
         case GEM_KEY_DOWN:
-          if (_editValueType == GEM_VAL_SELECT) {
-            nextEditValueSelect();
-          } else {
-            prevEditValueDigit();
+          #ifdef GEM_SUPPORT_SELECT
+          if (_edit.type == GEM_VAL_SELECT) {
+            nextEditValueSelect(_currentKeyCount);
+            break;
           }
+          #endif
+          prevEditValueDigit(_currentKeyCount);
           break;
         case GEM_KEY_LEFT:
-          if (_editValueType != GEM_VAL_SELECT) {
-            prevEditValueCursorPosition();
+          if (_edit.type != GEM_VAL_SELECT) {
+            prevEditValueCursorPosition(_currentKeyCount);
           }
           break;
         case GEM_KEY_CANCEL:
@@ -943,7 +984,7 @@ void GEM_u8g2::dispatchKeyPress() {
     } else {
       switch (_currentKey) {
         case GEM_KEY_UP:
-          prevMenuItem();
+          prevMenuItem(_currentKeyCount);
           break;
         case GEM_KEY_RIGHT:
           if (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_LINK ||
@@ -952,7 +993,7 @@ void GEM_u8g2::dispatchKeyPress() {
           }
           break;
         case GEM_KEY_DOWN:
-          nextMenuItem();
+          nextMenuItem(_currentKeyCount);
           break;
         case GEM_KEY_LEFT:
           if (_menuPageCurrent->getCurrentMenuItem()->type == GEM_ITEM_BACK) {
@@ -40,6 +40,38 @@
 #include <U8g2lib.h>
 #include "GEMPage.h"
 #include "GEMSelect.h"
+#include "GEMEdit.h"
+#include "GEMRuntime.h"
+#ifdef GEM_ENABLE_KEY_QUEUE
+#include "GEMKeyQueue.h"
+#endif
+#ifdef GEM_ENABLE_ENCODER
+#include "GEMEncoder.h"
+#endif
+#ifdef GEM_ENABLE_BUTTONS
+#include "GEMButtons.h"
+#endif
+#ifdef GEM_ENABLE_SCHEDULER
+#include "GEMScheduler.h"
+#endif
+#ifdef GEM_ENABLE_PERSIST
+#include "GEMPersist.h"
+#endif
+#ifdef GEM_ENABLE_SNAPSHOT
+#include "GEMSnapshot.h"
+#endif
+#ifdef GEM_ENABLE_REMOTE
+#include "GEMRemote.h"
+#endif
+#ifdef GEM_ENABLE_FOOTPRINT
+#include "GEMFootprint.h"
+#endif
+#ifdef GEM_ENABLE_PROFILER
+#include "GEMProfiler.h"
+#endif
+#ifdef GEM_ENABLE_BUS_COUNTER
+#include "GEMBusCounter.h"
+#endif
 #include "constants.h"
 
 // Macro constants (aliases) for u8g2 font families used to draw menu
@@ -115,7 +147,9 @@ class GEM_u8g2 {
 
     void setSplash(byte width, byte height, const unsigned char U8X8_PROGMEM *image); // Set custom XBM image displayed as the splash screen when GEM is being initialized. Should be called before GEM_u8g2::init().
     void hideVersion(bool flag = true);               // Turn printing of the current GEM library version on splash screen off or back on. Should be called before GEM_u8g2::init().
+    #ifdef GEM_SUPPORT_CYRILLIC
     void enableCyrillic(bool flag = true);            // Enable Cyrillic set of fonts. Generally should be called before GEM_u8g2::init(). To revert to non-Cyrillic fonts pass false: enableCyrillic(false).
+    #endif
     void init();                                         // Init the menu (set necessary settings, display GEM splash screen, etc.)
     void reInit();                                       // Reinitialize the menu (call U8g2::initDisplay() and then reapply GEM specific settings)
     void setMenuPageCurrent(GEMPage& menuPageCurrent);   // Set supplied menu page as current
@@ -125,6 +159,47 @@ class GEM_u8g2 {
     AppContext context;                                  // Currently set context
     void clearContext();                                 // Clear context
 
+    /* TASK OPERATIONS */
+
+    void runTasks();                                     // Run tasks that are due (called by readyForKey(), call explicitly if readyForKey() isn't used)
+    #ifdef GEM_ENABLE_SCHEDULER
+    void addTask(GEMTask& task);                         // Add periodic task (e.g. background work of the context or live value of the menu page), tasks are run by readyForKey()
+    void removeTask(GEMTask& task);                      // Remove task (e.g. in exit() function of the context)
+    GEMScheduler& getScheduler();                        // Get the scheduler of tasks (e.g. to set tick budget or check overruns)
+    #endif
+
+    /* PERSISTENCE */
+
+    #ifdef GEM_ENABLE_PERSIST
+    void setPersist(GEMPersist& persist);                // Set persistence of menu items' linked variables: saved items are marked as changed and written to storage
+                                                         // (along with tasks) after quiet period
+    #endif
+
+    /* REMOTE CONTROL */
+
+    #ifdef GEM_ENABLE_REMOTE
+    void processRemote(GEMRemote& remote);               // Process requests received by remote control (call from loop()): written values are saved
+                                                         // as if edited on the device (save action, persistence), followed by a single redraw
+    #endif
+
+    /* POWER MANAGEMENT */
+
+    unsigned long nextDeadlineMillis();                  // Get value of millis() by which loop() should be called again (unless key is pressed earlier),
+                                                         // e.g. to put MCU to sleep until then (up to GEM_DEADLINE_MAX_WAIT ms from now if menu waits for key press only)
+    bool isIdle();                                       // Check that menu has nothing to do right now (no running context, queued key presses or due tasks)
+
+    /* PROFILING */
+
+    #ifdef GEM_ENABLE_PROFILER
+    void setProfiler(GEMProfiler& profiler);             // Set profiler that times the phases of drawMenu() and the menu items being drawn
+    #endif
+
+    /* BUS TRAFFIC */
+
+    #ifdef GEM_ENABLE_BUS_COUNTER
+    void setBusCounter(GEMBusCounter& counter);          // Set counter of the bytes and transfers sent to display (through byte callback of U8g2), per frame and per interaction
+    #endif
+
     /* DRAW OPERATIONS */
 
     void drawMenu();                                     // Draw menu on screen, with menu page set earlier in GEM_u8g2::setMenuPageCurrent()
@@ -134,8 +209,22 @@ class GEM_u8g2 {
     bool readyForKey();                               // Check that menu is waiting for the key press
     void registerKeyPress(byte keyCode);                 // Register the key press and trigger corresponding action
                                                          // Accepts GEM_KEY_NONE, GEM_KEY_UP, GEM_KEY_RIGHT, GEM_KEY_DOWN, GEM_KEY_LEFT, GEM_KEY_CANCEL, GEM_KEY_OK values
+    void registerKeyPress(byte keyCode, byte count);     // Register the key press repeated count times (e.g. by accelerated encoder) as a single move with one redraw
+                                                         // (GEM_KEY_UP, GEM_KEY_RIGHT, GEM_KEY_DOWN, GEM_KEY_LEFT only, other keys are registered once)
+    #ifdef GEM_ENABLE_KEY_QUEUE
+    bool queueKeyPress(byte keyCode);                    // Add the key press to the queue without triggering any action, safe to call from interrupt service routine
+                                                         // (returns false if the queue of GEM_KEY_QUEUE_LEN key presses is full)
+    void processKeyQueue();                              // Register all queued key presses in order they were made (call from loop(), e.g. when readyForKey() returns true)
+    GEMKeyQueue& getKeyQueue();                          // Get the queue of key presses (e.g. to check timestamps or number of dropped key presses)
+    #endif
+    #ifdef GEM_ENABLE_ENCODER
+    void processEncoder(GEMEncoder& encoder);            // Register steps accumulated by rotary encoder as GEM_KEY_DOWN (clockwise) or GEM_KEY_UP (counterclockwise) key presses
+    #endif
   private:
     U8G2& _u8g2;
+    #ifdef GEM_ENABLE_BUS_COUNTER
+    GEMBusCounter* _busCounter = nullptr;
+    #endif
     byte _menuPointerType;
     byte _menuItemsPerScreen;
     byte _menuItemHeight;
@@ -144,7 +233,9 @@ class GEM_u8g2 {
     byte _menuItemFontSize;
     FontSize _menuItemFont[2];
     FontFamilies _fontFamilies;
+    #ifdef GEM_SUPPORT_CYRILLIC
     bool _cyrillicEnabled = false;
+    #endif
     byte _menuItemInsetOffset;
     byte _menuItemTitleLength;
     byte _menuItemValueLength;
@@ -155,56 +246,66 @@ class GEM_u8g2 {
 
     GEMPage* _menuPageCurrent;
     GEMItem* _menuItemCurrent;
+    char _formatBuffer[GEM_STR_LEN];  // Text representation of the value of the menu item being drawn (formatted anew for each menu item, never cleared)
     void layoutMenu();
     void drawTitleBar();
-    void printMenuItemString(const char* str, byte num, byte startPos = 0);
-    void printMenuItemTitle(const char* str, int offset = 0);
+    void printMenuItemString(const char* str, byte num, byte startPos = 0, bool progmem = false);
+    void printMenuItemTitle(const char* str, int offset = 0, bool progmem = false);
     void printMenuItemValue(const char* str, int offset = 0, byte startPos = 0);
     void printMenuItemValuePrintFunction(const char* str, byte yText, bool printFull = false);
     void printMenuItemValue(GEMItem* menuItemTmp, byte yDraw, byte yText);
-    void printMenuItemFull(const char* str, int offset = 0);
+    void printMenuItemFull(const char* str, int offset = 0, bool progmem = false);
     byte getMenuItemInsetOffset(bool forSprite = false);
     byte getCurrentItemTopOffset(bool withInsetOffset = true, bool forSprite = false);
     void printMenuItems();
     void drawMenuPointer();
     void drawScrollbar();
+    #ifdef GEM_ENABLE_PROFILER
+    GEMProfiler* _profiler = nullptr;
+    #endif
 
     /* MENU ITEMS NAVIGATION */
 
-    void nextMenuItem();
-    void prevMenuItem();
+    void nextMenuItem(byte steps = 1);
+    void prevMenuItem(byte steps = 1);
     void menuItemSelect();
 
     /* VALUE EDIT */
 
     bool _editValueMode;
-    byte _editValueType;
-    byte _editValueLength;
-    byte _editValueCursorPosition;
-    byte _editValueVirtualCursorPosition;
+    GEMEdit _edit;                // Value being edited, along with the cursor within it
     bool _editValuefullScreenWidth;
     byte _editValueItemLength;
-    char _valueString[GEM_STR_LEN];
-    int _valueSelectNum;
     void enterEditValueMode();
     void checkboxToggle();
     void initEditValueCursor(bool fullScreenWidth = false);
-    void nextEditValueCursorPosition();
-    void prevEditValueCursorPosition();
+    void nextEditValueCursorPosition(byte steps = 1);
+    void prevEditValueCursorPosition(byte steps = 1);
     void drawEditValueCursor();
-    void nextEditValueDigit();
-    void prevEditValueDigit();
+    void drawEditValueCursorMove(byte cursorPositionPrev, byte windowOffsetPrev);
+    byte getEditValueCellLeft(byte cursorPosition);
+    void printEditValue();
+    void drawEditValueArea(byte x, byte w);  // Redraw area of the edited value (from x to x + w) and send affected tiles to display, instead of the whole menu
+    void drawEditValueAreaFull();
+    void nextEditValueDigit(byte steps = 1);
+    void prevEditValueDigit(byte steps = 1);
     void drawEditValueDigit(byte code);
-    void nextEditValueSelect();
-    void prevEditValueSelect();
+    #ifdef GEM_SUPPORT_SELECT
+    void nextEditValueSelect(byte steps = 1);
+    void prevEditValueSelect(byte steps = 1);
+    #endif
     void saveEditValue();
     void cancelEditValue();
     void exitEditValue();
-    char* trimString(char* str);
+
+    /* TASK OPERATIONS */
+
+    GEMRuntime _runtime;          // Tasks, persistence, key queue and remote control
 
     /* KEY DETECTION */
 
     byte _currentKey;
+    byte _currentKeyCount;        // Number of times current key is repeated (see registerKeyPress())
     void dispatchKeyPress();
 };
 
@@ -8,4 +8,56 @@
     #include "config/enable-u8g2.h"         // Enable U8g2 version of GEM
 #endif
 
-#include "config/support-float-edit.h"  // Support for editable float and double variables (option selects support them regardless of this setting)
+// Features below are enabled by default. Each of them can be disabled by commenting out corresponding inclusion,
+// or by adding the `GEM_DONT_SUPPORT_...` define (e.g. `GEM_DONT_SUPPORT_SELECT`) to your project level.
+// Constructors of menu items that rely on disabled feature are compiled out as well.
+#ifndef GEM_DONT_SUPPORT_FLOAT_EDIT
+    #include "config/support-float-edit.h"      // Support for editable float and double variables (option selects support them regardless of this setting)
+#endif
+#ifndef GEM_DONT_SUPPORT_SELECT
+    #include "config/support-select.h"          // Support for option selects (GEMSelect and its descendants)
+#endif
+#ifndef GEM_DONT_SUPPORT_FIXED_POINT
+    #include "config/support-fixed-point.h"     // Support for fixed-point decimal variables (FixedPointFormat)
+#endif
+#ifndef GEM_DONT_SUPPORT_STRING_BUFFER
+    #include "config/support-string-buffer.h"   // Support for string variables of arbitrary capacity (StringBuffer)
+#endif
+#ifndef GEM_DONT_SUPPORT_CALLBACK_VALUE
+    #include "config/support-callback-value.h"  // Support for menu items with value returned by callback function
+#endif
+#ifndef GEM_DONT_SUPPORT_BUTTON
+    #include "config/support-button.h"          // Support for menu buttons
+#endif
+#ifndef GEM_DONT_SUPPORT_LINKED_VALUE
+    #include "config/support-linked-value.h"    // Support for menu items with value that link to another menu page
+#endif
+#ifndef GEM_DONT_SUPPORT_TEXT
+    #include "config/support-text.h"            // Support for static text menu items
+#endif
+#ifndef GEM_DONT_SUPPORT_POINTER_DASH
+    #include "config/support-pointer-dash.h"    // Support for GEM_POINTER_DASH menu pointer (the only supported pointer is drawn regardless of requested one)
+#endif
+#ifndef GEM_DONT_SUPPORT_POINTER_ROW
+    #include "config/support-pointer-row.h"     // Support for GEM_POINTER_ROW menu pointer
+#endif
+#ifndef GEM_DONT_SUPPORT_CYRILLIC
+    #include "config/support-cyrillic.h"        // Support for Cyrillic set of fonts (U8g2 version of GEM only)
+#endif
+
+// Features below are disabled by default. Each of them can be enabled by uncommenting corresponding inclusion,
+// or by adding the `GEM_ENABLE_...` define (e.g. `GEM_ENABLE_PROFILER`) to your project level.
+// #include "config/enable-profiler.h"         // Timing of the phases of drawMenu() and of the menu items being drawn (see GEMProfiler)
+// #include "config/enable-bus-counter.h"      // Accounting of the bytes and commands sent to display (see GEMBusCounter)
+// #include "config/enable-footprint.h"       // Report of the RAM taken by the menu configuration (see GEMFootprint)
+// #include "config/enable-key-queue.h"       // Queue of key presses safe to fill from interrupt service routine (see GEMKeyQueue)
+// #include "config/enable-encoder.h"         // Rotary encoder input with acceleration (see GEMEncoder)
+// #include "config/enable-buttons.h"         // Debounced push-button input with repeat and long press (see GEMButtons)
+// #include "config/enable-scheduler.h"       // Cooperative scheduler of periodic tasks run along with the menu (see GEMScheduler)
+// #include "config/enable-persist.h"         // Wear-leveled persistence of the linked variables of saved menu items (see GEMPersist)
+// #include "config/enable-snapshot.h"        // Binary snapshot and restore of the menu values (see GEMSnapshot)
+// #include "config/enable-remote.h"          // Remote control of the menu values over serial link (see GEMRemote)
+
+#if !defined(GEM_SUPPORT_POINTER_DASH) && !defined(GEM_SUPPORT_POINTER_ROW)
+    #error "GEM: at least one type of menu pointer should be supported"
+#endif
@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_BUS_COUNTER
+#define GEM_ENABLE_BUS_COUNTER
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_BUTTONS
+#define GEM_ENABLE_BUTTONS
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_ENCODER
+#define GEM_ENABLE_ENCODER
+#endif
\ No newline at end of file
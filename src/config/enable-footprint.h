@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_FOOTPRINT
+#define GEM_ENABLE_FOOTPRINT
+#endif
\ No newline at end of file
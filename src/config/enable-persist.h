@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_PERSIST
+#define GEM_ENABLE_PERSIST
+#endif
\ No newline at end of file
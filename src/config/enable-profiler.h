@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_PROFILER
+#define GEM_ENABLE_PROFILER
+#endif
\ No newline at end of file
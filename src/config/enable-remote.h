@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_REMOTE
+#define GEM_ENABLE_REMOTE
+#endif
\ No newline at end of file
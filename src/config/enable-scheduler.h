@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_SCHEDULER
+#define GEM_ENABLE_SCHEDULER
+#endif
\ No newline at end of file
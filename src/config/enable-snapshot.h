@@ -0,0 +1,3 @@
+#ifndef GEM_ENABLE_SNAPSHOT
+#define GEM_ENABLE_SNAPSHOT
+#endif
\ No newline at end of file
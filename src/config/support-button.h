@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_BUTTON
+#define GEM_SUPPORT_BUTTON
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_CYRILLIC
+#define GEM_SUPPORT_CYRILLIC
+#endif
\ No newline at end of file
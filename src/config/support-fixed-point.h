@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_FIXED_POINT
+#define GEM_SUPPORT_FIXED_POINT
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_LINKED_VALUE
+#define GEM_SUPPORT_LINKED_VALUE
+#endif
\ No newline at end of file
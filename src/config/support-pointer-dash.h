@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_POINTER_DASH
+#define GEM_SUPPORT_POINTER_DASH
+#endif
\ No newline at end of file
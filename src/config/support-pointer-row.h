@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_POINTER_ROW
+#define GEM_SUPPORT_POINTER_ROW
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_SELECT
+#define GEM_SUPPORT_SELECT
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_STRING_BUFFER
+#define GEM_SUPPORT_STRING_BUFFER
+#endif
\ No newline at end of file
@@ -0,0 +1,3 @@
+#ifndef GEM_SUPPORT_TEXT
+#define GEM_SUPPORT_TEXT
+#endif
\ No newline at end of file
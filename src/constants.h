@@ -36,7 +36,46 @@
 // Macro constant (alias) for supported length of the string (character sequence) variable of type char[GEM_STR_LEN]
 #define GEM_STR_LEN 17
 
-// Macro constant (alias) for default precision of the float and double variables (the number of digits after the decimal sign as required by dtostrf())
+// Macro constant (alias) for the greatest size of the value of option select in its stored form (see GEMItem::readValue())
+#define GEM_SELECT_VALUE_LEN GEM_STR_LEN
+
+// Macro constant (alias) for the number of distinct characters of GEM_VAL_STRING variable that can be changed during single edit
+// (changes are kept in the journal and applied to the variable on save, further changes are refused)
+#define GEM_EDIT_JOURNAL_LEN 16
+
+// Macro constant (alias) for the capacity of the key press queue (see GEMKeyQueue), should be power of two not greater than 128
+#define GEM_KEY_QUEUE_LEN 8
+
+// Macro constant (alias) for the longest wait (in ms) reported by nextDeadlineMillis(), i.e. when menu has nothing to do until the next key press
+// (half of the millis() range, so that deadline can still be compared with millis() across its overflow)
+#define GEM_DEADLINE_MAX_WAIT 0x7FFFFFFFUL
+
+// Macro constants (aliases) for persistence of the menu items' linked variables (see GEMPersist)
+#define GEM_PERSIST_QUIET_TIME 5000  // Time (in ms) without changes after which values are written to the storage
+#define GEM_PERSIST_SLOT_ALIGN 16    // Alignment of the size of the slot records are written to
+
+// Macro constants (aliases) for binary snapshot of the menu values (see GEMSnapshot)
+#define GEM_SNAPSHOT_VERSION 1       // Version of the snapshot format
+#define GEM_SNAPSHOT_MAX_DEPTH 8     // Maximum depth of the menu pages walked
+#define GEM_SNAPSHOT_BUFFER_LEN 64   // Size of the buffer that holds values until the whole snapshot is verified (each value takes 2 more bytes)
+
+// Macro constants (aliases) for remote control of the menu values over serial link (see GEMRemote)
+#define GEM_REMOTE_FRAME_LEN 40      // Maximum length of the payload of the request frame (i.e. of the value written, plus 1 byte of ID)
+#define GEM_REMOTE_TIMEOUT 100       // Time (in ms) between bytes of the frame after which partially received frame is dropped
+
+// Macro constants (aliases) for phases of drawing of the menu timed by GEMProfiler
+#define GEM_PHASE_CLEAR 0            // Clearing of the screen (GEM) or of the buffer (GEM_u8g2)
+#define GEM_PHASE_TITLE 1            // Title bar of the menu page
+#define GEM_PHASE_ITEMS 2            // Menu items (titles and values, including formatting and callbacks)
+#define GEM_PHASE_POINTER 3          // Menu pointer
+#define GEM_PHASE_SCROLLBAR 4        // Scrollbar
+#define GEM_PHASE_TRANSFER 5         // Transfer of the buffer to display (GEM_u8g2 only; GEM sends commands to display while drawing)
+#define GEM_PHASE_FRAME 6            // The whole frame, i.e. single call of drawMenu()
+#define GEM_PHASE_COUNT 7
+#define GEM_PROFILE_KINDS 16         // Number of kinds of menu items timed by GEMProfiler: types of associated variable (GEM_VAL_...),
+                                     // followed by menu item types other than GEM_ITEM_VAL (GEM_ITEM_LINK and on)
+
+// Macro constant (alias) for default precision of the float and double variables (the number of digits after the decimal sign as required by GEMFormatFloat())
 #define GEM_FLOAT_PREC 6
 #define GEM_DOUBLE_PREC 6
 
@@ -53,4 +92,7 @@
                            // (note that char[] array should be big enough to hold select option with the longest value)
 #define GEM_VAL_FLOAT 5    // Associated variable is of type float
 #define GEM_VAL_DOUBLE 6   // Associated variable is of type double
-#define GEM_VAL_CALLBACK 7 // Associated variable is of type const char* callback-function
\ No newline at end of file
+#define GEM_VAL_CALLBACK 7 // Associated variable is of type const char* callback-function
+#define GEM_VAL_FIXED16 8  // Associated variable is of type int16_t holding fixed-point decimal number (see FixedPointFormat)
+#define GEM_VAL_FIXED32 9  // Associated variable is of type int32_t holding fixed-point decimal number (see FixedPointFormat)
+#define GEM_VAL_STRING 10  // Associated variable is of type char[] of arbitrary capacity, edited in place (see StringBuffer)
\ No newline at end of file